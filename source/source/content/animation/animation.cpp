@@ -417,6 +417,26 @@ void AnimationDatabase::fixBodyPartPointers() {
 }
 
 
+/**
+ * @brief Returns the names of the bitmaps used by the sprites of an
+ * animation database, without loading it.
+ *
+ * @param node Data node of the animation database.
+ * @param outNames The names are added here. There can be repeats.
+ */
+void AnimationDatabase::getBitmapNamesFromDataNode(
+    DataNode* node, vector<string>& outNames
+) {
+    DataNode* spritesNode = node->getChildByName("sprites");
+    size_t nSprites = spritesNode->getNrOfChildren();
+    for(size_t s = 0; s < nSprites; s++) {
+        DataNode* fileNode = spritesNode->getChild(s)->getChildByName("file");
+        if(fileNode->value.empty()) continue;
+        outNames.push_back(fileNode->value);
+    }
+}
+
+
 /**
  * @brief Loads animation database data from a data node.
  *
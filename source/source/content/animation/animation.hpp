@@ -268,6 +268,9 @@ public:
     void deleteSprite(size_t idx);
     void fillSoundIdxCaches(MobType* mtPtr);
     void fixBodyPartPointers();
+    static void getBitmapNamesFromDataNode(
+        DataNode* node, vector<string>& outNames
+    );
     void loadFromDataNode(DataNode* node);
     void saveToDataNode(DataNode* node, bool saveTopData);
     void sortAlphabetically();
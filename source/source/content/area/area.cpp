@@ -939,18 +939,14 @@ void Area::generateBlockmap() {
     bmap.nRows =
         ceil((corners.br.y - corners.tl.y) / GEOMETRY::BLOCKMAP_BLOCK_SIZE) + 1;
         
-    bmap.edges.assign(
-        bmap.nCols, vector<vector<Edge*> >(bmap.nRows, vector<Edge*>())
-    );
-    bmap.sectors.assign(
-        bmap.nCols, vector<unordered_set<Sector*> >(
-            bmap.nRows, unordered_set<Sector*>()
-        )
-    );
+    //The lists are gathered per block here, and then packed into
+    //the blockmap at the end.
+    vector<vector<size_t> > blockEdgeIdxs(bmap.nCols * bmap.nRows);
+    vector<vector<size_t> > blockSectorIdxs(bmap.nCols * bmap.nRows);
     
     
     //Now, add a list of edges to each block.
-    generateEdgesBlockmap(edges);
+    generateEdgesBlockmap(blockEdgeIdxs, blockSectorIdxs);
     
     
     /* If at this point, there's any block that's missing a sector,
@@ -968,54 +964,72 @@ void Area::generateBlockmap() {
      */
     for(size_t bx = 0; bx < bmap.nCols; bx++) {
         for(size_t by = 0; by < bmap.nRows; by++) {
-            if(!bmap.sectors[bx][by].empty()) continue;
+            vector<size_t>& blockSectors =
+                blockSectorIdxs[bmap.getBlockIdx(bx, by)];
+            if(!blockSectors.empty()) continue;
             
             if(
                 bx == 0 || by == 0 ||
                 bx == bmap.nCols - 1 || by == bmap.nRows - 1
             ) {
-                bmap.sectors[bx][by].insert(nullptr);
+                blockSectors.push_back(INVALID);
                 continue;
             }
             
-            if(bmap.sectors[bx - 1][by].size() == 1) {
-                bmap.sectors[bx][by].insert(*bmap.sectors[bx - 1][by].begin());
-                continue;
-            }
-            if(bmap.sectors[bx + 1][by].size() == 1) {
-                bmap.sectors[bx][by].insert(*bmap.sectors[bx + 1][by].begin());
-                continue;
-            }
-            if(bmap.sectors[bx][by - 1].size() == 1) {
-                bmap.sectors[bx][by].insert(*bmap.sectors[bx][by - 1].begin());
-                continue;
-            }
-            if(bmap.sectors[bx][by + 1].size() == 1) {
-                bmap.sectors[bx][by].insert(*bmap.sectors[bx][by + 1].begin());
-                continue;
+            const vector<size_t>* neighbors[4] = {
+                &blockSectorIdxs[bmap.getBlockIdx(bx - 1, by)],
+                &blockSectorIdxs[bmap.getBlockIdx(bx + 1, by)],
+                &blockSectorIdxs[bmap.getBlockIdx(bx, by - 1)],
+                &blockSectorIdxs[bmap.getBlockIdx(bx, by + 1)]
+            };
+            bool foundFromNeighbor = false;
+            for(unsigned char n = 0; n < 4; n++) {
+                if(neighbors[n]->size() == 1) {
+                    blockSectors.push_back((*neighbors[n])[0]);
+                    foundFromNeighbor = true;
+                    break;
+                }
             }
+            if(foundFromNeighbor) continue;
             
             Point corner = bmap.getCellTopLeftCorner(bx, by);
             corner += GEOMETRY::BLOCKMAP_BLOCK_SIZE * 0.5;
-            bmap.sectors[bx][by].insert(
-                getSector(corner, nullptr, false)
-            );
+            size_t sectorIdx = INVALID;
+            getSector(corner, &sectorIdx, false);
+            blockSectors.push_back(sectorIdx);
         }
     }
+    
+    
+    //Finally, list the sector triangles that overlap each block.
+    vector<vector<SectorTriangle> > blockTriangles(bmap.nCols * bmap.nRows);
+    generateTrianglesBlockmap(blockSectorIdxs, blockTriangles);
+    
+    bmap.setData(
+        blockEdgeIdxs, blockSectorIdxs, blockTriangles,
+        edges.size(), sectors.size()
+    );
 }
 
 
 /**
- * @brief Generates the blockmap for a set of edges.
+ * @brief Generates the blockmap's edge lists, and the sectors of the blocks
+ * those edges go through.
  *
- * @param edgeList Edges to generate the blockmap around.
+ * @param blockEdgeIdxs The indexes of the edges in each block are
+ * added here.
+ * @param blockSectorIdxs The indexes of the sectors in each block are
+ * added here, sorted and without repeats. INVALID stands for the void.
  */
-void Area::generateEdgesBlockmap(const vector<Edge*>& edgeList) {
-    forIdx(e, edgeList) {
+void Area::generateEdgesBlockmap(
+    vector<vector<size_t> >& blockEdgeIdxs,
+    vector<vector<size_t> >& blockSectorIdxs
+) {
+    forIdx(e, edges) {
         //Get which blocks this edge belongs to, via bounding-box,
         //and only then thoroughly test which it is inside of.
         
-        Edge* ePtr = edgeList[e];
+        Edge* ePtr = edges[e];
         RectCorners corners(v2p(ePtr->vertexes[0]), v2p(ePtr->vertexes[0]));
         updateMinMaxCoords(corners, v2p(ePtr->vertexes[1]));
         
@@ -1053,11 +1067,100 @@ void Area::generateEdgesBlockmap(const vector<Edge*>& edgeList) {
                         }
                     }
                     
-                    if(addEdge) bmap.edges[bx][by].push_back(ePtr);
+                    size_t blockIdx = bmap.getBlockIdx(bx, by);
+                    if(addEdge) blockEdgeIdxs[blockIdx].push_back(e);
                     
                     if(ePtr->sectors[0] || ePtr->sectors[1]) {
-                        bmap.sectors[bx][by].insert(ePtr->sectors[0]);
-                        bmap.sectors[bx][by].insert(ePtr->sectors[1]);
+                        vector<size_t>& blockSectors =
+                            blockSectorIdxs[blockIdx];
+                        for(unsigned char s = 0; s < 2; s++) {
+                            size_t sIdx =
+                                ePtr->sectors[s] ? ePtr->sectorIdxs[s] :
+                                INVALID;
+                            auto it =
+                                std::lower_bound(
+                                    blockSectors.begin(), blockSectors.end(),
+                                    sIdx
+                                );
+                            if(it == blockSectors.end() || *it != sIdx) {
+                                blockSectors.insert(it, sIdx);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief Generates the blockmap's lists of sector triangles that overlap
+ * each block. Blocks with only one sector don't need a list, since any point
+ * in them can only be in that sector.
+ *
+ * @param blockSectorIdxs The indexes of the sectors in each block.
+ * @param blockTriangles The sector triangles in each block are added here,
+ * sorted by sector, and then by triangle.
+ */
+void Area::generateTrianglesBlockmap(
+    const vector<vector<size_t> >& blockSectorIdxs,
+    vector<vector<SectorTriangle> >& blockTriangles
+) {
+    forIdx(s, sectors) {
+        Sector* sPtr = sectors[s];
+        forIdx(t, sPtr->triangles) {
+            const Triangle* tPtr = &sPtr->triangles[t];
+            Point tp[3] = {
+                v2p(tPtr->points[0]),
+                v2p(tPtr->points[1]),
+                v2p(tPtr->points[2])
+            };
+            RectCorners corners(tp[0], tp[0]);
+            updateMinMaxCoords(corners, tp[1]);
+            updateMinMaxCoords(corners, tp[2]);
+            
+            size_t bMinX = bmap.getCol(corners.tl.x);
+            size_t bMaxX = bmap.getCol(corners.br.x);
+            size_t bMinY = bmap.getRow(corners.tl.y);
+            size_t bMaxY = bmap.getRow(corners.br.y);
+            if(
+                bMinX == INVALID || bMaxX == INVALID ||
+                bMinY == INVALID || bMaxY == INVALID
+            ) {
+                continue;
+            }
+            
+            for(size_t bx = bMinX; bx <= bMaxX; bx++) {
+                for(size_t by = bMinY; by <= bMaxY; by++) {
+                    size_t blockIdx = bmap.getBlockIdx(bx, by);
+                    if(blockSectorIdxs[blockIdx].size() <= 1) continue;
+                    
+                    //The triangle overlaps the block if one of its sides
+                    //goes through it, or if it covers the whole block.
+                    //The block is padded a bit so that triangles that only
+                    //touch its borders also count.
+                    Point corner = bmap.getCellTopLeftCorner(bx, by);
+                    Point corner2 = corner + GEOMETRY::BLOCKMAP_BLOCK_SIZE;
+                    bool overlaps =
+                        isPointInTriangle(
+                            corner + GEOMETRY::BLOCKMAP_BLOCK_SIZE * 0.5f,
+                            tp[0], tp[1], tp[2], true
+                        );
+                    corner -= 1.0f;
+                    corner2 += 1.0f;
+                    for(unsigned char p = 0; p < 3 && !overlaps; p++) {
+                        overlaps =
+                            lineSegIntersectsRectangle(
+                                corner, corner2, tp[p], tp[(p + 1) % 3]
+                            );
+                    }
+                    
+                    if(overlaps) {
+                        SectorTriangle st;
+                        st.sectorIdx = s;
+                        st.triangleIdx = t;
+                        blockTriangles[blockIdx].push_back(st);
                     }
                 }
             }
@@ -1522,6 +1625,7 @@ void Area::loadGeometryFromDataNode(
         connectVertexEdges(vertexes[v]);
     }
     forIdx(s, pathStops) {
+        pathStops[s]->idx = s;
         fixPathStopPointers(pathStops[s]);
     }
     forIdx(s, pathStops) {
@@ -3011,13 +3115,33 @@ void Area::setupEditorPathLinks() {
  */
 void Blockmap::clear() {
     topLeftCorner = Point();
-    edges.clear();
-    sectors.clear();
+    edgeOffsets.clear();
+    edgeIdxs.clear();
+    sectorOffsets.clear();
+    sectorIdxs.clear();
+    triangleOffsets.clear();
+    triangles.clear();
+    edgeQueryStamps.clear();
+    sectorQueryStamps.clear();
+    curEdgeQueryStamp = 0;
+    curSectorQueryStamp = 0;
     nCols = 0;
     nRows = 0;
 }
 
 
+/**
+ * @brief Returns the index of a block, for use in the offset lists.
+ *
+ * @param col Column of the block.
+ * @param row Row of the block.
+ * @return The index.
+ */
+size_t Blockmap::getBlockIdx(size_t col, size_t row) const {
+    return row * nCols + col;
+}
+
+
 /**
  * @brief Returns the bottom-right corner of the area.
  *
@@ -3064,15 +3188,21 @@ size_t Blockmap::getCol(float x) const {
 
 /**
  * @brief Obtains a list of edges that are within the specified
- * rectangle.
+ * rectangle. Each edge is only returned once, and they are sorted
+ * by index.
+ *
+ * This is not safe to call from more than one thread at a time.
  *
  * @param corners Corners of the rectangle.
- * @param outEdges Set to fill the edges into.
+ * @param outEdgeIdxs Vector to fill the edge indexes into. It gets cleared
+ * first. Reuse the same vector between calls to avoid allocations.
  * @return Whether it succeeded.
  */
 bool Blockmap::getEdgesInRect(
-    const RectCorners& corners, set<Edge*>& outEdges
+    const RectCorners& corners, vector<size_t>& outEdgeIdxs
 ) const {
+    outEdgeIdxs.clear();
+    
     size_t bx1 = getCol(corners.tl.x);
     size_t bx2 = getCol(corners.br.x);
     size_t by1 = getRow(corners.tl.y);
@@ -3086,16 +3216,27 @@ bool Blockmap::getEdgesInRect(
         return false;
     }
     
-    for(size_t bx = bx1; bx <= bx2; bx++) {
-        for(size_t by = by1; by <= by2; by++) {
-            const vector<Edge*>& blockEdges = edges[bx][by];
-            
-            forIdx(e, blockEdges) {
-                outEdges.insert(blockEdges[e]);
+    curEdgeQueryStamp++;
+    for(size_t by = by1; by <= by2; by++) {
+        for(size_t bx = bx1; bx <= bx2; bx++) {
+            size_t blockIdx = getBlockIdx(bx, by);
+            for(
+                size_t i = edgeOffsets[blockIdx];
+                i < edgeOffsets[blockIdx + 1]; i++
+            ) {
+                size_t eIdx = edgeIdxs[i];
+                if(edgeQueryStamps[eIdx] == curEdgeQueryStamp) continue;
+                edgeQueryStamps[eIdx] = curEdgeQueryStamp;
+                outEdgeIdxs.push_back(eIdx);
             }
         }
     }
     
+    //Only sort if needed. A single block's list is already sorted.
+    if(bx1 != bx2 || by1 != by2) {
+        std::sort(outEdgeIdxs.begin(), outEdgeIdxs.end());
+    }
+    
     return true;
 }
 
@@ -3114,6 +3255,135 @@ size_t Blockmap::getRow(float y) const {
 }
 
 
+/**
+ * @brief Obtains a list of sectors that are within, or partially within,
+ * the blocks covered by the specified rectangle. Parts of the rectangle
+ * outside of the blockmap are ignored. Each sector is only returned once,
+ * and they are sorted by index. The void is not included.
+ *
+ * This is not safe to call from more than one thread at a time.
+ *
+ * @param corners Corners of the rectangle.
+ * @param outSectorIdxs Vector to fill the sector indexes into. It gets
+ * cleared first. Reuse the same vector between calls to avoid allocations.
+ * @return Whether the rectangle covers any block.
+ */
+bool Blockmap::getSectorsInRect(
+    const RectCorners& corners, vector<size_t>& outSectorIdxs
+) const {
+    outSectorIdxs.clear();
+    if(nCols == 0 || nRows == 0) return false;
+    
+    Point bottomRight = getBottomRightCorner();
+    if(
+        corners.br.x < topLeftCorner.x || corners.tl.x >= bottomRight.x ||
+        corners.br.y < topLeftCorner.y || corners.tl.y >= bottomRight.y
+    ) {
+        //Out of bounds.
+        return false;
+    }
+    
+    float blockSize = GEOMETRY::BLOCKMAP_BLOCK_SIZE;
+    size_t bx1 =
+        std::clamp(
+            floor((corners.tl.x - topLeftCorner.x) / blockSize),
+            0.0f, (float) (nCols - 1)
+        );
+    size_t bx2 =
+        std::clamp(
+            floor((corners.br.x - topLeftCorner.x) / blockSize),
+            0.0f, (float) (nCols - 1)
+        );
+    size_t by1 =
+        std::clamp(
+            floor((corners.tl.y - topLeftCorner.y) / blockSize),
+            0.0f, (float) (nRows - 1)
+        );
+    size_t by2 =
+        std::clamp(
+            floor((corners.br.y - topLeftCorner.y) / blockSize),
+            0.0f, (float) (nRows - 1)
+        );
+        
+    curSectorQueryStamp++;
+    for(size_t by = by1; by <= by2; by++) {
+        for(size_t bx = bx1; bx <= bx2; bx++) {
+            size_t blockIdx = getBlockIdx(bx, by);
+            for(
+                size_t i = sectorOffsets[blockIdx];
+                i < sectorOffsets[blockIdx + 1]; i++
+            ) {
+                size_t sIdx = sectorIdxs[i];
+                if(sIdx == INVALID) continue;
+                if(sectorQueryStamps[sIdx] == curSectorQueryStamp) continue;
+                sectorQueryStamps[sIdx] = curSectorQueryStamp;
+                outSectorIdxs.push_back(sIdx);
+            }
+        }
+    }
+    
+    std::sort(outSectorIdxs.begin(), outSectorIdxs.end());
+    
+    return true;
+}
+
+
+/**
+ * @brief Packs the lists of edges and sectors of each block into
+ * the blockmap. The number of columns and rows must already be set.
+ *
+ * @param blockEdgeIdxs Indexes of the edges in each block, sorted.
+ * @param blockSectorIdxs Indexes of the sectors in each block, with INVALID
+ * for the void.
+ * @param blockTriangles Sector triangles that overlap each block.
+ * @param nEdges Total number of edges in the area.
+ * @param nSectors Total number of sectors in the area.
+ */
+void Blockmap::setData(
+    const vector<vector<size_t> >& blockEdgeIdxs,
+    const vector<vector<size_t> >& blockSectorIdxs,
+    const vector<vector<SectorTriangle> >& blockTriangles,
+    size_t nEdges, size_t nSectors
+) {
+    size_t nBlocks = nCols * nRows;
+    
+    edgeOffsets.assign(nBlocks + 1, 0);
+    sectorOffsets.assign(nBlocks + 1, 0);
+    triangleOffsets.assign(nBlocks + 1, 0);
+    for(size_t b = 0; b < nBlocks; b++) {
+        edgeOffsets[b + 1] = edgeOffsets[b] + blockEdgeIdxs[b].size();
+        sectorOffsets[b + 1] = sectorOffsets[b] + blockSectorIdxs[b].size();
+        triangleOffsets[b + 1] =
+            triangleOffsets[b] + blockTriangles[b].size();
+    }
+    
+    edgeIdxs.clear();
+    edgeIdxs.reserve(edgeOffsets[nBlocks]);
+    sectorIdxs.clear();
+    sectorIdxs.reserve(sectorOffsets[nBlocks]);
+    triangles.clear();
+    triangles.reserve(triangleOffsets[nBlocks]);
+    for(size_t b = 0; b < nBlocks; b++) {
+        edgeIdxs.insert(
+            edgeIdxs.end(), blockEdgeIdxs[b].begin(), blockEdgeIdxs[b].end()
+        );
+        sectorIdxs.insert(
+            sectorIdxs.end(),
+            blockSectorIdxs[b].begin(), blockSectorIdxs[b].end()
+        );
+        triangles.insert(
+            triangles.end(),
+            blockTriangles[b].begin(), blockTriangles[b].end()
+        );
+    }
+    
+    edgeQueryStamps.assign(nEdges, 0);
+    sectorQueryStamps.assign(nSectors, 0);
+    curEdgeQueryStamp = 0;
+    curSectorQueryStamp = 0;
+}
+
+
 #pragma endregion
 #pragma region Others
 
@@ -73,6 +73,8 @@ extern const unsigned char DEF_DIFFICULTY;
  * on the lake part of TIS check for collisions with
  * a wall on the landing site part of TIS.
  * It's also used when checking sectors in a certain spot.
+ * Each block's edges and sectors are sorted by index, and queries return
+ * them sorted by index too, so they follow the order of the area's lists.
  */
 struct Blockmap {
 
@@ -81,11 +83,29 @@ struct Blockmap {
     //Top-left corner of the blockmap.
     Point topLeftCorner;
     
-    //Specifies a list of edges in each block.
-    vector<vector<vector<Edge*> > > edges;
+    //For each block, where its edges start in the list of edge indexes.
+    //Blocks are ordered row by row, and there's one extra entry at the end
+    //with the total, so a block's edges end where the next block's start.
+    vector<size_t> edgeOffsets;
     
-    //Specifies a list of sectors in each block.
-    vector<vector<unordered_set<Sector*> > >  sectors;
+    //Indexes of the edges in each block, one block after the other.
+    vector<size_t> edgeIdxs;
+    
+    //For each block, where its sectors start in the list of sector indexes.
+    //Works the same way as the edge offsets.
+    vector<size_t> sectorOffsets;
+    
+    //Indexes of the sectors in each block, one block after the other.
+    //INVALID stands for the void.
+    vector<size_t> sectorIdxs;
+    
+    //For each block, where its sector triangles start in the list of
+    //sector triangles. Works the same way as the edge offsets.
+    vector<size_t> triangleOffsets;
+    
+    //Sector triangles that overlap each block, one block after the other.
+    //In each block, they're sorted by sector, and then by triangle.
+    vector<SectorTriangle> triangles;
     
     //Number of columns.
     size_t nCols = 0;
@@ -96,12 +116,42 @@ struct Blockmap {
     
     //--- Public function declarations ---
     
+    size_t getBlockIdx(size_t col, size_t row) const;
     size_t getCol(float x) const;
     size_t getRow(float y) const;
     Point getBottomRightCorner() const;
-    bool getEdgesInRect(const RectCorners& corners, set<Edge*>& edges) const;
+    bool getEdgesInRect(
+        const RectCorners& corners, vector<size_t>& outEdgeIdxs
+    ) const;
+    bool getSectorsInRect(
+        const RectCorners& corners, vector<size_t>& outSectorIdxs
+    ) const;
     Point getCellTopLeftCorner(size_t col, size_t row) const;
     void clear();
+    void setData(
+        const vector<vector<size_t> >& blockEdgeIdxs,
+        const vector<vector<size_t> >& blockSectorIdxs,
+        const vector<vector<SectorTriangle> >& blockTriangles,
+        size_t nEdges, size_t nSectors
+    );
+    
+    
+    private:
+    
+    //--- Private members ---
+    
+    //Stamp of the last query that found each edge. Queries use this to
+    //only return an edge once, without needing a set.
+    mutable vector<size_t> edgeQueryStamps;
+    
+    //Stamp of the current edge query.
+    mutable size_t curEdgeQueryStamp = 0;
+    
+    //Stamp of the last query that found each sector.
+    mutable vector<size_t> sectorQueryStamps;
+    
+    //Stamp of the current sector query.
+    mutable size_t curSectorQueryStamp = 0;
     
 };
 
@@ -249,6 +299,9 @@ struct Area : public Content {
     //List of path stops.
     vector<PathStop*> pathStops;
     
+    //Working memory for path-finding between the path stops.
+    AStarScratch pathFindingScratch;
+    
     //List of path links for use in the area editor.
     vector<EditorPathLink> editorPathLinks;
     
@@ -357,7 +410,14 @@ struct Area : public Content {
     void fixVertexIdxs(Vertex* vPtr);
     void fixVertexPointers(Vertex* vPtr);
     void generateBlockmap();
-    void generateEdgesBlockmap(const vector<Edge*>& edges);
+    void generateEdgesBlockmap(
+        vector<vector<size_t> >& blockEdgeIdxs,
+        vector<vector<size_t> >& blockSectorIdxs
+    );
+    void generateTrianglesBlockmap(
+        const vector<vector<size_t> >& blockSectorIdxs,
+        vector<vector<SectorTriangle> >& blockTriangles
+    );
     size_t getMaxPikminInField() const;
     size_t getNrPathLinks();
     void getTotalTreasureInfo(size_t* outAmount, size_t* outPoints) const;
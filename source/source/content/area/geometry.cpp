@@ -1163,6 +1163,8 @@ TRIANGULATION_ERROR triangulateSector(
     //Root of the polygon tree.
     Polygon root;
     
+    sPtr->textureVertexCache.geometryChanged = true;
+    
     //Let's clear any "lone" edges here.
     if(clearLoneEdges) {
         forIdx(e, sPtr->edges) {
@@ -10,6 +10,7 @@
 
 
 #include <algorithm>
+#include <unordered_set>
 
 #include "sector.hpp"
 
@@ -290,31 +291,79 @@ void Sector::removeEdge(const Edge* ePtr) {
  *
  * @param p Coordinates of the point.
  * @param outSectorIdx If not nullptr, the index of the sector on the
- * area map is returned here. The index will not be set if the search
- * is using the blockmap.
+ * area map is returned here.
  * @param useBlockmap If true, use the blockmap to search.
  * This provides faster results, but the blockmap must be built.
+ * @param lastHit If not nullptr, this triangle is checked first when using
+ * the blockmap, and whichever triangle the point is found in gets
+ * saved here. Searches for nearby points will be faster this way.
  * @return The sector.
  */
 Sector* getSector(
-    const Point& p, size_t* outSectorIdx, bool useBlockmap
+    const Point& p, size_t* outSectorIdx, bool useBlockmap,
+    SectorTriangle* lastHit
 ) {
     if(useBlockmap) {
-        size_t col = game.curArea->bmap.getCol(p.x);
-        size_t row = game.curArea->bmap.getRow(p.y);
+        const Blockmap& bmap = game.curArea->bmap;
+        const vector<Sector*>& sectors = game.curArea->sectors;
+        
+        if(
+            lastHit &&
+            lastHit->sectorIdx < sectors.size() &&
+            lastHit->triangleIdx <
+            sectors[lastHit->sectorIdx]->triangles.size()
+        ) {
+            const Triangle* tPtr =
+                &sectors[lastHit->sectorIdx]->triangles[lastHit->triangleIdx];
+            if(
+                isPointInTriangle(
+                    p,
+                    v2p(tPtr->points[0]),
+                    v2p(tPtr->points[1]),
+                    v2p(tPtr->points[2]),
+                    false
+                )
+            ) {
+                if(outSectorIdx) *outSectorIdx = lastHit->sectorIdx;
+                return sectors[lastHit->sectorIdx];
+            }
+        }
+        
+        size_t col = bmap.getCol(p.x);
+        size_t row = bmap.getRow(p.y);
         if(col == INVALID || row == INVALID) return nullptr;
         
-        unordered_set<Sector*>* sectors =
-            &game.curArea->bmap.sectors[col][row];
-            
-        if(sectors->size() == 1) return *sectors->begin();
+        size_t blockIdx = bmap.getBlockIdx(col, row);
+        size_t start = bmap.sectorOffsets[blockIdx];
+        size_t end = bmap.sectorOffsets[blockIdx + 1];
         
-        for(auto& s : (*sectors)) {
-            if(!s) {
-                continue;
-            }
-            if(s->isPointInSector(p)) {
-                return s;
+        if(end - start == 1) {
+            size_t sIdx = bmap.sectorIdxs[start];
+            if(sIdx == INVALID) return nullptr;
+            if(outSectorIdx) *outSectorIdx = sIdx;
+            return sectors[sIdx];
+        }
+        
+        //Only check the triangles that overlap this block.
+        for(
+            size_t i = bmap.triangleOffsets[blockIdx];
+            i < bmap.triangleOffsets[blockIdx + 1]; i++
+        ) {
+            const SectorTriangle& st = bmap.triangles[i];
+            const Triangle* tPtr =
+                &sectors[st.sectorIdx]->triangles[st.triangleIdx];
+            if(
+                isPointInTriangle(
+                    p,
+                    v2p(tPtr->points[0]),
+                    v2p(tPtr->points[1]),
+                    v2p(tPtr->points[2]),
+                    false
+                )
+            ) {
+                if(outSectorIdx) *outSectorIdx = st.sectorIdx;
+                if(lastHit) *lastHit = st;
+                return sectors[st.sectorIdx];
             }
         }
         
@@ -344,3 +393,145 @@ Sector* getSector(
         
     }
 }
+
+
+/**
+ * @brief Returns whether the vertexes need to be rebuilt before they can be
+ * used to draw the sector with the given parameters.
+ *
+ * @param textureSectors Sectors whose textures each layer should use.
+ * @param where X and Y offset.
+ * @param scale Scale the sector by this much.
+ * @param alpha Opacity.
+ * @return Whether they need to be rebuilt.
+ */
+bool SectorTextureVertexCache::needsRebuild(
+    Sector* const textureSectors[2], const Point& where,
+    float scale, float alpha
+) const {
+    if(geometryChanged) return true;
+    if(this->where != where) return true;
+    if(this->scale != scale) return true;
+    if(this->alpha != alpha) return true;
+    
+    for(unsigned char t = 0; t < 2; t++) {
+        const Sector* tsPtr = textureSectors[t];
+        if(this->textureSectors[t] != tsPtr) return true;
+        if(!tsPtr) continue;
+        const SectorTexture& tex = tsPtr->textureInfo;
+        if(bitmaps[t] && bitmaps[t] != tex.bitmap) return true;
+        if(textureTfs[t].trans != tex.tf.trans) return true;
+        if(textureTfs[t].scale != tex.tf.scale) return true;
+        if(textureTfs[t].rot != tex.tf.rot) return true;
+        if(!(textureTints[t] == tex.tint)) return true;
+        if(brightnesses[t] != tsPtr->brightness) return true;
+    }
+    
+    return false;
+}
+
+
+/**
+ * @brief Rebuilds the vertexes used to draw a sector's texture.
+ * The vectors keep their capacity, so this doesn't allocate memory
+ * unless the sector got more triangles.
+ *
+ * @param sPtr Sector the vertexes belong to.
+ * @param textureSectors Sectors whose textures each layer should use.
+ * If the sector doesn't fade, only the first is used, and it's the sector
+ * itself. If it fades, these are the two sectors it fades between.
+ * @param where X and Y offset.
+ * @param scale Scale the sector by this much.
+ * @param alpha Opacity.
+ */
+void SectorTextureVertexCache::rebuild(
+    const Sector* sPtr, Sector* const textureSectors[2],
+    const Point& where, float scale, float alpha
+) {
+    bool fading = sPtr->fade;
+    bool drawSector0 =
+        textureSectors[0] && !textureSectors[0]->isBottomlessPit;
+    size_t nVertexes = sPtr->triangles.size() * 3;
+    
+    for(unsigned char t = 0; t < 2; t++) {
+        Sector* tsPtr = textureSectors[t];
+        this->textureSectors[t] = tsPtr;
+        bitmaps[t] = nullptr;
+        vertexes[t].clear();
+        
+        if(t == 1 && !fading) continue;
+        if(fading && !drawSector0 && t == 0) {
+            //Allows fading into the void.
+            continue;
+        }
+        if(!tsPtr || tsPtr->isBottomlessPit) continue;
+        
+        const SectorTexture& tex = tsPtr->textureInfo;
+        textureTfs[t] = tex.tf;
+        textureTints[t] = tex.tint;
+        brightnesses[t] = tsPtr->brightness;
+        bitmaps[t] = tex.bitmap;
+        
+        //When fading, the second texture fades in from the edges it shares
+        //with its sector, or from the edges of the first's sector outward.
+        //Gather the vertexes of those edges once, instead of checking
+        //every edge for every vertex. The set is kept between calls, so
+        //it doesn't need to allocate memory each time.
+        static unordered_set<const Vertex*> fadeVertexes;
+        fadeVertexes.clear();
+        if(t == 1) {
+            const Sector* edgeSector =
+                drawSector0 ? textureSectors[0] : textureSectors[1];
+            forIdx(e, edgeSector->edges) {
+                fadeVertexes.insert(edgeSector->edges[e]->vertexes[0]);
+                fadeVertexes.insert(edgeSector->edges[e]->vertexes[1]);
+            }
+        }
+        
+        //Texture transformations.
+        ALLEGRO_TRANSFORM tra;
+        al_build_transform(
+            &tra,
+            -tex.tf.trans.x,
+            -tex.tf.trans.y,
+            1.0f / tex.tf.scale.x,
+            1.0f / tex.tf.scale.y,
+            -tex.tf.rot
+        );
+        
+        ALLEGRO_COLOR baseColor =
+            tintColor(tex.tint, mapGray(tsPtr->brightness));
+            
+        vertexes[t].resize(nVertexes);
+        for(size_t v = 0; v < nVertexes; v++) {
+            const Triangle* tPtr = &sPtr->triangles[v / 3];
+            const Vertex* vPtr = tPtr->points[v % 3];
+            float vx = vPtr->x;
+            float vy = vPtr->y;
+            
+            float alphaMult = 1;
+            if(t == 1) {
+                bool onEdge = fadeVertexes.find(vPtr) != fadeVertexes.end();
+                if(!drawSector0) {
+                    alphaMult = onEdge ? 1 : 0;
+                } else {
+                    alphaMult = onEdge ? 0 : 1;
+                }
+            }
+            
+            ALLEGRO_VERTEX& av = vertexes[t][v];
+            av.x = (vx - where.x) * scale;
+            av.y = (vy - where.y) * scale;
+            al_transform_coordinates(&tra, &vx, &vy);
+            av.u = vx;
+            av.v = vy;
+            av.z = 0;
+            av.color = multAlpha(baseColor, alphaMult * alpha);
+        }
+    }
+    
+    this->where = where;
+    this->scale = scale;
+    this->alpha = alpha;
+    geometryChanged = false;
+}
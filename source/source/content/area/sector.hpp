@@ -15,6 +15,7 @@
 
 #include <allegro5/allegro.h>
 #include <allegro5/allegro_color.h>
+#include <allegro5/allegro_primitives.h>
 
 #include "../../util/drawing_utils.hpp"
 #include "../../util/enum_utils.hpp"
@@ -69,6 +70,80 @@ struct SectorTexture {
 };
 
 
+/**
+ * @brief Identifies one of the triangles of one of the area's sectors.
+ */
+struct SectorTriangle {
+
+    //--- Public members ---
+    
+    //Index of the sector.
+    size_t sectorIdx = INVALID;
+    
+    //Index of the triangle in the sector.
+    size_t triangleIdx = INVALID;
+    
+};
+
+
+struct Sector;
+
+
+/**
+ * @brief Vertexes that are ready to draw a sector's texture with.
+ *
+ * These are kept between frames, and only rebuilt when the sector's geometry
+ * or the appearance of the textures it uses changes.
+ */
+struct SectorTextureVertexCache {
+
+    //--- Public members ---
+    
+    //Vertexes of each texture layer. The second is only used when fading.
+    vector<ALLEGRO_VERTEX> vertexes[2];
+    
+    //Bitmap to draw each layer with. nullptr if the layer is not drawn.
+    ALLEGRO_BITMAP* bitmaps[2] = {nullptr, nullptr};
+    
+    //Sector whose texture each layer used when it was built.
+    Sector* textureSectors[2] = {nullptr, nullptr};
+    
+    //Texture transformation each layer used when it was built.
+    Transform2d textureTfs[2];
+    
+    //Texture tint each layer used when it was built.
+    ALLEGRO_COLOR textureTints[2] = {COLOR_WHITE, COLOR_WHITE};
+    
+    //Brightness each layer used when it was built.
+    unsigned char brightnesses[2] = {0, 0};
+    
+    //Offset the vertexes were built with.
+    Point where;
+    
+    //Scale the vertexes were built with.
+    float scale = 1.0f;
+    
+    //Opacity the vertexes were built with.
+    float alpha = 1.0f;
+    
+    //Whether the sector's geometry changed since they were built.
+    bool geometryChanged = true;
+    
+    
+    //--- Public function declarations ---
+    
+    bool needsRebuild(
+        Sector* const textureSectors[2], const Point& where,
+        float scale, float alpha
+    ) const;
+    void rebuild(
+        const Sector* sPtr, Sector* const textureSectors[2],
+        const Point& where, float scale, float alpha
+    );
+    
+};
+
+
 /**
  * @brief A sector, like the ones in DOOM.
  *
@@ -128,6 +203,9 @@ struct Sector {
     //Bounding box.
     RectCorners bBox;
     
+    //Vertexes to draw its texture with.
+    SectorTextureVertexCache textureVertexCache;
+    
     
     //--- Public function declarations ---
     
@@ -149,5 +227,6 @@ struct Sector {
 
 
 Sector* getSector(
-    const Point& p, size_t* outSectorIdx, bool useBlockmap
+    const Point& p, size_t* outSectorIdx, bool useBlockmap,
+    SectorTriangle* lastHit = nullptr
 );
@@ -8,6 +8,8 @@
  * Content manager class and related functions.
  */
 
+#include <algorithm>
+
 #include "content_manager.hpp"
 
 #include "../core/game.hpp"
@@ -77,6 +79,59 @@ bool ContentManager::addNewPack(
 }
 
 
+/**
+ * @brief Takes an image that was decoded ahead of time, if any, and turns it
+ * into a bitmap that follows the current bitmap settings.
+ *
+ * @param path Path to the image file.
+ * @return The bitmap, or nullptr if the image wasn't decoded ahead of time.
+ */
+ALLEGRO_BITMAP* ContentManager::claimPrefetchedBitmap(const string& path) {
+    const auto& it = prefetchedBitmaps.find(path);
+    if(it == prefetchedBitmaps.end()) return nullptr;
+    
+    ALLEGRO_BITMAP* bmp = it->second;
+    prefetchedBitmaps.erase(it);
+    al_convert_bitmap(bmp);
+    return bmp;
+}
+
+
+/**
+ * @brief Takes a data file that was read ahead of time, if any.
+ *
+ * @param path Path to the data file.
+ * @param outNode The file's contents are returned here.
+ * @param outSuccess Whether the file was successfully opened is
+ * returned here.
+ * @return Whether the file was read ahead of time.
+ */
+bool ContentManager::claimPrefetchedDataFile(
+    const string& path, DataNode* outNode, bool* outSuccess
+) {
+    const auto& it = prefetchedDataFiles.find(path);
+    if(it == prefetchedDataFiles.end()) return false;
+    
+    *outNode = std::move(it->second.node);
+    *outSuccess = it->second.success;
+    prefetchedDataFiles.erase(it);
+    return true;
+}
+
+
+/**
+ * @brief Throws away any data files and images that were read ahead of time
+ * but never used.
+ */
+void ContentManager::clearPrefetchedContent() {
+    for(auto& b : prefetchedBitmaps) {
+        al_destroy_bitmap(b.second);
+    }
+    prefetchedBitmaps.clear();
+    prefetchedDataFiles.clear();
+}
+
+
 /**
  * @brief Returns the relevant content type manager for a given content type.
  *
@@ -167,6 +222,23 @@ void ContentManager::loadAll(
         mgrPtr->fillManifests();
     }
     
+    //Read the data files and decode the images in parallel. The content
+    //is then committed below in the usual order, so the result is the same
+    //no matter how many threads are used.
+    size_t nrThreads = game.options.advanced.loadingThreads;
+    if(nrThreads == 0) nrThreads = WorkerPool::getNrHardwareThreads();
+    if(nrThreads > 1) {
+        if(game.perfMon) {
+            game.perfMon->startMeasurement("Content prefetching");
+        }
+        loadPool.setNrThreads(nrThreads);
+        prefetchContent(types);
+        loadPool.setNrThreads(1);
+        if(game.perfMon) {
+            game.perfMon->finishMeasurement();
+        }
+    }
+    
     //Now load the content.
     forIdx(t, types) {
         ContentTypeManager* mgrPtr = getMgrPtr(types[t]);
@@ -181,6 +253,7 @@ void ContentManager::loadAll(
         loadLevels[types[t]] = level;
     }
     
+    clearPrefetchedContent();
 }
 
 
@@ -226,6 +299,108 @@ bool ContentManager::loadAreaAsCurrent(
 }
 
 
+/**
+ * @brief Reads the data files and decodes the images that loading some types
+ * of content will need, using the loading threads. Images are decoded into
+ * memory bitmaps, since video bitmaps can only be made on the main thread.
+ *
+ * @param types Types of game content that will be loaded.
+ */
+void ContentManager::prefetchContent(const vector<CONTENT_TYPE>& types) {
+    vector<double> threadTimes;
+    int bmpFlags = al_get_new_bitmap_flags();
+    int bmpFormat = al_get_new_bitmap_format();
+    disableFlag(bmpFlags, ALLEGRO_VIDEO_BITMAP);
+    enableFlag(bmpFlags, ALLEGRO_MEMORY_BITMAP);
+    
+    forIdx(t, types) {
+        ContentTypeManager* mgrPtr = getMgrPtr(types[t]);
+        double startTime = al_get_time();
+        threadTimes.assign(loadPool.getNrThreads(), 0.0);
+        
+        //Data files.
+        vector<string> filePaths;
+        mgrPtr->getPrefetchDataFiles(filePaths);
+        std::sort(filePaths.begin(), filePaths.end());
+        filePaths.erase(
+            std::unique(filePaths.begin(), filePaths.end()), filePaths.end()
+        );
+        vector<PrefetchedDataFile> files(filePaths.size());
+        
+        loadPool.parallelFor(
+            filePaths.size(),
+        [&] (size_t threadIdx, size_t start, size_t end) {
+            double rangeStartTime = al_get_time();
+            for(size_t f = start; f < end; f++) {
+                files[f].node.loadFile(filePaths[f], &files[f].success);
+            }
+            threadTimes[threadIdx] += al_get_time() - rangeStartTime;
+        }
+        );
+        
+        //Images those data files use.
+        vector<string> bmpPaths;
+        forIdx(f, files) {
+            if(files[f].success) {
+                vector<string> bmpNames;
+                mgrPtr->getPrefetchBitmaps(&files[f].node, bmpNames);
+                forIdx(b, bmpNames) {
+                    const auto& it = bitmaps.manifests.find(bmpNames[b]);
+                    string path =
+                        it != bitmaps.manifests.end() ?
+                        it->second.path :
+                        bmpNames[b];
+                    if(isInMap(prefetchedBitmaps, path)) continue;
+                    bmpPaths.push_back(path);
+                }
+            }
+            prefetchedDataFiles[filePaths[f]] = std::move(files[f]);
+        }
+        std::sort(bmpPaths.begin(), bmpPaths.end());
+        bmpPaths.erase(
+            std::unique(bmpPaths.begin(), bmpPaths.end()), bmpPaths.end()
+        );
+        vector<ALLEGRO_BITMAP*> bmps(bmpPaths.size(), nullptr);
+        
+        loadPool.parallelFor(
+            bmpPaths.size(),
+        [&] (size_t threadIdx, size_t start, size_t end) {
+            double rangeStartTime = al_get_time();
+            int oldFlags = al_get_new_bitmap_flags();
+            int oldFormat = al_get_new_bitmap_format();
+            al_set_new_bitmap_flags(bmpFlags);
+            al_set_new_bitmap_format(bmpFormat);
+            for(size_t b = start; b < end; b++) {
+                bmps[b] = al_load_bitmap(bmpPaths[b].c_str());
+            }
+            al_set_new_bitmap_flags(oldFlags);
+            al_set_new_bitmap_format(oldFormat);
+            threadTimes[threadIdx] += al_get_time() - rangeStartTime;
+        }
+        );
+        
+        forIdx(b, bmps) {
+            if(!bmps[b]) continue;
+            prefetchedBitmaps[bmpPaths[b]] = bmps[b];
+        }
+        
+        //Statistics.
+        if(game.perfMon && !filePaths.empty()) {
+            double serialTime = 0.0;
+            forIdx(th, threadTimes) {
+                serialTime += threadTimes[th];
+            }
+            string perfMonName = mgrPtr->getPerfMonMeasurementName();
+            if(perfMonName.empty()) perfMonName = mgrPtr->getName();
+            game.perfMon->addParallelMeasurement(
+                perfMonName, al_get_time() - startTime, serialTime,
+                loadPool.getNrThreads()
+            );
+        }
+    }
+}
+
+
 /**
  * @brief Reloads all packs.
  * This only loads their manifests and metadata, not their content!
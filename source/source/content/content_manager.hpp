@@ -13,6 +13,7 @@
 #include <map>
 #include <string>
 
+#include "../util/thread_utils.hpp"
 #include "content_type_manager.hpp"
 
 
@@ -123,6 +124,10 @@ struct ContentManager {
         const string& description = "", const string& maker = "",
         const string& license = ""
     );
+    ALLEGRO_BITMAP* claimPrefetchedBitmap(const string& path);
+    bool claimPrefetchedDataFile(
+        const string& path, DataNode* outNode, bool* outSuccess
+    );
     bool loadAreaAsCurrent(
         const string& requestedAreaPath, ContentManifest* manifPtr,
         CONTENT_LOAD_LEVEL level, bool fromBackup, string* outScriptFilePath
@@ -134,13 +139,42 @@ struct ContentManager {
     
     private:
     
+    //--- Private misc. declarations ---
+    
+    /**
+     * @brief A data file that was read ahead of time.
+     */
+    struct PrefetchedDataFile {
+        
+        //--- Public members ---
+        
+        //The file's contents.
+        DataNode node;
+        
+        //Whether the file was successfully opened.
+        bool success = false;
+        
+    };
+    
+    
     //--- Private members ---
     
     CONTENT_LOAD_LEVEL loadLevels[N_CONTENT_TYPES];
     
+    //Threads that read data files and decode images ahead of time.
+    WorkerPool loadPool;
+    
+    //Data files read ahead of time, by path.
+    map<string, PrefetchedDataFile> prefetchedDataFiles;
+    
+    //Images decoded ahead of time into memory bitmaps, by path.
+    map<string, ALLEGRO_BITMAP*> prefetchedBitmaps;
+    
     
     //--- Private function declarations ---
     
+    void clearPrefetchedContent();
     ContentTypeManager* getMgrPtr(CONTENT_TYPE type);
+    void prefetchContent(const vector<CONTENT_TYPE>& types);
     
 };
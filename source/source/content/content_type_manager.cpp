@@ -89,6 +89,28 @@ string AreaContentManager::getPerfMonMeasurementName() const {
 }
 
 
+/**
+ * @brief Returns the paths of the data files that loading all content
+ * will read, so they can be read ahead of time.
+ *
+ * @param outPaths The paths are added here.
+ */
+void AreaContentManager::getPrefetchDataFiles(
+    vector<string>& outPaths
+) const {
+    forIdx(t, manifests) {
+        for(const auto& m : manifests[t]) {
+            outPaths.push_back(
+                m.second.path + "/" + FILE_NAMES::AREA_MAIN_DATA
+            );
+            outPaths.push_back(
+                m.second.path + "/" + FILE_NAMES::AREA_GEOMETRY
+            );
+        }
+    }
+}
+
+
 /**
  * @brief Loads all content in the manifests.
  *
@@ -469,6 +491,29 @@ void ContentTypeManager::fillManifestsMapFromPack(
 }
 
 
+/**
+ * @brief Returns the names of the bitmaps that loading a given data file
+ * will use, so they can be decoded ahead of time. By default, there are none.
+ *
+ * @param file The data file.
+ * @param outNames The names are added here.
+ */
+void ContentTypeManager::getPrefetchBitmaps(
+    DataNode* file, vector<string>& outNames
+) const {
+}
+
+
+/**
+ * @brief Returns the paths of the data files that loading all content
+ * will read, so they can be read ahead of time. By default, there are none.
+ *
+ * @param outPaths The paths are added here.
+ */
+void ContentTypeManager::getPrefetchDataFiles(vector<string>& outPaths) const {
+}
+
+
 #pragma endregion
 #pragma region Global animation
 
@@ -511,6 +556,35 @@ string GlobalAnimContentManager::getPerfMonMeasurementName() const {
 }
 
 
+/**
+ * @brief Returns the names of the bitmaps that loading a given data file
+ * will use, so they can be decoded ahead of time.
+ *
+ * @param file The data file.
+ * @param outNames The names are added here.
+ */
+void GlobalAnimContentManager::getPrefetchBitmaps(
+    DataNode* file, vector<string>& outNames
+) const {
+    AnimationDatabase::getBitmapNamesFromDataNode(file, outNames);
+}
+
+
+/**
+ * @brief Returns the paths of the data files that loading all content
+ * will read, so they can be read ahead of time.
+ *
+ * @param outPaths The paths are added here.
+ */
+void GlobalAnimContentManager::getPrefetchDataFiles(
+    vector<string>& outPaths
+) const {
+    for(const auto& m : manifests) {
+        outPaths.push_back(m.second.path);
+    }
+}
+
+
 /**
  * @brief Loads all content in the manifests.
  *
@@ -532,7 +606,7 @@ void GlobalAnimContentManager::loadAll(CONTENT_LOAD_LEVEL level) {
 void GlobalAnimContentManager::loadAnimationDb(
     ContentManifest* manifest, CONTENT_LOAD_LEVEL level
 ) {
-    DataNode file(manifest->path);
+    DataNode file = loadDataFile(manifest->path, nullptr, false);
     AnimationDatabase db;
     db.manifest = manifest;
     db.loadFromDataNode(&file);
@@ -626,6 +700,21 @@ string GuiContentManager::getPerfMonMeasurementName() const {
 }
 
 
+/**
+ * @brief Returns the paths of the data files that loading all content
+ * will read, so they can be read ahead of time.
+ *
+ * @param outPaths The paths are added here.
+ */
+void GuiContentManager::getPrefetchDataFiles(
+    vector<string>& outPaths
+) const {
+    for(const auto& m : manifests) {
+        outPaths.push_back(m.second.path);
+    }
+}
+
+
 /**
  * @brief Loads all content in the manifests.
  *
@@ -721,6 +810,21 @@ string HazardContentManager::getPerfMonMeasurementName() const {
 }
 
 
+/**
+ * @brief Returns the paths of the data files that loading all content
+ * will read, so they can be read ahead of time.
+ *
+ * @param outPaths The paths are added here.
+ */
+void HazardContentManager::getPrefetchDataFiles(
+    vector<string>& outPaths
+) const {
+    for(const auto& m : manifests) {
+        outPaths.push_back(m.second.path);
+    }
+}
+
+
 /**
  * @brief Loads all content in the manifests.
  *
@@ -836,6 +940,21 @@ string LiquidContentManager::getPerfMonMeasurementName() const {
 }
 
 
+/**
+ * @brief Returns the paths of the data files that loading all content
+ * will read, so they can be read ahead of time.
+ *
+ * @param outPaths The paths are added here.
+ */
+void LiquidContentManager::getPrefetchDataFiles(
+    vector<string>& outPaths
+) const {
+    for(const auto& m : manifests) {
+        outPaths.push_back(m.second.path);
+    }
+}
+
+
 /**
  * @brief Loads all content in the manifests.
  *
@@ -954,6 +1073,26 @@ string MiscConfigContentManager::getPerfMonMeasurementName() const {
 }
 
 
+/**
+ * @brief Returns the paths of the data files that loading all content
+ * will read, so they can be read ahead of time.
+ *
+ * @param outPaths The paths are added here.
+ */
+void MiscConfigContentManager::getPrefetchDataFiles(
+    vector<string>& outPaths
+) const {
+    const string fileNames[] = {
+        FILE_NAMES::GAME_CONFIG, FILE_NAMES::SYSTEM_CONTENT_NAMES
+    };
+    for(const string& f : fileNames) {
+        const auto& it = manifests.find(removeExtension(f));
+        if(it == manifests.end()) continue;
+        outPaths.push_back(it->second.path);
+    }
+}
+
+
 /**
  * @brief Loads all content in the manifests.
  *
@@ -1103,6 +1242,37 @@ string MobAnimContentManager::getPerfMonMeasurementName() const {
 }
 
 
+/**
+ * @brief Returns the names of the bitmaps that loading a given data file
+ * will use, so they can be decoded ahead of time.
+ *
+ * @param file The data file.
+ * @param outNames The names are added here.
+ */
+void MobAnimContentManager::getPrefetchBitmaps(
+    DataNode* file, vector<string>& outNames
+) const {
+    AnimationDatabase::getBitmapNamesFromDataNode(file, outNames);
+}
+
+
+/**
+ * @brief Returns the paths of the data files that loading all content
+ * will read, so they can be read ahead of time.
+ *
+ * @param outPaths The paths are added here.
+ */
+void MobAnimContentManager::getPrefetchDataFiles(
+    vector<string>& outPaths
+) const {
+    forIdx(c, manifests) {
+        for(const auto& m : manifests[c]) {
+            outPaths.push_back(m.second.path);
+        }
+    }
+}
+
+
 /**
  * @brief Loads all content in the manifests.
  *
@@ -1128,7 +1298,7 @@ void MobAnimContentManager::loadAll(CONTENT_LOAD_LEVEL level) {
 void MobAnimContentManager::loadAnimationDb(
     ContentManifest* manifest, CONTENT_LOAD_LEVEL level, MOB_CATEGORY categoryId
 ) {
-    DataNode file(manifest->path);
+    DataNode file = loadDataFile(manifest->path, nullptr, false);
     AnimationDatabase db;
     db.manifest = manifest;
     db.loadFromDataNode(&file);
@@ -1259,6 +1429,25 @@ string MobTypeContentManager::getPerfMonMeasurementName() const {
 }
 
 
+/**
+ * @brief Returns the paths of the data files that loading all content
+ * will read, so they can be read ahead of time.
+ *
+ * @param outPaths The paths are added here.
+ */
+void MobTypeContentManager::getPrefetchDataFiles(
+    vector<string>& outPaths
+) const {
+    forIdx(c, manifests) {
+        for(const auto& m : manifests[c]) {
+            outPaths.push_back(
+                m.second.path + "/" + FILE_NAMES::MOB_TYPE_MAIN_DATA
+            );
+        }
+    }
+}
+
+
 /**
  * @brief Loads all content in the manifests.
  *
@@ -1366,10 +1555,11 @@ void MobTypeContentManager::loadMobTypesOfCategory(
     map<string, ContentManifest>& man = manifests[category->id];
     for(auto& t : man) {
         bool fileWasOpened = false;
-        DataNode file(
-            t.second.path + "/" + FILE_NAMES::MOB_TYPE_MAIN_DATA,
-            &fileWasOpened
-        );
+        DataNode file =
+            loadDataFile(
+                t.second.path + "/" + FILE_NAMES::MOB_TYPE_MAIN_DATA,
+                &fileWasOpened, false
+            );
         if(!fileWasOpened) continue;
         
         MobType* mt;
@@ -1527,6 +1717,21 @@ string ParticleGenContentManager::getPerfMonMeasurementName() const {
 }
 
 
+/**
+ * @brief Returns the paths of the data files that loading all content
+ * will read, so they can be read ahead of time.
+ *
+ * @param outPaths The paths are added here.
+ */
+void ParticleGenContentManager::getPrefetchDataFiles(
+    vector<string>& outPaths
+) const {
+    for(const auto& m : manifests) {
+        outPaths.push_back(m.second.path);
+    }
+}
+
+
 /**
  * @brief Loads all content in the manifests.
  *
@@ -1555,6 +1760,7 @@ void ParticleGenContentManager::loadGenerator(
     ParticleGenerator newPg;
     newPg.manifest = manifest;
     newPg.loadFromDataNode(&file, level);
+    newPg.budgetIdx = list.size();
     list[manifest->internalName] = newPg;
 }
 
@@ -1645,6 +1851,21 @@ string SongContentManager::getPerfMonMeasurementName() const {
 }
 
 
+/**
+ * @brief Returns the paths of the data files that loading all content
+ * will read, so they can be read ahead of time.
+ *
+ * @param outPaths The paths are added here.
+ */
+void SongContentManager::getPrefetchDataFiles(
+    vector<string>& outPaths
+) const {
+    for(const auto& m : manifests) {
+        outPaths.push_back(m.second.path);
+    }
+}
+
+
 /**
  * @brief Loads all content in the manifests.
  *
@@ -1972,6 +2193,21 @@ string SpikeDamageTypeContentManager::getPerfMonMeasurementName() const {
 }
 
 
+/**
+ * @brief Returns the paths of the data files that loading all content
+ * will read, so they can be read ahead of time.
+ *
+ * @param outPaths The paths are added here.
+ */
+void SpikeDamageTypeContentManager::getPrefetchDataFiles(
+    vector<string>& outPaths
+) const {
+    for(const auto& m : manifests) {
+        outPaths.push_back(m.second.path);
+    }
+}
+
+
 /**
  * @brief Loads all content in the manifests.
  *
@@ -2087,6 +2323,21 @@ string SprayTypeContentManager::getPerfMonMeasurementName() const {
 }
 
 
+/**
+ * @brief Returns the paths of the data files that loading all content
+ * will read, so they can be read ahead of time.
+ *
+ * @param outPaths The paths are added here.
+ */
+void SprayTypeContentManager::getPrefetchDataFiles(
+    vector<string>& outPaths
+) const {
+    for(const auto& m : manifests) {
+        outPaths.push_back(m.second.path);
+    }
+}
+
+
 /**
  * @brief Loads all content in the manifests.
  *
@@ -2237,6 +2488,21 @@ string StatusTypeContentManager::getPerfMonMeasurementName() const {
 }
 
 
+/**
+ * @brief Returns the paths of the data files that loading all content
+ * will read, so they can be read ahead of time.
+ *
+ * @param outPaths The paths are added here.
+ */
+void StatusTypeContentManager::getPrefetchDataFiles(
+    vector<string>& outPaths
+) const {
+    for(const auto& m : manifests) {
+        outPaths.push_back(m.second.path);
+    }
+}
+
+
 /**
  * @brief Loads all content in the manifests.
  *
@@ -2388,6 +2654,21 @@ string WeatherConditionContentManager::getPerfMonMeasurementName() const {
 }
 
 
+/**
+ * @brief Returns the paths of the data files that loading all content
+ * will read, so they can be read ahead of time.
+ *
+ * @param outPaths The paths are added here.
+ */
+void WeatherConditionContentManager::getPrefetchDataFiles(
+    vector<string>& outPaths
+) const {
+    for(const auto& m : manifests) {
+        outPaths.push_back(m.second.path);
+    }
+}
+
+
 /**
  * @brief Loads all content in the manifests.
  *
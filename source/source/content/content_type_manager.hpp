@@ -42,6 +42,10 @@ public:
     virtual void fillManifests() = 0;
     virtual string getName() const = 0;
     virtual string getPerfMonMeasurementName() const = 0;
+    virtual void getPrefetchBitmaps(
+        DataNode* file, vector<string>& outNames
+    ) const;
+    virtual void getPrefetchDataFiles(vector<string>& outPaths) const;
     virtual void loadAll(CONTENT_LOAD_LEVEL level) = 0;
     virtual void unloadAll(CONTENT_LOAD_LEVEL level) = 0;
     
@@ -87,6 +91,7 @@ public:
     );
     string getName() const override;
     string getPerfMonMeasurementName() const override;
+    void getPrefetchDataFiles(vector<string>& outPaths) const override;
     void loadAll(CONTENT_LOAD_LEVEL level) override;
     bool loadArea(
         Area* areaPtr, const string& requestedAreaPath,
@@ -175,6 +180,10 @@ public:
     void fillManifests() override;
     string getName() const override;
     string getPerfMonMeasurementName() const override;
+    void getPrefetchBitmaps(
+        DataNode* file, vector<string>& outNames
+    ) const override;
+    void getPrefetchDataFiles(vector<string>& outPaths) const override;
     void loadAll(CONTENT_LOAD_LEVEL level) override;
     string manifestToPath(const ContentManifest& manifest) const;
     void pathToManifest(
@@ -214,6 +223,7 @@ public:
     void fillManifests() override;
     string getName() const override;
     string getPerfMonMeasurementName() const override;
+    void getPrefetchDataFiles(vector<string>& outPaths) const override;
     void loadAll(CONTENT_LOAD_LEVEL level) override;
     string manifestToPath(const ContentManifest& manifest) const;
     void pathToManifest(
@@ -247,6 +257,7 @@ public:
     void fillManifests() override;
     string getName() const override;
     string getPerfMonMeasurementName() const override;
+    void getPrefetchDataFiles(vector<string>& outPaths) const override;
     void loadAll(CONTENT_LOAD_LEVEL level) override;
     string manifestToPath(const ContentManifest& manifest) const;
     void pathToManifest(
@@ -286,6 +297,7 @@ public:
     void fillManifests() override;
     string getName() const override;
     string getPerfMonMeasurementName() const override;
+    void getPrefetchDataFiles(vector<string>& outPaths) const override;
     void loadAll(CONTENT_LOAD_LEVEL level) override;
     string manifestToPath(const ContentManifest& manifest) const;
     void pathToManifest(
@@ -322,6 +334,7 @@ public:
     void fillManifests() override;
     string getName() const override;
     string getPerfMonMeasurementName() const override;
+    void getPrefetchDataFiles(vector<string>& outPaths) const override;
     void loadAll(CONTENT_LOAD_LEVEL level) override;
     string manifestToPath(const ContentManifest& manifest) const;
     void pathToManifest(
@@ -356,6 +369,10 @@ public:
     void fillManifests() override;
     string getName() const override;
     string getPerfMonMeasurementName() const override;
+    void getPrefetchBitmaps(
+        DataNode* file, vector<string>& outNames
+    ) const override;
+    void getPrefetchDataFiles(vector<string>& outPaths) const override;
     void loadAll(CONTENT_LOAD_LEVEL level) override;
     string manifestToPath(
         const ContentManifest& manifest, const string& category,
@@ -406,6 +423,7 @@ public:
     void fillManifests() override;
     string getName() const override;
     string getPerfMonMeasurementName() const override;
+    void getPrefetchDataFiles(vector<string>& outPaths) const override;
     void loadAll(CONTENT_LOAD_LEVEL level) override;
     string manifestToPath(
         const ContentManifest& manifest, const string& category
@@ -454,6 +472,7 @@ public:
     void fillManifests() override;
     string getName() const override;
     string getPerfMonMeasurementName() const override;
+    void getPrefetchDataFiles(vector<string>& outPaths) const override;
     void loadAll(CONTENT_LOAD_LEVEL level) override;
     string manifestToPath(const ContentManifest& manifest) const;
     void pathToManifest(
@@ -494,6 +513,7 @@ public:
     void fillManifests() override;
     string getName() const override;
     string getPerfMonMeasurementName() const override;
+    void getPrefetchDataFiles(vector<string>& outPaths) const override;
     void loadAll(CONTENT_LOAD_LEVEL level) override;
     string manifestToPath(const ContentManifest& manifest) const;
     void pathToManifest(
@@ -606,6 +626,7 @@ public:
     void fillManifests() override;
     string getName() const override;
     string getPerfMonMeasurementName() const override;
+    void getPrefetchDataFiles(vector<string>& outPaths) const override;
     void loadAll(CONTENT_LOAD_LEVEL level) override;
     string manifestToPath(const ContentManifest& manifest) const;
     void pathToManifest(
@@ -648,6 +669,7 @@ public:
     void fillManifests() override;
     string getName() const override;
     string getPerfMonMeasurementName() const override;
+    void getPrefetchDataFiles(vector<string>& outPaths) const override;
     void loadAll(CONTENT_LOAD_LEVEL level) override;
     string manifestToPath(const ContentManifest& manifest) const;
     void pathToManifest(
@@ -688,6 +710,7 @@ public:
     void fillManifests() override;
     string getName() const override;
     string getPerfMonMeasurementName() const override;
+    void getPrefetchDataFiles(vector<string>& outPaths) const override;
     void loadAll(CONTENT_LOAD_LEVEL level) override;
     string manifestToPath(const ContentManifest& manifest) const;
     void pathToManifest(
@@ -728,6 +751,7 @@ public:
     void fillManifests() override;
     string getName() const override;
     string getPerfMonMeasurementName() const override;
+    void getPrefetchDataFiles(vector<string>& outPaths) const override;
     void loadAll(CONTENT_LOAD_LEVEL level) override;
     string manifestToPath(const ContentManifest& manifest) const;
     void pathToManifest(
@@ -218,6 +218,9 @@ bool Bridge::checkHealth() {
     Point offset(chunkWidth * chunks - mobRadius, 0);
     offset = rotatePoint(offset, angle);
     center = startPos + offset;
+    game.states.gameplay->mobInteractionGrid.handleMobMoved(
+        game.states.gameplay->mobs.all, this
+    );
     bottomZ = startZ + prevChunkComponents[0]->bottomZ;
     groundSector = prevChunkComponents[0]->groundSector;
     
@@ -179,7 +179,7 @@ Mob::Mob(const Point& center, MobType* type, float angle) :
     
     game.states.gameplay->nextMobId++;
     
-    Sector* sec = getSector(center, nullptr, true);
+    Sector* sec = getSector(center, nullptr, true, &lastSectorHit);
     if(sec) {
         bottomZ = sec->floorZ;
     } else {
@@ -187,6 +187,8 @@ Mob::Mob(const Point& center, MobType* type, float angle) :
     }
     groundSector = sec;
     centerSector = sec;
+    prevTickCenter = center;
+    prevTickBottomZ = bottomZ;
     
     team = type->startingTeam;
     
@@ -1333,6 +1335,29 @@ bool Mob::canReceiveStatus(StatusType* s) const {
 }
 
 
+/**
+ * @brief Returns whether or not a mob can be put to sleep. This is the case
+ * if it's inactive and has nothing that could make it do anything while
+ * inactive: no logic that runs while inactive, no movement, and no
+ * other mobs it's tied to.
+ *
+ * @return Whether it can sleep.
+ */
+bool Mob::canSleep() const {
+    if(isActive || toDelete) return false;
+    if(timeAlive <= GAMEPLAY::MOB_INACTIVE_GRACE_TIME) return false;
+    if(
+        hasFlag(type->inactiveLogic, INACTIVE_LOGIC_FLAG_TICKS) ||
+        hasFlag(type->inactiveLogic, INACTIVE_LOGIC_FLAG_INTERACTIONS)
+    ) {
+        return false;
+    }
+    if(speed.x != 0.0f || speed.y != 0.0f || speedZ != 0.0f) return false;
+    if(parent || holder.m || !holding.empty() || storedInside) return false;
+    return true;
+}
+
+
 /**
  * @brief Makes the mob cause spike damage to another mob.
  *
@@ -2130,6 +2155,38 @@ bool Mob::followPath(
 }
 
 
+/**
+ * @brief Returns the multiplier for the mob's animation speed, based on
+ * its statuses and movement speed.
+ *
+ * @return The multiplier.
+ */
+float Mob::getAnimationSpeedMult() const {
+    float mult = 1.0f;
+    forIdx(s, statuses) {
+        if(statuses[s].state != STATUS_STATE_ACTIVE) continue;
+        float vulnMult = statuses[s].type->animSpeedMultiplier - 1.0f;
+        auto vulnIt = type->statusVulnerabilities.find(statuses[s].type);
+        if(vulnIt != type->statusVulnerabilities.end()) {
+            vulnMult *= vulnIt->second.effectMult;
+        }
+        mult *= (vulnMult + 1.0f);
+    }
+    
+    if(mobSpeedAnimBaseline != 0.0f) {
+        float mobSpeedMult = chaseInfo.curSpeed / mobSpeedAnimBaseline;
+        mobSpeedMult =
+            std::clamp(
+                mobSpeedMult,
+                MOB::MOB_SPEED_ANIM_MIN_MULT, MOB::MOB_SPEED_ANIM_MAX_MULT
+            );
+        mult *= mobSpeedMult;
+    }
+    
+    return mult;
+}
+
+
 /**
  * @brief Returns the base speed for this mob.
  * This is overwritten by some child classes.
@@ -3451,7 +3508,7 @@ void Mob::releaseStoredMobs() {
  */
 void Mob::respawn() {
     center = home;
-    centerSector = getSector(center, nullptr, true);
+    centerSector = getSector(center, nullptr, true, &lastSectorHit);
     groundSector = centerSector;
     bottomZ = centerSector->floorZ + 100;
 }
@@ -4003,6 +4060,11 @@ void Mob::swallowChompedPikmin(Mob* mPtr) {
  * send signals to the muscles, and gravity, inertia, etc.
  * take over the rest, to make you move.
  *
+ * The animation isn't ticked here. The gameplay state ticks the animations
+ * of all mobs afterwards with tickAnimationState(), so the order of events
+ * is the same however many threads it uses. This also means the interactions
+ * this frame use the animation frame from before the animation's tick.
+ *
  * @param deltaT How long the frame's tick is, in seconds.
  */
 void Mob::tick(float deltaT) {
@@ -4043,16 +4105,6 @@ void Mob::tick(float deltaT) {
     }
     if(toDelete) return;
     
-    //Animation.
-    if(game.perfMon) {
-        game.perfMon->startMeasurement("Object -- Animation");
-    }
-    tickAnimation(deltaT);
-    if(game.perfMon) {
-        game.perfMon->finishMeasurement();
-    }
-    if(toDelete) return;
-    
     //Script.
     if(game.perfMon) {
         game.perfMon->startMeasurement("Object -- Script");
@@ -4075,47 +4127,36 @@ void Mob::tick(float deltaT) {
 
 
 /**
- * @brief Ticks animation time by one frame of logic.
+ * @brief Ticks the mob's animations and animation-related timers by one
+ * frame of logic, but doesn't run any of the events that come from that.
+ * This only changes the mob itself, so it can run in parallel with
+ * the same logic for other mobs.
  *
  * @param deltaT How long the frame's tick is, in seconds.
+ * @param outFrameSignals Any frame signals reached are added here.
+ * @param outFrameSounds Any frame sounds reached are added here.
+ * @return Whether the animation reached its end.
  */
-void Mob::tickAnimation(float deltaT) {
-    float mult = 1.0f;
-    forIdx(s, statuses) {
-        if(statuses[s].state != STATUS_STATE_ACTIVE) continue;
-        float vulnMult = statuses[s].type->animSpeedMultiplier - 1.0f;
-        auto vulnIt = type->statusVulnerabilities.find(statuses[s].type);
-        if(vulnIt != type->statusVulnerabilities.end()) {
-            vulnMult *= vulnIt->second.effectMult;
-        }
-        mult *= (vulnMult + 1.0f);
-    }
-    
-    if(mobSpeedAnimBaseline != 0.0f) {
-        float mobSpeedMult = chaseInfo.curSpeed / mobSpeedAnimBaseline;
-        mobSpeedMult =
-            std::clamp(
-                mobSpeedMult,
-                MOB::MOB_SPEED_ANIM_MIN_MULT, MOB::MOB_SPEED_ANIM_MAX_MULT
-            );
-        mult *= mobSpeedMult;
-    }
-    
-    vector<size_t> frameSignals;
-    vector<size_t> frameSounds;
+bool Mob::tickAnimationState(
+    float deltaT,
+    vector<size_t>* outFrameSignals, vector<size_t>* outFrameSounds
+) {
+    float mult = getAnimationSpeedMult();
     bool finishedAnim =
-        anim.tick(deltaT * mult, &frameSignals, &frameSounds);
-        
-    if(finishedAnim) {
-        scriptVM.fsm.runEvent(FSM_EV_ANIMATION_END);
-    }
-    forIdx(s, frameSignals) {
-        scriptVM.fsm.runEvent(FSM_EV_FRAME_SIGNAL, &frameSignals[s]);
-    }
-    forIdx(s, frameSounds) {
-        playSound(frameSounds[s]);
-    }
-    
+        anim.tick(deltaT * mult, outFrameSignals, outFrameSounds);
+    tickAnimationTimers(deltaT, mult);
+    return finishedAnim;
+}
+
+
+/**
+ * @brief Ticks the timers that go along with the mob's animation,
+ * like the limb animation and the hit opponent cooldowns.
+ *
+ * @param deltaT How long the frame's tick is, in seconds.
+ * @param animSpeedMult Animation speed multiplier for this frame.
+ */
+void Mob::tickAnimationTimers(float deltaT, float animSpeedMult) {
     for(size_t h = 0; h < hitOpponents.size();) {
         hitOpponents[h].first -= deltaT;
         if(hitOpponents[h].first <= 0.0f) {
@@ -4126,7 +4167,7 @@ void Mob::tickAnimation(float deltaT) {
     }
     
     if(parent && parent->limbAnim.animDb) {
-        parent->limbAnim.tick(deltaT * mult);
+        parent->limbAnim.tick(deltaT * animSpeedMult);
     }
 }
 
@@ -21,6 +21,7 @@
 #include "../../core/misc_structs.hpp"
 #include "../../game_state/gameplay/in_world_hud.hpp"
 #include "../../util/general_utils.hpp"
+#include "../../util/memory_utils.hpp"
 #include "../animation/animation.hpp"
 #include "../area/sector.hpp"
 #include "../other/particle.hpp"
@@ -101,6 +102,9 @@ public:
     //Schedule this mob to be deleted from memory at the end of the frame.
     bool toDelete = false;
     
+    //Is it in the middle of being deleted, as part of a batch?
+    bool beingDeleted = false;
+    
     //-Position-
     
     //Center coordinates.
@@ -109,6 +113,12 @@ public:
     //Z coordinate of its bottom. The higher the value, the higher in the sky.
     float bottomZ = 0.0f;
     
+    //Center coordinates as of the previous fixed-step logic tick.
+    Point prevTickCenter;
+    
+    //Bottom Z coordinate as of the previous fixed-step logic tick.
+    float prevTickBottomZ = 0.0f;
+    
     //Current facing angle. 0 = right, PI / 2 = up, etc.
     float angle = 0.0f;
     
@@ -118,6 +128,9 @@ public:
     //Sector that the mob's center is on.
     Sector* centerSector = nullptr;
     
+    //Sector triangle the mob was last found in. Cache for performance.
+    SectorTriangle lastSectorHit;
+    
     //Mob this mob is standing on top of, if any.
     Mob* standingOnMob = nullptr;
     
@@ -334,6 +347,13 @@ public:
     //Whether it's active this frame. Cache for performance.
     bool isActive = false;
     
+    //Whether it's asleep. Sleeping mobs are inactive, and aren't checked
+    //again until something wakes them up.
+    bool isSleeping = false;
+    
+    //Index of the active cell it's sleeping in, if any.
+    size_t sleepCellIdx = INVALID;
+    
     
     //--- Public function declarations ---
     
@@ -341,6 +361,10 @@ public:
     virtual ~Mob();
     
     void tick(float deltaT);
+    bool tickAnimationState(
+        float deltaT,
+        vector<size_t>* outFrameSignals, vector<size_t>* outFrameSounds
+    );
     void drawLimb();
     virtual void drawMob();
     
@@ -407,6 +431,7 @@ public:
         const Mob* attacker, const Hitbox* attackH, const Hitbox* victimH,
         float damage, float knockback
     );
+    bool canSleep() const;
     bool isGenerallyAvailable() const;
     bool isGenerallyVisible() const;
     bool isMobOrParentStoredInside() const;
@@ -542,8 +567,9 @@ protected:
         const unordered_set<PikminType*>& availableTypes
     ) const;
     Mob* getMobToWalkOn() const;
+    float getAnimationSpeedMult() const;
     HORIZ_MOVE_RESULT getMovementEdgeIntersections(
-        const Point& newPos, vector<Edge*>* intersectingEdges
+        const Point& newPos, ArenaVector<Edge*>* intersectingEdges
     ) const;
     HORIZ_MOVE_RESULT getPhysicsHorizontalMovement(
         float deltaT, float moveSpeedMult, Point* moveSpeed
@@ -553,7 +579,7 @@ protected:
         float* slideAngle
     ) const;
     void moveToPathEnd(float speed, float acceleration);
-    void tickAnimation(float deltaT);
+    void tickAnimationTimers(float deltaT, float animSpeedMult);
     void tickBrain(float deltaT);
     void tickHorizontalMovementPhysics(
         float deltaT, const Point& attemptedMoveSpeed,
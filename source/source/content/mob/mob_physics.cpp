@@ -107,13 +107,13 @@ Mob* Mob::getMobToWalkOn() const {
  * movement is impossible.
  */
 HORIZ_MOVE_RESULT Mob::getMovementEdgeIntersections(
-    const Point& newPos, vector<Edge*>* intersectingEdges
+    const Point& newPos, ArenaVector<Edge*>* intersectingEdges
 ) const {
     //Before checking the edges, let's consult the blockmap and look at
     //the edges in the same blocks the mob is on.
     //This way, we won't check for edges that are really far away.
     //Use the bounding box to know which blockmap blocks the mob will be on.
-    set<Edge*> candidateEdges;
+    vector<size_t>& candidateEdges = game.states.gameplay->edgeQueryBuffer;
     //Use the terrain radius if the mob is moving about and alive.
     //Otherwise if it's a corpse, it can use the regular radius.
     float radiusToUse =
@@ -135,7 +135,8 @@ HORIZ_MOVE_RESULT Mob::getMovementEdgeIntersections(
     }
     
     //Go through each edge, and figure out if it is a valid wall for our mob.
-    for(auto& ePtr : candidateEdges) {
+    forIdx(e, candidateEdges) {
+        Edge* ePtr = game.curArea->edges[candidateEdges[e]];
         bool isEdgeBlocking = false;
         
         if(
@@ -234,7 +235,7 @@ HORIZ_MOVE_RESULT Mob::getPhysicsHorizontalMovement(
         
         if(hasFlag(chaseInfo.flags, CHASE_FLAG_TELEPORT)) {
             Sector* sec =
-                getSector(finalTargetPos, nullptr, true);
+                getSector(finalTargetPos, nullptr, true, &lastSectorHit);
                 
             if(!sec) {
                 //No sector, invalid teleport. No move.
@@ -416,7 +417,8 @@ void Mob::tickHorizontalMovementPhysics(
         float newZ = bottomZ;
         
         //Get the sector the mob will be on.
-        Sector* newCenterSector = getSector(newPos, nullptr, true);
+        Sector* newCenterSector =
+            getSector(newPos, nullptr, true, &lastSectorHit);
         Sector* newGroundSector = newCenterSector;
         Sector* stepSector = newCenterSector;
         
@@ -429,7 +431,9 @@ void Mob::tickHorizontalMovementPhysics(
             return;
         }
         //Get all edges it collides against in this new position.
-        vector<Edge*> intersectingEdges;
+        ArenaVector<Edge*> intersectingEdges(
+            game.states.gameplay->frameArena
+        );
         if(
             getMovementEdgeIntersections(newPos, &intersectingEdges) ==
             HORIZ_MOVE_RESULT_FAIL
@@ -1440,6 +1440,10 @@ Mob* createMob(
     
     //Add it to the right vectors.
     game.states.gameplay->mobs.all.push_back(mPtr);
+    if(game.states.gameplay->mobs.byId.size() <= mPtr->id) {
+        game.states.gameplay->mobs.byId.resize(mPtr->id + 1, nullptr);
+    }
+    game.states.gameplay->mobs.byId[mPtr->id] = mPtr;
     if(mPtr->type->walkable) {
         game.states.gameplay->mobs.walkables.push_back(mPtr);
     }
@@ -1478,109 +1482,203 @@ Mob* createMob(MobGen* gen) {
  * and such, since everything is going to be destroyed.
  */
 void deleteMob(Mob* mPtr, bool completeDestruction) {
-    if(game.makerTools.inspectedMob == mPtr) {
-        game.makerTools.inspectedMob = nullptr;
+    ArenaVector<Mob*> victims(game.states.gameplay->frameArena);
+    victims.push_back(mPtr);
+    deleteMobs(victims, completeDestruction);
+}
+
+
+/**
+ * @brief Deletes several mobs at once from the relevant vectors.
+ *
+ * This does the same as deleteMob() for each one, but other mobs only
+ * need to be checked for references to the victims once for the whole batch,
+ * instead of once per victim. All of the victims are taken out of the lists
+ * and forgotten by the other mobs before any event is sent, so no script
+ * that runs because of those events can reach a victim that is halfway
+ * through its deletion.
+ *
+ * @param victims The mobs to delete. These must not repeat.
+ * @param completeDestruction If true, don't bother removing them from groups
+ * and such, since everything is going to be destroyed.
+ */
+void deleteMobs(
+    const ArenaVector<Mob*>& victims, bool completeDestruction
+) {
+    if(victims.empty()) return;
+    
+    MobLists& mobs = game.states.gameplay->mobs;
+    forIdx(v, victims) {
+        Mob* mPtr = victims[v];
+        mPtr->beingDeleted = true;
+        
+        //So that the events below don't get other mobs to pick them.
+        mPtr->toDelete = true;
+        if(game.makerTools.inspectedMob == mPtr) {
+            game.makerTools.inspectedMob = nullptr;
+        }
     }
     
+    //Forget the references to the victims. The events that come from that
+    //are only sent further down.
+    Arena& arena = game.states.gameplay->frameArena;
+    bool areaLostFocus = false;
+    ArenaVector<Mob*> mobsThatLostFocus(arena);
+    ArenaVector<std::pair<Mob*, Mob*> > mobsStoredInVictims(arena);
     if(!completeDestruction) {
-        mPtr->leaveGroup();
+        forIdx(v, victims) {
+            Mob* mPtr = victims[v];
+            mPtr->leaveGroup();
+            mPtr->setCanBlockPaths(false);
+        }
         
-        if(game.states.gameplay->scriptVM.focusedMob == mPtr) {
-            game.states.gameplay->scriptVM.fsm.runEvent(
-                FSM_EV_FOCUSED_MOB_UNAVAILABLE
-            );
-            game.states.gameplay->scriptVM.fsm.runEvent(
-                FSM_EV_FOCUS_OFF_REACH
-            );
-            game.states.gameplay->scriptVM.fsm.runEvent(
-                FSM_EV_FOCUS_DIED
-            );
+        if(
+            game.states.gameplay->scriptVM.focusedMob &&
+            game.states.gameplay->scriptVM.focusedMob->beingDeleted
+        ) {
             game.states.gameplay->scriptVM.focusedMob = nullptr;
+            areaLostFocus = true;
         }
         
-        forIdx(m, game.states.gameplay->mobs.all) {
-            Mob* m2Ptr = game.states.gameplay->mobs.all[m];
-            if(m2Ptr->scriptVM.focusedMob == mPtr) {
-                m2Ptr->scriptVM.fsm.runEvent(FSM_EV_FOCUSED_MOB_UNAVAILABLE);
-                m2Ptr->scriptVM.fsm.runEvent(FSM_EV_FOCUS_OFF_REACH);
-                m2Ptr->scriptVM.fsm.runEvent(FSM_EV_FOCUS_DIED);
+        forIdx(m, mobs.all) {
+            Mob* m2Ptr = mobs.all[m];
+            if(
+                m2Ptr->scriptVM.focusedMob &&
+                m2Ptr->scriptVM.focusedMob->beingDeleted
+            ) {
                 m2Ptr->scriptVM.focusedMob = nullptr;
+                if(!m2Ptr->beingDeleted) {
+                    mobsThatLostFocus.push_back(m2Ptr);
+                }
             }
-            if(m2Ptr->parent && m2Ptr->parent->m == mPtr) {
+            if(
+                m2Ptr->parent && m2Ptr->parent->m &&
+                m2Ptr->parent->m->beingDeleted
+            ) {
                 delete m2Ptr->parent;
                 m2Ptr->parent = nullptr;
                 m2Ptr->toDelete = true;
             }
             forIdx(c, m2Ptr->chompingMobs) {
-                if(m2Ptr->chompingMobs[c] == mPtr) {
+                if(
+                    m2Ptr->chompingMobs[c] &&
+                    m2Ptr->chompingMobs[c]->beingDeleted
+                ) {
                     m2Ptr->chompingMobs[c] = nullptr;
                 }
             }
             forIdx(l, m2Ptr->links) {
-                if(m2Ptr->links[l] == mPtr) {
+                if(m2Ptr->links[l] && m2Ptr->links[l]->beingDeleted) {
                     m2Ptr->links.erase(m2Ptr->links.begin() + l);
                     l--;
                 }
             }
-            if(m2Ptr->storedInside == mPtr) {
-                mPtr->release(m2Ptr);
-                m2Ptr->stopBeingStored();
+            if(m2Ptr->storedInside && m2Ptr->storedInside->beingDeleted) {
+                mobsStoredInVictims.push_back(
+                    std::make_pair(m2Ptr->storedInside, m2Ptr)
+                );
+                m2Ptr->storedInside = nullptr;
             }
             if(m2Ptr->carryInfo) {
                 forIdx(c, m2Ptr->carryInfo->spotInfo) {
-                    if(m2Ptr->carryInfo->spotInfo[c].pikPtr == mPtr) {
+                    Mob* pikPtr = m2Ptr->carryInfo->spotInfo[c].pikPtr;
+                    if(pikPtr && pikPtr->beingDeleted) {
                         m2Ptr->carryInfo->spotInfo[c].pikPtr =
                             nullptr;
                         m2Ptr->carryInfo->spotInfo[c].state =
                             CARRY_SPOT_STATE_FREE;
                     }
                 }
-                if(m2Ptr->carryInfo->intendedMob == mPtr) {
+                if(
+                    m2Ptr->carryInfo->intendedMob &&
+                    m2Ptr->carryInfo->intendedMob->beingDeleted
+                ) {
                     m2Ptr->carryInfo->mustRecalculate = true;
                 }
             }
         }
+    }
+    
+    //Now send the events. These can run the victims' scripts, which could
+    //make them play sounds and such, so the victims are only taken out
+    //of the lists afterwards.
+    if(!completeDestruction) {
+        forIdx(s, mobsStoredInVictims) {
+            mobsStoredInVictims[s].first->release(
+                mobsStoredInVictims[s].second
+            );
+            mobsStoredInVictims[s].second->stopBeingStored();
+        }
         
-        if(mPtr->holder.m) {
-            mPtr->holder.m->release(mPtr);
+        forIdx(v, victims) {
+            Mob* mPtr = victims[v];
+            if(mPtr->holder.m) {
+                mPtr->holder.m->release(mPtr);
+            }
+            
+            while(!mPtr->holding.empty()) {
+                mPtr->release(mPtr->holding[0]);
+            }
         }
         
-        while(!mPtr->holding.empty()) {
-            mPtr->release(mPtr->holding[0]);
+        if(areaLostFocus) {
+            game.states.gameplay->scriptVM.fsm.runEvent(
+                FSM_EV_FOCUSED_MOB_UNAVAILABLE
+            );
+            game.states.gameplay->scriptVM.fsm.runEvent(
+                FSM_EV_FOCUS_OFF_REACH
+            );
+            game.states.gameplay->scriptVM.fsm.runEvent(
+                FSM_EV_FOCUS_DIED
+            );
         }
         
-        mPtr->setCanBlockPaths(false);
+        forIdx(m, mobsThatLostFocus) {
+            Mob* m2Ptr = mobsThatLostFocus[m];
+            m2Ptr->scriptVM.fsm.runEvent(FSM_EV_FOCUSED_MOB_UNAVAILABLE);
+            m2Ptr->scriptVM.fsm.runEvent(FSM_EV_FOCUS_OFF_REACH);
+            m2Ptr->scriptVM.fsm.runEvent(FSM_EV_FOCUS_DIED);
+        }
         
-        mPtr->scriptVM.fsm.setState(INVALID);
+        forIdx(v, victims) {
+            victims[v]->scriptVM.fsm.setState(INVALID);
+        }
     }
     
-    if(game.curArea->type == AREA_TYPE_MISSION) {
-        forIdx(g, game.states.gameplay->missionMobGroups) {
-            game.states.gameplay->missionMobGroups[g].remove(mPtr);
+    //Take the victims out of the lists.
+    forIdx(v, victims) {
+        Mob* mPtr = victims[v];
+        
+        if(game.curArea->type == AREA_TYPE_MISSION) {
+            forIdx(g, game.states.gameplay->missionMobGroups) {
+                game.states.gameplay->missionMobGroups[g].remove(mPtr);
+            }
+        }
+        
+        game.audio.handleMobDeletion(mPtr);
+        game.states.gameplay->areaActiveCells.removeMob(mPtr);
+        
+        mPtr->type->category->deleteMob(mPtr);
+        if(mPtr->id < mobs.byId.size() && mobs.byId[mPtr->id] == mPtr) {
+            mobs.byId[mPtr->id] = nullptr;
         }
     }
     
-    game.audio.handleMobDeletion(mPtr);
-    
-    mPtr->type->category->deleteMob(mPtr);
-    game.states.gameplay->mobs.all.erase(
-        find(
-            game.states.gameplay->mobs.all.begin(),
-            game.states.gameplay->mobs.all.end(),
-            mPtr
-        )
+    auto isBeingDeleted = [] (const Mob* m) { return m->beingDeleted; };
+    mobs.all.erase(
+        std::remove_if(mobs.all.begin(), mobs.all.end(), isBeingDeleted),
+        mobs.all.end()
+    );
+    mobs.walkables.erase(
+        std::remove_if(
+            mobs.walkables.begin(), mobs.walkables.end(), isBeingDeleted
+        ),
+        mobs.walkables.end()
     );
-    if(mPtr->type->walkable) {
-        game.states.gameplay->mobs.walkables.erase(
-            find(
-                game.states.gameplay->mobs.walkables.begin(),
-                game.states.gameplay->mobs.walkables.end(),
-                mPtr
-            )
-        );
-    }
     
-    delete mPtr;
+    forIdx(v, victims) {
+        delete victims[v];
+    }
 }
 
 
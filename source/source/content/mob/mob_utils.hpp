@@ -19,6 +19,7 @@
 #include "../../core/pathing.hpp"
 #include "../../util/general_utils.hpp"
 #include "../../util/geometry_utils.hpp"
+#include "../../util/memory_utils.hpp"
 #include "../animation/animation.hpp"
 #include "../area/sector.hpp"
 #include "../mob_type/bouncer_type.hpp"
@@ -445,6 +446,10 @@ struct MobLists {
     //All mobs in the area.
     vector<Mob*> all;
     
+    //All mobs created in the area, indexed by their ID. Since IDs are
+    //never reused, deleted mobs just leave a nullptr behind.
+    vector<Mob*> byId;
+    
     //Bouncers.
     vector<Bouncer*> bouncers;
     
@@ -816,6 +821,9 @@ Mob* createMob(
 );
 Mob* createMob(MobGen* gen);
 void deleteMob(Mob* m, bool completeDestruction = false);
+void deleteMobs(
+    const ArenaVector<Mob*>& victims, bool completeDestruction = false
+);
 string getErrorMessageMobInfo(Mob* m);
 vector<Hazard*> getMobTypeListInvulnerabilities(
     const unordered_set<MobType*>& types
@@ -512,6 +512,9 @@ void Pikmin::latch(Mob* m, const Hitbox* h) {
     //at the exact same spot aren't perfectly overlapping each other.
     center.x += game.rng.f(-2.0f, 2.0f);
     center.y += game.rng.f(-2.0f, 2.0f);
+    game.states.gameplay->mobInteractionGrid.handleMobMoved(
+        game.states.gameplay->mobs.all, this
+    );
     
     float hOffsetDist;
     float hOffsetAngle;
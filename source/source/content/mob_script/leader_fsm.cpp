@@ -1741,6 +1741,9 @@ void LeaderFsm::doThrow(ScriptVM* scriptVM, void* info1, void* info2) {
     heldPtr->stopChasing();
     heldPtr->center = leaPtr->center;
     heldPtr->bottomZ = leaPtr->bottomZ;
+    game.states.gameplay->mobInteractionGrid.handleMobMoved(
+        game.states.gameplay->mobs.all, heldPtr
+    );
     
     heldPtr->zCap = leaPtr->throweeMaxZ;
     
@@ -2309,6 +2312,9 @@ void LeaderFsm::release(ScriptVM* scriptVM, void* info1, void* info2) {
     //so that the leader doesn't release the Pikmin inside a wall behind them.
     heldPtr->center = leaPtr->center;
     heldPtr->bottomZ = leaPtr->bottomZ;
+    game.states.gameplay->mobInteractionGrid.handleMobMoved(
+        game.states.gameplay->mobs.all, heldPtr
+    );
     heldPtr->face(leaPtr->angle + TAU / 2.0f, nullptr, true);
     leaPtr->release(heldPtr);
 }
@@ -4098,6 +4098,9 @@ void PikminFsm::releaseTool(ScriptVM* scriptVM, void* info1, void* info2) {
     }
     pikPtr->release(tooPtr);
     tooPtr->center = pikPtr->center;
+    game.states.gameplay->mobInteractionGrid.handleMobMoved(
+        game.states.gameplay->mobs.all, tooPtr
+    );
     tooPtr->speed = Point();
     tooPtr->pushAmount = 0.0f;
     pikPtr->subgroupTypePtr =
@@ -118,13 +118,16 @@ void Liquid::changeSectorsHazard(Hazard* hPtr) {
             sectorVertexes.insert(sPtr->edges[e]->vertexes[0]);
             sectorVertexes.insert(sPtr->edges[e]->vertexes[1]);
         }
+        RectCorners changedRegion;
         updateOffsetEffectCaches(
             game.liquidLimitEffectCaches,
             sectorVertexes,
             doesEdgeHaveLiquidLimit,
             getLiquidLimitLength,
-            getLiquidLimitColor
+            getLiquidLimitColor,
+            &changedRegion
         );
+        game.liquidLimitEffectTiles.markDirty(changedRegion);
     }
 }
 
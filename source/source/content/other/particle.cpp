@@ -9,6 +9,8 @@
  */
 
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
 
 #include "particle.hpp"
 
@@ -122,49 +124,6 @@ void Particle::setBitmap(
 }
 
 
-/**
- * @brief Ticks a particle's time by one frame of logic.
- *
- * @param deltaT How long the frame's tick is, in seconds.
- * @return Whether its lifespan is over (meaning it should be deleted).
- */
-void Particle::tick(const float deltaT) {
-    time -= deltaT;
-    
-    if(time <= 0.0f) {
-        time = 0.0f;
-        return;
-    }
-    
-    float t = 1.0f - time / duration;
-    
-    Point totalVelocity = linearSpeed.get(t);
-    float outwardsAngle = getAngle(center - origin);
-    
-    if(center == origin) {
-        outwardsAngle = game.rng.f(-180, 180);
-    }
-    totalVelocity +=
-        angleToCoordinates(outwardsAngle, outwardsSpeed.get(t));
-        
-    //Add 90 degrees to make the angle tangential.
-    totalVelocity +=
-        angleToCoordinates(outwardsAngle + (TAU / 4), orbitalSpeed.get(t));
-        
-    //Accumulate and apply friction.
-    totalVelocity -= totalFrictionApplied;
-    Point newFriction = totalVelocity * (deltaT * friction);
-    totalFrictionApplied += newFriction;
-    totalVelocity -= newFriction;
-    
-    center += totalVelocity * deltaT;
-    
-    if(bmpAngleType == PARTICLE_ANGLE_TYPE_DIRECTION) {
-        coordinatesToAngle(totalVelocity, &bmpAngle, nullptr);
-    }
-}
-
-
 #pragma endregion
 #pragma region Particle emission
 
@@ -299,7 +258,16 @@ void ParticleGenerator::emit(ParticleManager& manager) {
         );
         
     for(size_t p = 0; p < finalNr; p++) {
+        if(
+            maxParticles > 0 && budgetIdx != INVALID &&
+            manager.getBudgetUsage(budgetIdx) >= maxParticles
+        ) {
+            //This generator type already has as many particles as allowed.
+            break;
+        }
+        
         Particle newP = baseParticle;
+        if(maxParticles > 0) newP.budgetIdx = budgetIdx;
         
         newP.duration =
             std::max(
@@ -404,6 +372,7 @@ void ParticleGenerator::loadFromDataNode(
     
     eRS.set("interval_deviation", emission.intervalDeviation);
     eRS.set("number_deviation", emission.numberDeviation);
+    eRS.set("max_particles", maxParticles);
     eRS.set("shape", shapeInt);
     
     switch(shapeInt) {
@@ -522,6 +491,7 @@ void ParticleGenerator::saveToDataNode(DataNode* node) {
     
     eGW.write("number", emission.number);
     eGW.write("number_deviation", emission.numberDeviation);
+    eGW.write("max_particles", maxParticles);
     eGW.write("interval", emission.interval);
     eGW.write("interval_deviation", emission.intervalDeviation);
     eGW.write("shape", emission.shape);
@@ -648,63 +618,30 @@ void ParticleGenerator::tick(float deltaT, ParticleManager& manager) {
 ParticleManager::ParticleManager(size_t maxNr) :
     maxNr(maxNr) {
     
-    if(maxNr == 0) return;
-    particles = new Particle[maxNr];
+    particles.assign(maxNr, Particle());
+    times.assign(maxNr, 0.0f);
+    durations.assign(maxNr, 0.0f);
+    centerXs.assign(maxNr, 0.0f);
+    centerYs.assign(maxNr, 0.0f);
+    originXs.assign(maxNr, 0.0f);
+    originYs.assign(maxNr, 0.0f);
+    frictions.assign(maxNr, 0.0f);
+    frictionAppliedXs.assign(maxNr, 0.0f);
+    frictionAppliedYs.assign(maxNr, 0.0f);
+    linearSpeedXs.assign(maxNr, 0.0f);
+    linearSpeedYs.assign(maxNr, 0.0f);
+    outwardsSpeeds.assign(maxNr, 0.0f);
+    orbitalSpeeds.assign(maxNr, 0.0f);
+    fallbackDirXs.assign(maxNr, 0.0f);
+    fallbackDirYs.assign(maxNr, 0.0f);
+    velocityXs.assign(maxNr, 0.0f);
+    velocityYs.assign(maxNr, 0.0f);
+    prevInPriority.assign(maxNr, INVALID);
+    nextInPriority.assign(maxNr, INVALID);
     clear();
 }
 
 
-/**
- * @brief Constructs a new particle manager object by copying data from another.
- *
- * @param pm2 Particle manager to copy from.
- */
-ParticleManager::ParticleManager(const ParticleManager& pm2) :
-    count(pm2.count),
-    maxNr(pm2.maxNr) {
-    
-    particles = new Particle[maxNr];
-    for(size_t p = 0; p < count; p++) {
-        this->particles[p] = pm2.particles[p];
-    }
-}
-
-
-/**
- * @brief Copies a particle manager from another one.
- *
- * @param pm2 Particle manager to copy from.
- * @return The current object.
- */
-ParticleManager& ParticleManager::operator =(
-    const ParticleManager& pm2
-) {
-    if(this != &pm2) {
-        if(this->particles) {
-            delete[] this->particles;
-        }
-        this->particles = nullptr;
-        maxNr = pm2.maxNr;
-        count = pm2.count;
-        if(maxNr == 0) return *this;
-        this->particles = new Particle[maxNr];
-        for(size_t p = 0; p < count; p++) {
-            this->particles[p] = pm2.particles[p];
-        }
-    }
-    
-    return *this;
-}
-
-
-/**
- * @brief Destroys the particle manager object.
- */
-ParticleManager::~ParticleManager() {
-    if(particles) delete[] particles;
-}
-
-
 /**
  * @brief Adds an existing particle to the list.
  * It will fail if there is no slot where it can be added to.
@@ -716,17 +653,22 @@ void ParticleManager::addParticle(const Particle& p) {
     
     //The first "count" particles are alive. Add the new one after.
     //...Unless count already equals the max. That means the list is full.
-    //Let's try to dump a particle with lower priority.
-    //Starting from 0 will (hopefully) give us the oldest one first.
+    //Let's try to dump the oldest particle of the lowest priority possible.
     bool success = true;
     if(count == maxNr) {
         success = false;
-        for(size_t i = 0; i < maxNr; i++) {
-            if(particles[i].priority < p.priority) {
-                deleteParticle(i);
-                success = true;
-                break;
+        for(size_t pr = 0; pr < (size_t) p.priority; pr++) {
+            if(priorityHeads[pr] == INVALID) continue;
+            deleteParticle(priorityHeads[pr]);
+            success = true;
+            if(game.perfMon) {
+                game.perfMon->addToCounter(
+                    pr == PARTICLE_PRIORITY_LOW ?
+                    "Particle evictions (low priority)" :
+                    "Particle evictions (medium priority)"
+                );
             }
+            break;
         }
     }
     
@@ -734,7 +676,24 @@ void ParticleManager::addParticle(const Particle& p) {
     if(!success)
         return;
         
+    //Copy-assigning into a dead slot reuses its keyframe allocations.
     particles[count] = p;
+    times[count] = p.time;
+    durations[count] = p.duration;
+    centerXs[count] = p.center.x;
+    centerYs[count] = p.center.y;
+    originXs[count] = p.origin.x;
+    originYs[count] = p.origin.y;
+    frictions[count] = p.friction;
+    frictionAppliedXs[count] = p.totalFrictionApplied.x;
+    frictionAppliedYs[count] = p.totalFrictionApplied.y;
+    linkParticle(count);
+    if(p.budgetIdx != INVALID) {
+        if(budgetUsages.size() <= p.budgetIdx) {
+            budgetUsages.resize(p.budgetIdx + 1, 0);
+        }
+        budgetUsages[p.budgetIdx]++;
+    }
     count++;
 }
 
@@ -745,7 +704,13 @@ void ParticleManager::addParticle(const Particle& p) {
 void ParticleManager::clear() {
     for(size_t p = 0; p < maxNr; p++) {
         particles[p].time = 0.0f;
+        times[p] = 0.0f;
+    }
+    for(size_t pr = 0; pr < N_PARTICLE_PRIORITIES; pr++) {
+        priorityHeads[pr] = INVALID;
+        priorityTails[pr] = INVALID;
     }
+    budgetUsages.clear();
     count = 0;
 }
 
@@ -756,26 +721,60 @@ void ParticleManager::clear() {
  * @param slot Slot number in the list.
  */
 void ParticleManager::deleteParticle(size_t slot) {
-    if(slot > count) return;
+    if(slot >= count) return;
+    
+    unlinkParticle(slot);
+    if(particles[slot].budgetIdx != INVALID) {
+        budgetUsages[particles[slot].budgetIdx]--;
+    }
     
     //To delete a particle, let's simply move its data to the start of
     //the "dead" particles. A particle is considered dead if its time is 0.
     particles[slot].time = 0.0f;
+    times[slot] = 0.0f;
     
     //Because the first "count" members are alive, we'll swap this dead
     //particle with the last living one. This means this particle
     //will represent the new start of the dead ones.
     
-    //But hey, if we only had one particle, we can just skip this!
-    if(count == 1) {
-        count = 0;
+    //But hey, if it already is the last living one, we can just skip this!
+    size_t last = count - 1;
+    if(slot == last) {
+        count--;
         return;
     }
     
-    //Place the last live particle on this now-unused position.
-    particles[slot] = particles[count - 1];
+    //Place the last live particle on this now-unused position. Swapping
+    //instead of copying lets the dead slot keep its keyframe allocations
+    //for the next particle that gets added.
+    std::swap(particles[slot], particles[last]);
+    times[slot] = times[last];
+    durations[slot] = durations[last];
+    centerXs[slot] = centerXs[last];
+    centerYs[slot] = centerYs[last];
+    originXs[slot] = originXs[last];
+    originYs[slot] = originYs[last];
+    frictions[slot] = frictions[last];
+    frictionAppliedXs[slot] = frictionAppliedXs[last];
+    frictionAppliedYs[slot] = frictionAppliedYs[last];
+    
+    //Its neighbors in its priority list need to know where it went.
+    size_t priority = particles[slot].priority;
+    prevInPriority[slot] = prevInPriority[last];
+    nextInPriority[slot] = nextInPriority[last];
+    if(prevInPriority[slot] != INVALID) {
+        nextInPriority[prevInPriority[slot]] = slot;
+    } else {
+        priorityHeads[priority] = slot;
+    }
+    if(nextInPriority[slot] != INVALID) {
+        prevInPriority[nextInPriority[slot]] = slot;
+    } else {
+        priorityTails[priority] = slot;
+    }
+    
     //And this new "dead" particle should be marked as such.
-    particles[count - 1].time = 0.0f;
+    times[last] = 0.0f;
     
     count--;
 }
@@ -812,6 +811,19 @@ void ParticleManager::fillComponentList(
 }
 
 
+/**
+ * @brief Returns how many live particles count towards the given
+ * particle budget.
+ *
+ * @param budgetIdx Index of the budget.
+ * @return The amount.
+ */
+size_t ParticleManager::getBudgetUsage(size_t budgetIdx) const {
+    if(budgetIdx >= budgetUsages.size()) return 0;
+    return budgetUsages[budgetIdx];
+}
+
+
 /**
  * @brief Returns how many are in the list.
  *
@@ -822,15 +834,145 @@ size_t ParticleManager::getCount() const {
 }
 
 
+/**
+ * @brief Adds a particle to the end of its priority's list.
+ *
+ * @param slot Slot number in the list.
+ */
+void ParticleManager::linkParticle(size_t slot) {
+    size_t priority = particles[slot].priority;
+    prevInPriority[slot] = priorityTails[priority];
+    nextInPriority[slot] = INVALID;
+    if(priorityTails[priority] != INVALID) {
+        nextInPriority[priorityTails[priority]] = slot;
+    } else {
+        priorityHeads[priority] = slot;
+    }
+    priorityTails[priority] = slot;
+}
+
+
+/**
+ * @brief Moves all particles according to their speeds for this tick,
+ * which must already be in the speed arrays. Each particle goes through
+ * the exact same math, without any branching or function calls, so that
+ * the compiler can vectorize this.
+ *
+ * The outwards direction is the normalized vector from the origin to the
+ * center, and the orbital direction is that rotated by 90 degrees.
+ *
+ * @param deltaT How long the frame's tick is, in seconds.
+ */
+void ParticleManager::moveParticles(float deltaT) {
+    float* cxs = centerXs.data();
+    float* cys = centerYs.data();
+    const float* oxs = originXs.data();
+    const float* oys = originYs.data();
+    const float* frs = frictions.data();
+    float* faxs = frictionAppliedXs.data();
+    float* fays = frictionAppliedYs.data();
+    const float* lsxs = linearSpeedXs.data();
+    const float* lsys = linearSpeedYs.data();
+    const float* outs = outwardsSpeeds.data();
+    const float* orbs = orbitalSpeeds.data();
+    const float* fdxs = fallbackDirXs.data();
+    const float* fdys = fallbackDirYs.data();
+    float* vxs = velocityXs.data();
+    float* vys = velocityYs.data();
+    
+    //None of these arrays overlap, which the compiler needs to be told.
+    #pragma omp simd
+    for(size_t c = 0; c < count; c++) {
+        //If the particle is on its origin, dx and dy are 0, so the
+        //fallback direction is the only thing left.
+        float dx = cxs[c] - oxs[c];
+        float dy = cys[c] - oys[c];
+        float distSquared = dx * dx + dy * dy;
+        float invDist = 1.0f / sqrtf(distSquared + FLT_MIN);
+        float fallbackMult = distSquared == 0.0f ? 1.0f : 0.0f;
+        float dirX = dx * invDist + fdxs[c] * fallbackMult;
+        float dirY = dy * invDist + fdys[c] * fallbackMult;
+        
+        float vx = lsxs[c] + dirX * outs[c] - dirY * orbs[c];
+        float vy = lsys[c] + dirY * outs[c] + dirX * orbs[c];
+        
+        //Accumulate and apply friction.
+        vx -= faxs[c];
+        vy -= fays[c];
+        float newFrictionX = vx * (deltaT * frs[c]);
+        float newFrictionY = vy * (deltaT * frs[c]);
+        faxs[c] += newFrictionX;
+        fays[c] += newFrictionY;
+        vx -= newFrictionX;
+        vy -= newFrictionY;
+        
+        cxs[c] += vx * deltaT;
+        cys[c] += vy * deltaT;
+        vxs[c] = vx;
+        vys[c] = vy;
+    }
+}
+
+
 /**
  * @brief Ticks time of all particles in the list by one frame of logic.
  *
  * @param deltaT How long the frame's tick is, in seconds.
  */
 void ParticleManager::tickAll(float deltaT) {
+    //Advance time.
+    float* ts = times.data();
+    for(size_t c = 0; c < count; c++) {
+        ts[c] -= deltaT;
+    }
+    
+    //Get this tick's speeds. The keyframe interpolators and the
+    //random number generator can't be vectorized, so this is done
+    //one particle at a time.
+    for(size_t c = 0; c < count; c++) {
+        if(times[c] <= 0.0f) {
+            linearSpeedXs[c] = 0.0f;
+            linearSpeedYs[c] = 0.0f;
+            outwardsSpeeds[c] = 0.0f;
+            orbitalSpeeds[c] = 0.0f;
+            continue;
+        }
+        
+        Particle& p = particles[c];
+        float t = 1.0f - times[c] / durations[c];
+        Point linearSpeed = p.linearSpeed.get(t);
+        linearSpeedXs[c] = linearSpeed.x;
+        linearSpeedYs[c] = linearSpeed.y;
+        outwardsSpeeds[c] = p.outwardsSpeed.get(t);
+        orbitalSpeeds[c] = p.orbitalSpeed.get(t);
+        
+        if(centerXs[c] == originXs[c] && centerYs[c] == originYs[c]) {
+            float angle = game.rng.f(-180, 180);
+            fallbackDirXs[c] = cos(angle);
+            fallbackDirYs[c] = sin(angle);
+        }
+    }
+    
+    //Move them.
+    moveParticles(deltaT);
+    
+    //Copy the results back, for drawing.
+    for(size_t c = 0; c < count; c++) {
+        if(times[c] <= 0.0f) continue;
+        Particle& p = particles[c];
+        p.time = times[c];
+        p.center.x = centerXs[c];
+        p.center.y = centerYs[c];
+        if(p.bmpAngleType == PARTICLE_ANGLE_TYPE_DIRECTION) {
+            coordinatesToAngle(
+                Point(velocityXs[c], velocityYs[c]), &p.bmpAngle, nullptr
+            );
+        }
+    }
+    
+    //Delete the dead ones.
     for(size_t c = 0; c < count;) {
-        particles[c].tick(deltaT);
-        if(particles[c].time == 0.0f) {
+        if(times[c] <= 0.0f) {
             deleteParticle(c);
         } else {
             c++;
@@ -839,4 +981,28 @@ void ParticleManager::tickAll(float deltaT) {
 }
 
 
+/**
+ * @brief Removes a particle from its priority's list.
+ *
+ * @param slot Slot number in the list.
+ */
+void ParticleManager::unlinkParticle(size_t slot) {
+    size_t priority = particles[slot].priority;
+    size_t prev = prevInPriority[slot];
+    size_t next = nextInPriority[slot];
+    if(prev != INVALID) {
+        nextInPriority[prev] = next;
+    } else {
+        priorityHeads[priority] = next;
+    }
+    if(next != INVALID) {
+        prevInPriority[next] = prev;
+    } else {
+        priorityTails[priority] = prev;
+    }
+    prevInPriority[slot] = INVALID;
+    nextInPriority[slot] = INVALID;
+}
+
+
 #pragma endregion
@@ -47,6 +47,9 @@ enum PARTICLE_PRIORITY {
     //Mostly useful for things that are absolutely needed for gameplay clarity.
     PARTICLE_PRIORITY_HIGH,
     
+    //Total number.
+    N_PARTICLE_PRIORITIES,
+    
 };
 
 
@@ -243,6 +246,9 @@ struct Particle {
     //this particle if it can replace a lower-priority one.
     PARTICLE_PRIORITY priority = PARTICLE_PRIORITY_MEDIUM;
     
+    //Index of the particle budget it counts towards, if any. INVALID if none.
+    size_t budgetIdx = INVALID;
+    
     
     //--- Public function declarations ---
     
@@ -258,7 +264,6 @@ struct Particle {
         const string& newBmpName,
         DataNode* node = nullptr
     );
-    void tick(float deltaT);
     
 };
 
@@ -276,15 +281,13 @@ struct ParticleManager {
     
     //--- Public function declarations ---
     
-    explicit ParticleManager(size_t max_nr = 0);
-    ParticleManager(const ParticleManager& pm2);
-    ParticleManager& operator=(const ParticleManager& pm2);
-    ~ParticleManager();
+    explicit ParticleManager(size_t maxNr = 0);
     void addParticle(const Particle& p);
     void clear();
     void fillComponentList(
         vector<WorldComponent>& list, const RectCorners& camera = RectCorners()
     );
+    size_t getBudgetUsage(size_t budgetIdx) const;
     size_t getCount() const;
     void tickAll(float deltaT);
     
@@ -300,7 +303,9 @@ struct ParticleManager {
     //"dead" particle, to preserve the list's logic.
     //When a particle is added, if the entire list is filled with live ones,
     //delete the one on position 0 (presumably the oldest).
-    Particle* particles = nullptr;
+    //The state that changes every frame is kept in the arrays below instead,
+    //and only copied back to these after each tick, for drawing.
+    vector<Particle> particles;
     
     //How many particles are alive.
     size_t count = 0;
@@ -308,10 +313,87 @@ struct ParticleManager {
     //Maximum number that can be stored.
     size_t maxNr = 0;
     
+    //The following arrays have one entry per particle, in the same order
+    //as the list of particles. Keeping each property contiguous lets the
+    //compiler vectorize the movement logic.
+    
+    //Time left to live of each particle.
+    vector<float> times;
+    
+    //Total lifespan of each particle.
+    vector<float> durations;
+    
+    //X coordinate of each particle's center.
+    vector<float> centerXs;
+    
+    //Y coordinate of each particle's center.
+    vector<float> centerYs;
+    
+    //X coordinate of each particle's origin.
+    vector<float> originXs;
+    
+    //Y coordinate of each particle's origin.
+    vector<float> originYs;
+    
+    //Friction of each particle.
+    vector<float> frictions;
+    
+    //X component of each particle's total friction applied so far.
+    vector<float> frictionAppliedXs;
+    
+    //Y component of each particle's total friction applied so far.
+    vector<float> frictionAppliedYs;
+    
+    //X component of each particle's linear speed this tick.
+    vector<float> linearSpeedXs;
+    
+    //Y component of each particle's linear speed this tick.
+    vector<float> linearSpeedYs;
+    
+    //Outwards speed of each particle this tick.
+    vector<float> outwardsSpeeds;
+    
+    //Orbital speed of each particle this tick.
+    vector<float> orbitalSpeeds;
+    
+    //X component of the outwards direction to use this tick, if the particle
+    //is right on its origin and so has no outwards direction of its own.
+    vector<float> fallbackDirXs;
+    
+    //Y component of the outwards direction to use this tick, if the particle
+    //is right on its origin and so has no outwards direction of its own.
+    vector<float> fallbackDirYs;
+    
+    //X component of each particle's final velocity this tick.
+    vector<float> velocityXs;
+    
+    //Y component of each particle's final velocity this tick.
+    vector<float> velocityYs;
+    
+    //Live particles of each priority are chained in a list, from the oldest
+    //to the newest, so the best one to evict can be found right away.
+    //These have the previous particle in each one's list. INVALID if none.
+    vector<size_t> prevInPriority;
+    
+    //Next particle in each one's priority list. INVALID if none.
+    vector<size_t> nextInPriority;
+    
+    //Oldest live particle of each priority. INVALID if none.
+    size_t priorityHeads[N_PARTICLE_PRIORITIES];
+    
+    //Newest live particle of each priority. INVALID if none.
+    size_t priorityTails[N_PARTICLE_PRIORITIES];
+    
+    //How many live particles count towards each particle budget.
+    vector<size_t> budgetUsages;
+    
     
     //--- Private function declarations ---
     
     void deleteParticle(size_t slot);
+    void linkParticle(size_t slot);
+    void moveParticles(float deltaT);
+    void unlinkParticle(size_t slot);
     
 };
 
@@ -375,6 +457,14 @@ struct ParticleGenerator : public Content {
     //Are the directions and angles provided absolute, or relative (to a mob)?
     bool anglesAreAbsolute = false;
     
+    //Maximum number of particles from this generator, and any copies of it,
+    //that can exist at once. 0 for no limit.
+    size_t maxParticles = 0;
+    
+    //Index of the particle budget that this generator's particles count
+    //towards. Only used if there's a maximum number of particles.
+    size_t budgetIdx = INVALID;
+    
     
     //--- Public function declarations ---
     
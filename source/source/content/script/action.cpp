@@ -15,6 +15,32 @@
 #include "script_utils.hpp"
 
 
+#pragma endregion
+#pragma region Script action argument
+
+
+/**
+ * @brief Constructs a new script action argument object.
+ *
+ * @param text Text of the argument, or the variable's name.
+ * @param isVar Whether it's the name of a variable.
+ */
+ScriptActionArg::ScriptActionArg(const string& text, bool isVar) :
+    text(text),
+    isVar(isVar) {
+    
+    if(isVar) {
+        varId = game.scriptVarNames.getId(text);
+    } else {
+        floatValue = s2f(text);
+        intValue = s2i(text);
+        boolValue = s2b(text);
+        numberValue = s2f(text);
+        isNumeric = isNumber(text);
+    }
+}
+
+
 #pragma endregion
 #pragma region Script action definition
 
@@ -203,16 +229,25 @@ bool ScriptActionDef::loadFromDataNode(
             }
         }
         
-        args.push_back(words[w]);
-        argIsVar.push_back(isVar);
+        args.push_back(ScriptActionArg(words[w], isVar));
+        if(
+            !isVar && !words[w].empty() &&
+            hasFlag(
+                actionType->parameters[paramIdx].flags,
+                COMMAND_PARAM_FLAG_VAR_NAME
+            )
+        ) {
+            //Resolve the variable it names now, instead of every time
+            //the action runs.
+            args.back().varId = game.scriptVarNames.getId(words[w]);
+        }
     }
     
     //Check if any optional parameters were left out.
     while(words.size() < nFixedParams) {
         size_t paramIdx = words.size();
         words.push_back(actionType->parameters[paramIdx].defValue);
-        args.push_back(words.back());
-        argIsVar.push_back(false);
+        args.push_back(ScriptActionArg(words.back()));
     }
     
     return true;
@@ -236,16 +271,10 @@ bool ScriptActionDef::run(
         return false;
     }
     
+    //The arguments are read straight from this definition, or from the
+    //variables, by the action's code. Only variables read as strings
+    //get copied, into reused scratch strings.
     ScriptActionInstRunData data(scriptVM, this);
-    
-    //Fill the arguments. Fetch values from variables if needed.
-    data.args = args;
-    forIdx(a, args) {
-        if(argIsVar[a]) {
-            data.args[a].clear();
-            scriptVM->vars.getValue(args[a], data.args[a]);
-        }
-    }
     data.customData1 = customData1;
     data.customData2 = customData2;
     
@@ -259,7 +288,6 @@ bool ScriptActionDef::run(
  */
 void ScriptActionDef::unload() {
     args.clear();
-    argIsVar.clear();
 }
 
 
@@ -471,7 +499,7 @@ bool ScriptActionListDef::compile(DataNode* dn) {
     set<string> labels;
     forIdx(a, list) {
         if(list[a]->actionType->type == SCRIPT_ACTION_LABEL) {
-            const string& name = list[a]->args[0];
+            const string& name = list[a]->args[0].text;
             if(isInContainer(labels, name)) {
                 game.errors.report(
                     "There are multiple labels called \"" + name + "\"!", dn
@@ -483,7 +511,7 @@ bool ScriptActionListDef::compile(DataNode* dn) {
     }
     forIdx(a, list) {
         if(list[a]->actionType->type == SCRIPT_ACTION_GOTO) {
-            const string& name = list[a]->args[0];
+            const string& name = list[a]->args[0].text;
             if(!isInContainer(labels, name)) {
                 game.errors.report(
                     "There is no label called \"" + name + "\", even though "
@@ -1005,7 +1033,7 @@ size_t ScriptActionListDef::processActionJumpToLabel(
         forIdx(a2, list) {
             SCRIPT_ACTION a2Type = list[a2]->actionType->type;
             if(a2Type == SCRIPT_ACTION_LABEL) {
-                if(curAction->args[0] == list[a2]->args[0]) {
+                if(curAction->args[0].text == list[a2]->args[0].text) {
                     return a2 + 1;
                 }
             }
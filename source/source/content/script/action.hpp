@@ -38,6 +38,48 @@ class ScriptVM;
 typedef void (*ScriptActionCustomCode)(ScriptVM* vm, void* info1, void* info2);
 
 
+/**
+ * @brief An argument used in a call to a script action. If it's a constant,
+ * its value is parsed once when the script is loaded, so that actions don't
+ * need to parse it every time they run.
+ */
+struct ScriptActionArg {
+
+    //--- Public members ---
+    
+    //Text of the argument. If it's a variable, this is the variable's name.
+    string text;
+    
+    //Is it the name of a variable, whose value is only known at run-time?
+    bool isVar = false;
+    
+    //ID of the name of the variable it refers to, if it's a variable, or if
+    //it's a constant used as a variable name. INVALID otherwise.
+    size_t varId = INVALID;
+    
+    //If it's a constant, this is its value as a float.
+    float floatValue = 0.0f;
+    
+    //If it's a constant, this is its value as an integer.
+    int intValue = 0;
+    
+    //If it's a constant, this is its value as a boolean.
+    bool boolValue = false;
+    
+    //If it's a constant, this is its value as a number, like s2f gives.
+    double numberValue = 0.0;
+    
+    //If it's a constant, this is whether its text is a number.
+    bool isNumeric = false;
+    
+    
+    //--- Public function declarations ---
+    
+    explicit ScriptActionArg(const string& text = "", bool isVar = false);
+    
+};
+
+
 /**
  * @brief Definition of a specific call to a script action
  * in the script.
@@ -55,10 +97,7 @@ public:
     ScriptActionCustomCode customCode = nullptr;
     
     //List of arguments to use.
-    vector<string> args;
-    
-    //List of which arguments are variable names.
-    vector<bool> argIsVar;
+    vector<ScriptActionArg> args;
     
     //Event the action belongs to, if any.
     FSM_EV parentEvent = FSM_EV_UNKNOWN;
@@ -182,9 +221,6 @@ struct ScriptActionInstRunData {
     //Action definition information.
     ScriptActionDef* actionDef = nullptr;
     
-    //Arguments used.
-    vector<string> args;
-    
     //Event custom data 1.
     void* customData1 = nullptr;
     
@@ -198,5 +234,23 @@ struct ScriptActionInstRunData {
     //--- Public function declarations ---
     
     ScriptActionInstRunData(ScriptVM* scriptVM, ScriptActionDef* call);
+    ~ScriptActionInstRunData();
+    size_t getNrArgs() const;
+    const string& getArg(size_t idx) const;
+    bool getArgBool(size_t idx) const;
+    float getArgFloat(size_t idx) const;
+    int getArgInt(size_t idx) const;
+    bool getArgNumber(size_t idx, double& dest) const;
+    string getArgTail(size_t startIdx) const;
+    size_t getArgVarId(size_t idx) const;
+    
+    
+    private:
+    
+    //--- Private members ---
+    
+    //Index of the first of this action's strings in the script execution
+    //auxiliary data's argument scratch strings. INVALID if it has none yet.
+    mutable size_t argStrsStart = INVALID;
     
 };
@@ -42,6 +42,157 @@ ScriptActionInstRunData::ScriptActionInstRunData(
 }
 
 
+/**
+ * @brief Destroys the script action run data object.
+ */
+ScriptActionInstRunData::~ScriptActionInstRunData() {
+    if(argStrsStart == INVALID) return;
+    //Actions run inside one another, so give the scratch strings back
+    //in the same way.
+    game.scriptExecAuxData.nArgStrsInUse = argStrsStart;
+}
+
+
+/**
+ * @brief Returns the value of an argument, as a string. If the argument is a
+ * variable, this is the variable's current value, or an empty string if
+ * it doesn't exist. The reference is valid until the same argument is
+ * read again, or until this object is destroyed.
+ *
+ * @param idx Index of the argument.
+ * @return The value.
+ */
+const string& ScriptActionInstRunData::getArg(size_t idx) const {
+    const ScriptActionArg& arg = actionDef->args[idx];
+    if(!arg.isVar) return arg.text;
+    
+    //Keep a copy here, since the variable's storage can move if an action
+    //creates a new variable while the value is still being used.
+    //The copy goes into a scratch string that's reused between actions,
+    //so this doesn't need to allocate memory each time.
+    ScriptExecutionAuxData& auxData = game.scriptExecAuxData;
+    if(argStrsStart == INVALID) {
+        argStrsStart = auxData.nArgStrsInUse;
+        auxData.nArgStrsInUse += actionDef->args.size();
+        if(auxData.argStrs.size() < auxData.nArgStrsInUse) {
+            auxData.argStrs.resize(auxData.nArgStrsInUse);
+        }
+    }
+    string& value = auxData.argStrs[argStrsStart + idx];
+    value.clear();
+    scriptVM->vars.getValue(arg.varId, value);
+    return value;
+}
+
+
+/**
+ * @brief Returns the value of an argument, as a boolean.
+ *
+ * @param idx Index of the argument.
+ * @return The value.
+ */
+bool ScriptActionInstRunData::getArgBool(size_t idx) const {
+    const ScriptActionArg& arg = actionDef->args[idx];
+    if(!arg.isVar) return arg.boolValue;
+    bool value = false;
+    scriptVM->vars.getValue(arg.varId, value);
+    return value;
+}
+
+
+/**
+ * @brief Returns the value of an argument, as a float.
+ *
+ * @param idx Index of the argument.
+ * @return The value.
+ */
+float ScriptActionInstRunData::getArgFloat(size_t idx) const {
+    const ScriptActionArg& arg = actionDef->args[idx];
+    if(!arg.isVar) return arg.floatValue;
+    float value = 0.0f;
+    scriptVM->vars.getValue(arg.varId, value);
+    return value;
+}
+
+
+/**
+ * @brief Returns the value of an argument, as an integer.
+ *
+ * @param idx Index of the argument.
+ * @return The value.
+ */
+int ScriptActionInstRunData::getArgInt(size_t idx) const {
+    const ScriptActionArg& arg = actionDef->args[idx];
+    if(!arg.isVar) return arg.intValue;
+    int value = 0;
+    scriptVM->vars.getValue(arg.varId, value);
+    return value;
+}
+
+
+/**
+ * @brief Returns the value of an argument as a number, if it is one.
+ * This gives the same results as checking the argument's string value with
+ * isNumber and converting it with s2f, but numeric variables skip
+ * the string.
+ *
+ * @param idx Index of the argument.
+ * @param dest Destination for the value. This is set even if it's not
+ * a number, with what s2f would return.
+ * @return Whether it is a number.
+ */
+bool ScriptActionInstRunData::getArgNumber(size_t idx, double& dest) const {
+    const ScriptActionArg& arg = actionDef->args[idx];
+    if(!arg.isVar) {
+        dest = arg.numberValue;
+        return arg.isNumeric;
+    }
+    return scriptVM->vars.getNumber(arg.varId, dest);
+}
+
+
+/**
+ * @brief Returns the values of all arguments from a given index onward,
+ * separated by spaces.
+ *
+ * @param startIdx Index of the first argument to include.
+ * @return The values.
+ */
+string ScriptActionInstRunData::getArgTail(size_t startIdx) const {
+    string result;
+    for(size_t a = startIdx; a < actionDef->args.size(); a++) {
+        if(a > startIdx) result += " ";
+        result += getArg(a);
+    }
+    return result;
+}
+
+
+/**
+ * @brief Returns the ID of the name of the variable that an argument refers
+ * to. This is meant for arguments that are variable names. If the name
+ * was already known when the script was loaded, it's returned right away.
+ *
+ * @param idx Index of the argument.
+ * @return The ID.
+ */
+size_t ScriptActionInstRunData::getArgVarId(size_t idx) const {
+    const ScriptActionArg& arg = actionDef->args[idx];
+    if(!arg.isVar && arg.varId != INVALID) return arg.varId;
+    return game.scriptVarNames.getId(getArg(idx));
+}
+
+
+/**
+ * @brief Returns the number of arguments in the call.
+ *
+ * @return The number.
+ */
+size_t ScriptActionInstRunData::getNrArgs() const {
+    return actionDef->args.size();
+}
+
+
 #pragma endregion
 #pragma region Action runner functions
 
@@ -53,11 +204,11 @@ ScriptActionInstRunData::ScriptActionInstRunData(
  */
 void ScriptActionRunners::absoluteNumber(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& numberArg = data.args[1];
+    size_t destVarArg = data.getArgVarId(0);
+    float numberArg = data.getArgFloat(1);
     
     //Main logic.
-    float result = fabs(s2f(numberArg));
+    float result = fabs(numberArg);
     
     //Store the result.
     data.scriptVM->getRunnerScriptVM()->vars.setValue(destVarArg, result);
@@ -71,10 +222,10 @@ void ScriptActionRunners::absoluteNumber(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::addHealth(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& healthArg = data.args[0];
+    float healthArg = data.getArgFloat(0);
     
     //Main logic.
-    data.scriptVM->getRunnerMob()->setHealth(true, false, s2f(healthArg));
+    data.scriptVM->getRunnerMob()->setHealth(true, false, healthArg);
 }
 
 
@@ -85,11 +236,11 @@ void ScriptActionRunners::addHealth(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::addListItem(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& listArg = data.args[1];
-    const string& newItemArg = data.args[2];
-    const string& numberArg = data.args[3];
-    const string& delArg = data.args[4];
+    size_t destVarArg = data.getArgVarId(0);
+    const string& listArg = data.getArg(1);
+    const string& newItemArg = data.getArg(2);
+    int numberArg = data.getArgInt(3);
+    const string& delArg = data.getArg(4);
     
     //Main logic.
     bool delFound;
@@ -106,7 +257,7 @@ void ScriptActionRunners::addListItem(ScriptActionInstRunData& data) {
     
     string delChar = enumGetName(scriptActionListDelimiterChars, delType);
     vector<string> items = split(listArg, delChar, true);
-    int idx = s2i(numberArg) - 1;
+    int idx = numberArg - 1;
     if(!isIdxValid(idx, items)) idx = items.size();
     
     items.insert(items.begin() + idx, newItemArg);
@@ -124,14 +275,14 @@ void ScriptActionRunners::addListItem(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::addToString(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& baseStrArg = data.args[1];
-    const string& newContentArg = data.args[2];
-    const string& addSpaceArg = data.args[3];
+    size_t destVarArg = data.getArgVarId(0);
+    const string& baseStrArg = data.getArg(1);
+    const string& newContentArg = data.getArg(2);
+    bool addSpaceArg = data.getArgBool(3);
     
     //Main logic.
     string result = baseStrArg;
-    if(s2b(addSpaceArg)) result += " ";
+    if(addSpaceArg) result += " ";
     result += newContentArg;
     
     //Store the result.
@@ -146,7 +297,7 @@ void ScriptActionRunners::addToString(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::arachnorbPlanLogic(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& typeArg = data.args[0];
+    const string& typeArg = data.getArg(0);
     
     //Main logic.
     bool typeFound;
@@ -190,10 +341,10 @@ void ScriptActionRunners::beChomped(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::calculate(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& lhsArg = data.args[1];
-    const string& opArg = data.args[2];
-    const string& rhsArg = data.args[3];
+    size_t destVarArg = data.getArgVarId(0);
+    float lhsArg = data.getArgFloat(1);
+    const string& opArg = data.getArg(2);
+    float rhsArg = data.getArgFloat(3);
     
     //Main logic.
     bool opFound;
@@ -208,8 +359,8 @@ void ScriptActionRunners::calculate(ScriptActionInstRunData& data) {
         return;
     }
     
-    float lhs = s2f(lhsArg);
-    float rhs = s2f(rhsArg);
+    float lhs = lhsArg;
+    float rhs = rhsArg;
     float result = 0;
     
     switch(op) {
@@ -260,11 +411,11 @@ void ScriptActionRunners::calculate(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::ceilNumber(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& numberArg = data.args[1];
+    size_t destVarArg = data.getArgVarId(0);
+    float numberArg = data.getArgFloat(1);
     
     //Main logic.
-    float result = ceil(s2f(numberArg));
+    float result = ceil(numberArg);
     
     //Store the result.
     data.scriptVM->getRunnerScriptVM()->vars.setValue(destVarArg, result);
@@ -278,16 +429,16 @@ void ScriptActionRunners::ceilNumber(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::clampNumber(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& numberArg = data.args[1];
-    const string& lowerArg = data.args[2];
-    const string& upperArg = data.args[3];
+    size_t destVarArg = data.getArgVarId(0);
+    float numberArg = data.getArgFloat(1);
+    float lowerArg = data.getArgFloat(2);
+    float upperArg = data.getArgFloat(3);
     
     //Main logic.
-    float lower = s2f(lowerArg);
-    float upper = s2f(upperArg);
+    float lower = lowerArg;
+    float upper = upperArg;
     if(lower > upper) std::swap(lower, upper);
-    float result = std::clamp((float) s2f(numberArg), lower, upper);
+    float result = std::clamp(numberArg, lower, upper);
     
     //Store the result.
     data.scriptVM->getRunnerScriptVM()->vars.setValue(destVarArg, result);
@@ -301,7 +452,7 @@ void ScriptActionRunners::clampNumber(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::clearVar(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& varArg = data.args[0];
+    size_t varArg = data.getArgVarId(0);
     
     //Main logic.
     if(data.scriptVM->getRunnerScriptVM()->vars.contains(varArg)) {
@@ -343,9 +494,9 @@ void ScriptActionRunners::drainLiquid(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::easeNumber(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& numberArg = data.args[1];
-    const string& methodArg = data.args[2];
+    size_t destVarArg = data.getArgVarId(0);
+    float numberArg = data.getArgFloat(1);
+    const string& methodArg = data.getArg(2);
     
     //Main logic.
     bool methodFound;
@@ -360,7 +511,7 @@ void ScriptActionRunners::easeNumber(ScriptActionInstRunData& data) {
         return;
     }
     
-    float result = ease(s2f(numberArg), method);
+    float result = ease(numberArg, method);
     
     //Store the result.
     data.scriptVM->getRunnerScriptVM()->vars.setValue(destVarArg, result);
@@ -374,9 +525,7 @@ void ScriptActionRunners::easeNumber(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::endDoWhile(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& lhsArg = data.args[0];
-    const string& opArg = data.args[1];
-    string rhsArg = vectorTailToString(data.args, 2);
+    const string& opArg = data.getArg(1);
     
     //Main logic.
     bool opFound;
@@ -390,7 +539,7 @@ void ScriptActionRunners::endDoWhile(ScriptActionInstRunData& data) {
         return;
     }
     
-    bool result = ScriptActionUtils::doScriptCondition(lhsArg, op, rhsArg);
+    bool result = ScriptActionUtils::doScriptArgCondition(data, 0, op, 2);
     
     //Store the result.
     data.returnValue = result;
@@ -415,11 +564,11 @@ void ScriptActionRunners::finishDying(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::floorNumber(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& numberArg = data.args[1];
+    size_t destVarArg = data.getArgVarId(0);
+    float numberArg = data.getArgFloat(1);
     
     //Main logic.
-    float result = floor(s2f(numberArg));
+    float result = floor(numberArg);
     
     //Store the result.
     data.scriptVM->getRunnerScriptVM()->vars.setValue(destVarArg, result);
@@ -433,7 +582,7 @@ void ScriptActionRunners::floorNumber(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::focus(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& targetTypeArg = data.args[0];
+    const string& targetTypeArg = data.getArg(0);
     
     //Main logic.
     SCRIPT_ACTION_MOB_TARGET_TYPE targetType =
@@ -452,10 +601,10 @@ void ScriptActionRunners::focus(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::focusOnId(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& idArg = data.args[0];
+    int idArg = data.getArgInt(0);
     
     //Main logic.
-    Mob* target = game.states.gameplay->getMobById(s2i(idArg));
+    Mob* target = game.states.gameplay->getMobById(idArg);
     
     if(!target) return;
     data.scriptVM->getRunnerScriptVM()->focusOnMob(target);
@@ -469,8 +618,8 @@ void ScriptActionRunners::focusOnId(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::followMobAsLeader(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& targetTypeArg = data.args[0];
-    const string& silentArg = data.args[1];
+    const string& targetTypeArg = data.getArg(0);
+    bool silentArg = data.getArgBool(1);
     
     //Main logic.
     SCRIPT_ACTION_MOB_TARGET_TYPE targetType =
@@ -481,7 +630,7 @@ void ScriptActionRunners::followMobAsLeader(ScriptActionInstRunData& data) {
     if(target->health <= 0.0f) return;
     
     data.scriptVM->getRunnerMob()->leaveGroup();
-    bool silent = s2b(silentArg);
+    bool silent = silentArg;
     
     if(
         data.scriptVM->getRunnerMob()->type->category->id ==
@@ -503,7 +652,7 @@ void ScriptActionRunners::followMobAsLeader(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::followPathRandomly(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& labelArg = data.args[0];
+    const string& labelArg = data.getArg(0);
     
     //Main logic.
     //We need to decide what the final stop is going to be.
@@ -568,13 +717,13 @@ void ScriptActionRunners::followPathRandomly(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::followPathToAbsolute(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& xArg = data.args[0];
-    const string& yArg = data.args[1];
-    const string& labelArg = data.args[2];
+    float xArg = data.getArgFloat(0);
+    float yArg = data.getArgFloat(1);
+    const string& labelArg = data.getArg(2);
     
     //Main logic.
-    float x = s2f(xArg);
-    float y = s2f(yArg);
+    float x = xArg;
+    float y = yArg;
     
     PathFollowSettings settings;
     settings.targetPoint = Point(x, y);
@@ -596,14 +745,15 @@ void ScriptActionRunners::followPathToAbsolute(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::forAction(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& iteratorVarArg = data.args[0];
-    const string& targetArg = data.args[1];
-    const string& startingValueArg = data.args[2];
-    const string& jumpArg = data.args[3];
+    size_t iteratorVarArg = data.getArgVarId(0);
+    double targetArg = 0.0;
+    data.getArgNumber(1, targetArg);
+    int startingValueArg = data.getArgInt(2);
+    int jumpArg = data.getArgInt(3);
     
     //Main logic.
-    int startingValue = s2i(startingValueArg);
-    int jump = s2i(jumpArg);
+    int startingValue = startingValueArg;
+    int jump = jumpArg;
     
     int iterator = startingValue;
     data.scriptVM->getRunnerScriptVM()->vars.getValue(iteratorVarArg, iterator);
@@ -616,8 +766,8 @@ void ScriptActionRunners::forAction(ScriptActionInstRunData& data) {
     data.scriptVM->getRunnerScriptVM()->vars.setValue(iteratorVarArg, iterator);
     
     bool result =
-        ScriptActionUtils::doScriptCondition(
-            i2s(iterator),
+        ScriptActionUtils::doScriptNumberCondition(
+            iterator,
             jump >= 0 ?
             SCRIPT_ACTION_IF_OP_LESS_E :
             SCRIPT_ACTION_IF_OP_MORE_E,
@@ -636,10 +786,10 @@ void ScriptActionRunners::forAction(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::forEach(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& iteratorVarArg = data.args[0];
-    const string& itemVarArg = data.args[1];
-    const string& listArg = data.args[2];
-    const string& delArg = data.args[3];
+    size_t iteratorVarArg = data.getArgVarId(0);
+    size_t itemVarArg = data.getArgVarId(1);
+    const string& listArg = data.getArg(2);
+    const string& delArg = data.getArg(3);
     
     //Main logic.
     bool delFound;
@@ -690,15 +840,15 @@ void ScriptActionRunners::forEach(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::getAngle(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& xArg = data.args[1];
-    const string& yArg = data.args[2];
-    const string& focusXArg = data.args[3];
-    const string& focusYArg = data.args[4];
+    size_t destVarArg = data.getArgVarId(0);
+    float xArg = data.getArgFloat(1);
+    float yArg = data.getArgFloat(2);
+    float focusXArg = data.getArgFloat(3);
+    float focusYArg = data.getArgFloat(4);
     
     //Main logic.
-    Point center(s2f(xArg), s2f(yArg));
-    Point focus(s2f(focusXArg), s2f(focusYArg));
+    Point center(xArg, yArg);
+    Point focus(focusXArg, focusYArg);
     float angle = getAngle(center, focus);
     angle = radToDeg(angle);
     
@@ -714,13 +864,13 @@ void ScriptActionRunners::getAngle(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::getAngleCwDiff(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& angle1Arg = data.args[1];
-    const string& angle2Arg = data.args[2];
+    size_t destVarArg = data.getArgVarId(0);
+    float angle1Arg = data.getArgFloat(1);
+    float angle2Arg = data.getArgFloat(2);
     
     //Main logic.
-    float angle1 = degToRad(s2f(angle1Arg));
-    float angle2 = degToRad(s2f(angle2Arg));
+    float angle1 = degToRad(angle1Arg);
+    float angle2 = degToRad(angle2Arg);
     float diff = ::getAngleCwDiff(angle1, angle2);
     diff = radToDeg(diff);
     
@@ -736,13 +886,13 @@ void ScriptActionRunners::getAngleCwDiff(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::getAngleSmallestDiff(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& angle1Arg = data.args[1];
-    const string& angle2Arg = data.args[2];
+    size_t destVarArg = data.getArgVarId(0);
+    float angle1Arg = data.getArgFloat(1);
+    float angle2Arg = data.getArgFloat(2);
     
     //Main logic.
-    float angle1 = degToRad(s2f(angle1Arg));
-    float angle2 = degToRad(s2f(angle2Arg));
+    float angle1 = degToRad(angle1Arg);
+    float angle2 = degToRad(angle2Arg);
     float diff = ::getAngleSmallestDiff(angle1, angle2);
     diff = radToDeg(diff);
     
@@ -759,8 +909,8 @@ void ScriptActionRunners::getAngleSmallestDiff(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::getAreaInfo(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& typeArg = data.args[1];
+    size_t destVarArg = data.getArgVarId(0);
+    const string& typeArg = data.getArg(1);
     
     //Main logic.
     string result;
@@ -803,15 +953,15 @@ void ScriptActionRunners::getCoordinatesFromAngle(
     ScriptActionInstRunData& data
 ) {
     //Get the arguments.
-    const string& xDestVarArg = data.args[0];
-    const string& yDestVarArg = data.args[1];
-    const string& angleArg = data.args[2];
-    const string& magnitudeArg = data.args[3];
+    size_t xDestVarArg = data.getArgVarId(0);
+    size_t yDestVarArg = data.getArgVarId(1);
+    float angleArg = data.getArgFloat(2);
+    float magnitudeArg = data.getArgFloat(3);
     
     //Main logic.
-    float angle = s2f(angleArg);
+    float angle = angleArg;
     angle = degToRad(angle);
-    float magnitude = s2f(magnitudeArg);
+    float magnitude = magnitudeArg;
     Point p = angleToCoordinates(angle, magnitude);
     
     //Store the result.
@@ -827,17 +977,17 @@ void ScriptActionRunners::getCoordinatesFromAngle(
  */
 void ScriptActionRunners::getDistance(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& centerXArg = data.args[1];
-    const string& centerYArg = data.args[2];
-    const string& focusXArg = data.args[3];
-    const string& focusYArg = data.args[4];
+    size_t destVarArg = data.getArgVarId(0);
+    float centerXArg = data.getArgFloat(1);
+    float centerYArg = data.getArgFloat(2);
+    float focusXArg = data.getArgFloat(3);
+    float focusYArg = data.getArgFloat(4);
     
     //Main logic.
-    float centerX = s2f(centerXArg);
-    float centerY = s2f(centerYArg);
-    float focusX = s2f(focusXArg);
-    float focusY = s2f(focusYArg);
+    float centerX = centerXArg;
+    float centerY = centerYArg;
+    float focusX = focusXArg;
+    float focusY = focusYArg;
     float dist =
         Distance(Point(centerX, centerY), Point(focusX, focusY)).toFloat();
         
@@ -853,8 +1003,8 @@ void ScriptActionRunners::getDistance(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::getEventInfo(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& typeArg = data.args[1];
+    size_t destVarArg = data.getArgVarId(0);
+    const string& typeArg = data.getArg(1);
     
     //Main logic.
     string result;
@@ -975,12 +1125,12 @@ void ScriptActionRunners::getEventInfo(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::getFloorZ(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& xArg = data.args[1];
-    const string& yArg = data.args[2];
+    size_t destVarArg = data.getArgVarId(0);
+    float xArg = data.getArgFloat(1);
+    float yArg = data.getArgFloat(2);
     
     //Main logic.
-    Point p(s2f(xArg), s2f(yArg));
+    Point p(xArg, yArg);
     Sector* s = getSector(p, nullptr, true);
     float result = s ? s->floorZ : 0.0f;
     
@@ -996,8 +1146,8 @@ void ScriptActionRunners::getFloorZ(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::getFocusVar(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& focusVarArg = data.args[1];
+    size_t destVarArg = data.getArgVarId(0);
+    size_t focusVarArg = data.getArgVarId(1);
     
     //Main logic.
     if(!data.scriptVM->getRunnerScriptVM()->focusedMob) return;
@@ -1018,9 +1168,9 @@ void ScriptActionRunners::getFocusVar(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::getLeaderPikminCount(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& targetArg = data.args[1];
-    const string& typeArg = data.args[2];
+    size_t destVarArg = data.getArgVarId(0);
+    const string& targetArg = data.getArg(1);
+    const string& typeArg = data.getArg(2);
     
     //Main logic.
     SCRIPT_ACTION_MOB_TARGET_TYPE targetType =
@@ -1050,10 +1200,10 @@ void ScriptActionRunners::getLeaderPikminCount(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::getListItem(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& listArg = data.args[1];
-    const string& numberArg = data.args[2];
-    const string& delArg = data.args[3];
+    size_t destVarArg = data.getArgVarId(0);
+    const string& listArg = data.getArg(1);
+    int numberArg = data.getArgInt(2);
+    const string& delArg = data.getArg(3);
     
     //Main logic.
     bool delFound;
@@ -1070,7 +1220,7 @@ void ScriptActionRunners::getListItem(ScriptActionInstRunData& data) {
     
     string delChar = enumGetName(scriptActionListDelimiterChars, delType);
     vector<string> items = split(listArg, delChar, true);
-    int idx = s2i(numberArg) - 1;
+    int idx = numberArg - 1;
     if(!isIdxValid(idx, items)) idx = items.size() - 1;
     string item;
     
@@ -1090,10 +1240,10 @@ void ScriptActionRunners::getListItem(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::getListItemNumber(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& listArg = data.args[1];
-    const string& itemArg = data.args[2];
-    const string& delArg = data.args[3];
+    size_t destVarArg = data.getArgVarId(0);
+    const string& listArg = data.getArg(1);
+    const string& itemArg = data.getArg(2);
+    const string& delArg = data.getArg(3);
     
     //Main logic.
     bool delFound;
@@ -1131,9 +1281,9 @@ void ScriptActionRunners::getListItemNumber(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::getListSize(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& listArg = data.args[1];
-    const string& delArg = data.args[2];
+    size_t destVarArg = data.getArgVarId(0);
+    const string& listArg = data.getArg(1);
+    const string& delArg = data.getArg(2);
     
     //Main logic.
     bool delFound;
@@ -1163,8 +1313,8 @@ void ScriptActionRunners::getListSize(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::getMiscInfo(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& typeArg = data.args[1];
+    size_t destVarArg = data.getArgVarId(0);
+    const string& typeArg = data.getArg(1);
     
     //Main logic.
     string result;
@@ -1226,10 +1376,10 @@ void ScriptActionRunners::getMiscInfo(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::getMissionMetric(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& metricArg = data.args[1];
-    const string& numberArg = data.args[2];
-    const string& getAutoTargetArg = data.args[3];
+    size_t destVarArg = data.getArgVarId(0);
+    const string& metricArg = data.getArg(1);
+    int numberArg = data.getArgInt(2);
+    bool getAutoTargetArg = data.getArgBool(3);
     
     //Main logic.
     if(game.curArea->type != AREA_TYPE_MISSION) {
@@ -1249,9 +1399,9 @@ void ScriptActionRunners::getMissionMetric(ScriptActionInstRunData& data) {
     }
     
     MissionMetricType* metricTypePtr = game.missionMetricTypes[metric];
-    size_t indexParam = s2i(numberArg) - 1;
+    size_t indexParam = numberArg - 1;
     
-    if(s2b(getAutoTargetArg)) {
+    if(getAutoTargetArg) {
         result = i2s(metricTypePtr->getTarget(indexParam, INVALID));
     } else {
         result = i2s(metricTypePtr->getAmount(indexParam));
@@ -1271,16 +1421,16 @@ void ScriptActionRunners::getMobIdsInRegion(
     ScriptActionInstRunData& data
 ) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& regionNumberArg = data.args[1];
+    size_t destVarArg = data.getArgVarId(0);
+    int regionNumberArg = data.getArgInt(1);
     
     //Main logic.
     vector<string> idsStrs;
-    size_t regionIdx = s2i(regionNumberArg) - 1;
+    size_t regionIdx = regionNumberArg - 1;
     if(regionIdx >= game.states.gameplay->areaRegions.size()) {
         ScriptActionUtils::reportActionError(
             data,
-            "Area region number " + regionNumberArg + " doesn't exist!"
+            "Area region number " + i2s(regionNumberArg) + " doesn't exist!"
         );
         return;
     }
@@ -1314,20 +1464,21 @@ void ScriptActionRunners::getMobIdsWithVar(
     ScriptActionInstRunData& data
 ) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& varArg = data.args[1];
-    const string& valueArg = data.args[2];
+    size_t destVarArg = data.getArgVarId(0);
+    size_t varArg = data.getArgVarId(1);
+    const string& valueArg = data.getArg(2);
     
     //Main logic.
     vector<string> idsStrs;
     forIdx(m, game.states.gameplay->mobs.all) {
         Mob* mPtr = game.states.gameplay->mobs.all[m];
-        const map<string, string>& mPtrVars = mPtr->scriptVM.vars.toMap();
         
-        auto it = mPtrVars.find(varArg);
-        if(it == mPtrVars.end()) continue;
-        if(!valueArg.empty()) {
-            if(it->second != valueArg) continue;
+        if(valueArg.empty()) {
+            if(!mPtr->scriptVM.vars.contains(varArg)) continue;
+        } else {
+            string value;
+            if(!mPtr->scriptVM.vars.getValue(varArg, value)) continue;
+            if(value != valueArg) continue;
         }
         
         idsStrs.push_back(i2s(mPtr->id));
@@ -1346,9 +1497,9 @@ void ScriptActionRunners::getMobIdsWithVar(
  */
 void ScriptActionRunners::getMobInfo(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& targetArg = data.args[1];
-    const string& typeArg = data.args[2];
+    size_t destVarArg = data.getArgVarId(0);
+    const string& targetArg = data.getArg(1);
+    const string& typeArg = data.getArg(2);
     
     //Main logic.
     SCRIPT_ACTION_MOB_TARGET_TYPE targetType =
@@ -1489,12 +1640,12 @@ void ScriptActionRunners::getMobInfo(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::getRandomFloat(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& minArg = data.args[1];
-    const string& maxArg = data.args[2];
+    size_t destVarArg = data.getArgVarId(0);
+    float minArg = data.getArgFloat(1);
+    float maxArg = data.getArgFloat(2);
     
     //Main logic.
-    float result = game.rng.f(s2f(minArg), s2f(maxArg));
+    float result = game.rng.f(minArg, maxArg);
     
     //Store the result.
     data.scriptVM->getRunnerScriptVM()->vars.setValue(destVarArg, result);
@@ -1508,12 +1659,12 @@ void ScriptActionRunners::getRandomFloat(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::getRandomInt(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& minArg = data.args[1];
-    const string& maxArg = data.args[2];
+    size_t destVarArg = data.getArgVarId(0);
+    int minArg = data.getArgInt(1);
+    int maxArg = data.getArgInt(2);
     
     //Main logic.
-    int result = game.rng.i(s2i(minArg), s2i(maxArg));
+    int result = game.rng.i(minArg, maxArg);
     
     //Store the result.
     data.scriptVM->getRunnerScriptVM()->vars.setValue(destVarArg, result);
@@ -1527,8 +1678,8 @@ void ScriptActionRunners::getRandomInt(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::getVarPresence(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& varArg = data.args[1];
+    size_t destVarArg = data.getArgVarId(0);
+    size_t varArg = data.getArgVarId(1);
     
     //Main logic.
     bool exists = data.scriptVM->getRunnerScriptVM()->vars.contains(varArg);
@@ -1550,9 +1701,9 @@ void ScriptActionRunners::getVarPresence(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::holdFocus(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& bodyPartArg = data.args[0];
-    const string& aboveArg = data.args[1];
-    const string& rotationArg = data.args[2];
+    const string& bodyPartArg = data.getArg(0);
+    bool aboveArg = data.getArgBool(1);
+    const string& rotationArg = data.getArg(2);
     
     //Main logic.
     if(!data.scriptVM->getRunnerScriptVM()->focusedMob) {
@@ -1584,7 +1735,7 @@ void ScriptActionRunners::holdFocus(ScriptActionInstRunData& data) {
     data.scriptVM->getRunnerMob()->hold(
         data.scriptVM->getRunnerScriptVM()->focusedMob,
         HOLD_TYPE_PURPOSE_GENERAL,
-        partIdx, 0.0f, 0.0f, 0.5f, s2b(aboveArg),
+        partIdx, 0.0f, 0.0f, 0.5f, aboveArg,
         rotationMethod
     );
 }
@@ -1597,9 +1748,7 @@ void ScriptActionRunners::holdFocus(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::ifAction(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& lhsArg = data.args[0];
-    const string& opArg = data.args[1];
-    string rhsArg = vectorTailToString(data.args, 2);
+    const string& opArg = data.getArg(1);
     
     //Main logic.
     bool opFound;
@@ -1613,7 +1762,7 @@ void ScriptActionRunners::ifAction(ScriptActionInstRunData& data) {
         return;
     }
     
-    bool result = ScriptActionUtils::doScriptCondition(lhsArg, op, rhsArg);
+    bool result = ScriptActionUtils::doScriptArgCondition(data, 0, op, 2);
     
     //Store the result.
     data.returnValue = result;
@@ -1627,18 +1776,18 @@ void ScriptActionRunners::ifAction(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::interpolateNumber(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& inputArg = data.args[1];
-    const string& inputStartArg = data.args[2];
-    const string& inputEndArg = data.args[3];
-    const string& outputStartArg = data.args[4];
-    const string& outputEndArg = data.args[5];
+    size_t destVarArg = data.getArgVarId(0);
+    float inputArg = data.getArgFloat(1);
+    float inputStartArg = data.getArgFloat(2);
+    float inputEndArg = data.getArgFloat(3);
+    float outputStartArg = data.getArgFloat(4);
+    float outputEndArg = data.getArgFloat(5);
     
     //Main logic.
     float result =
         ::interpolateNumber(
-            s2f(inputArg), s2f(inputStartArg), s2f(inputEndArg),
-            s2f(outputStartArg), s2f(outputEndArg)
+            inputArg, inputStartArg, inputEndArg,
+            outputStartArg, outputEndArg
         );
         
     //Store the result.
@@ -1680,7 +1829,7 @@ void ScriptActionRunners::linkWithFocus(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::loadFocusMemory(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& slotArg = data.args[0];
+    const string& slotArg = data.getArg(0);
     
     //Main logic.
     string varName = "_focus_memory_" + slotArg;
@@ -1701,12 +1850,12 @@ void ScriptActionRunners::loadFocusMemory(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::maxNumber(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& firstNrArg = data.args[1];
-    const string& secondNrArg = data.args[2];
+    size_t destVarArg = data.getArgVarId(0);
+    float firstNrArg = data.getArgFloat(1);
+    float secondNrArg = data.getArgFloat(2);
     
     //Main logic.
-    float result = std::max(s2f(firstNrArg), s2f(secondNrArg));
+    float result = std::max(firstNrArg, secondNrArg);
     
     //Store the result.
     data.scriptVM->getRunnerScriptVM()->vars.setValue(destVarArg, result);
@@ -1720,12 +1869,12 @@ void ScriptActionRunners::maxNumber(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::minNumber(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& firstNrArg = data.args[1];
-    const string& secondNrArg = data.args[2];
+    size_t destVarArg = data.getArgVarId(0);
+    float firstNrArg = data.getArgFloat(1);
+    float secondNrArg = data.getArgFloat(2);
     
     //Main logic.
-    float result = std::min(s2f(firstNrArg), s2f(secondNrArg));
+    float result = std::min(firstNrArg, secondNrArg);
     
     //Store the result.
     data.scriptVM->getRunnerScriptVM()->vars.setValue(destVarArg, result);
@@ -1739,14 +1888,17 @@ void ScriptActionRunners::minNumber(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::moveToAbsolute(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& xArg = data.args[0];
-    const string& yArg = data.args[1];
-    const string& zArg = data.args[2];
+    float xArg = data.getArgFloat(0);
+    float yArg = data.getArgFloat(1);
+    const string& zArg = data.getArg(2);
     
     //Main logic.
-    float x = s2f(xArg);
-    float y = s2f(yArg);
-    float z = zArg.empty() ? data.scriptVM->getRunnerMob()->bottomZ : s2f(zArg);
+    float x = xArg;
+    float y = yArg;
+    float z =
+        zArg.empty() ?
+        data.scriptVM->getRunnerMob()->bottomZ :
+        data.getArgFloat(2);
     data.scriptVM->getRunnerMob()->chase(
         Point(x, y), z,
         CHASE_FLAG_ACCEPT_LOWER_Z_GROUNDED
@@ -1761,14 +1913,14 @@ void ScriptActionRunners::moveToAbsolute(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::moveToRelative(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& xArg = data.args[0];
-    const string& yArg = data.args[1];
-    const string& zArg = data.args[2];
+    float xArg = data.getArgFloat(0);
+    float yArg = data.getArgFloat(1);
+    const string& zArg = data.getArg(2);
     
     //Main logic.
-    float x = s2f(xArg);
-    float y = s2f(yArg);
-    float z = zArg.empty() ? 0.0f : s2f(zArg);
+    float x = xArg;
+    float y = yArg;
+    float z = zArg.empty() ? 0.0f : data.getArgFloat(2);
     Point p = rotatePoint(Point(x, y), data.scriptVM->getRunnerMob()->angle);
     data.scriptVM->getRunnerMob()->chase(
         data.scriptVM->getRunnerMob()->center + p,
@@ -1785,7 +1937,7 @@ void ScriptActionRunners::moveToRelative(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::moveToTarget(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& targetArg = data.args[0];
+    const string& targetArg = data.getArg(0);
     
     //Main logic.
     bool targetFound;
@@ -1901,8 +2053,8 @@ void ScriptActionRunners::orderRelease(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::playSound(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& soundArg = data.args[0];
-    const string& destVarArg = data.args[1];
+    const string& soundArg = data.getArg(0);
+    const string& destVarArg = data.getArg(1);
     
     //Main logic.
     size_t soundDataIdx = INVALID;
@@ -1937,7 +2089,7 @@ void ScriptActionRunners::playSound(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::print(ScriptActionInstRunData& data) {
     //Get the arguments.
-    string textArg = vectorTailToString(data.args, 0);
+    string textArg = data.getArgTail(0);
     
     //Main logic.
     string speaker =
@@ -1958,7 +2110,7 @@ void ScriptActionRunners::print(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::receiveStatus(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& statusArg = data.args[0];
+    const string& statusArg = data.getArg(0);
     
     //Main logic.
     auto it = game.content.statusTypes.list.find(statusArg);
@@ -2003,10 +2155,10 @@ void ScriptActionRunners::releaseStoredMobs(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::removeListItem(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& listArg = data.args[1];
-    const string& numberArg = data.args[2];
-    const string& delArg = data.args[3];
+    size_t destVarArg = data.getArgVarId(0);
+    const string& listArg = data.getArg(1);
+    int numberArg = data.getArgInt(2);
+    const string& delArg = data.getArg(3);
     
     //Main logic.
     bool delFound;
@@ -2023,7 +2175,7 @@ void ScriptActionRunners::removeListItem(ScriptActionInstRunData& data) {
     
     string delChar = enumGetName(scriptActionListDelimiterChars, delType);
     vector<string> items = split(listArg, delChar, true);
-    int idx = s2i(numberArg) - 1;
+    int idx = numberArg - 1;
     if(!isIdxValid(idx, items)) idx = items.size() - 1;
     
     if(isIdxValid(idx, items)) {
@@ -2043,7 +2195,7 @@ void ScriptActionRunners::removeListItem(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::removeStatus(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& statusArg = data.args[0];
+    const string& statusArg = data.getArg(0);
     
     //Main logic.
     auto it = game.content.statusTypes.list.find(statusArg);
@@ -2073,11 +2225,11 @@ void ScriptActionRunners::removeStatus(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::roundNumber(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& numberArg = data.args[1];
+    size_t destVarArg = data.getArgVarId(0);
+    float numberArg = data.getArgFloat(1);
     
     //Main logic.
-    float result = round(s2f(numberArg));
+    float result = round(numberArg);
     
     //Store the result.
     data.scriptVM->getRunnerScriptVM()->vars.setValue(destVarArg, result);
@@ -2091,7 +2243,7 @@ void ScriptActionRunners::roundNumber(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::runNextActionAs(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& targetTypeArg = data.args[0];
+    const string& targetTypeArg = data.getArg(0);
     
     //Main logic.
     SCRIPT_ACTION_MOB_TARGET_TYPE targetType =
@@ -2109,7 +2261,7 @@ void ScriptActionRunners::runNextActionAs(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::saveFocusMemory(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& slotArg = data.args[0];
+    const string& slotArg = data.getArg(0);
     
     //Main logic.
     if(!data.scriptVM->getRunnerScriptVM()->focusedMob) {
@@ -2129,7 +2281,7 @@ void ScriptActionRunners::saveFocusMemory(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::sendMessageToAllMobs(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& msgArg = data.args[0];
+    const string& msgArg = data.getArg(0);
     
     //Main logic.
     string msgStr = msgArg;
@@ -2149,7 +2301,7 @@ void ScriptActionRunners::sendMessageToAllMobs(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::sendMessageToArea(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& msgArg = data.args[0];
+    const string& msgArg = data.getArg(0);
     
     //Main logic.
     string msgStr = msgArg;
@@ -2166,7 +2318,7 @@ void ScriptActionRunners::sendMessageToArea(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::sendMessageToFocus(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& msgArg = data.args[0];
+    const string& msgArg = data.getArg(0);
     
     //Main logic.
     if(!data.scriptVM->getRunnerScriptVM()->focusedMob) return;
@@ -2185,7 +2337,7 @@ void ScriptActionRunners::sendMessageToFocus(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::sendMessageToLinks(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& msgArg = data.args[0];
+    const string& msgArg = data.getArg(0);
     
     //Main logic.
     forIdx(l, data.scriptVM->getRunnerMob()->links) {
@@ -2215,11 +2367,11 @@ void ScriptActionRunners::sendMessageToLinks(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::sendMessageToNearby(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& distArg = data.args[0];
-    const string& msgArg = data.args[1];
+    float distArg = data.getArgFloat(0);
+    const string& msgArg = data.getArg(1);
     
     //Main logic.
-    Distance d(s2f(distArg));
+    Distance d(distArg);
     
     forIdx(m2, game.states.gameplay->mobs.all) {
         if(
@@ -2253,9 +2405,9 @@ void ScriptActionRunners::sendMessageToNearby(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setAnimation(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& animArg = data.args[0];
-    const string& optionArg = data.args[1];
-    const string& mobSpeedArg = data.args[2];
+    const string& animArg = data.getArg(0);
+    const string& optionArg = data.getArg(1);
+    bool mobSpeedArg = data.getArgBool(2);
     
     //Main logic.
     size_t animIdx =
@@ -2280,7 +2432,7 @@ void ScriptActionRunners::setAnimation(ScriptActionInstRunData& data) {
     }
     
     float mobSpeedBaseline = 0.0f;
-    if(s2b(mobSpeedArg)) {
+    if(mobSpeedArg) {
         mobSpeedBaseline = data.scriptVM->getRunnerMob()->type->moveSpeed;
     };
     
@@ -2297,10 +2449,10 @@ void ScriptActionRunners::setAnimation(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setCanBlockPaths(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& valueArg = data.args[0];
+    bool valueArg = data.getArgBool(0);
     
     //Main logic.
-    data.scriptVM->getRunnerMob()->setCanBlockPaths(s2b(valueArg));
+    data.scriptVM->getRunnerMob()->setCanBlockPaths(valueArg);
 }
 
 
@@ -2311,7 +2463,7 @@ void ScriptActionRunners::setCanBlockPaths(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setFarReach(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& reachArg = data.args[0];
+    const string& reachArg = data.getArg(0);
     
     //Main logic.
     size_t reachIdx = INVALID;
@@ -2341,10 +2493,10 @@ void ScriptActionRunners::setFarReach(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setFlying(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& valueArg = data.args[0];
+    bool valueArg = data.getArgBool(0);
     
     //Main logic.
-    if(s2b(valueArg)) {
+    if(valueArg) {
         enableFlag(
             data.scriptVM->getRunnerMob()->flags, MOB_FLAG_CAN_MOVE_MIDAIR
         );
@@ -2363,8 +2515,8 @@ void ScriptActionRunners::setFlying(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setFocusVar(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& varArg = data.args[0];
-    const string& valueArg = data.args[1];
+    size_t varArg = data.getArgVarId(0);
+    const string& valueArg = data.getArg(1);
     
     //Main logic.
     if(!data.scriptVM->getRunnerScriptVM()->focusedMob) return;
@@ -2381,10 +2533,10 @@ void ScriptActionRunners::setFocusVar(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setGravity(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& gravityArg = data.args[0];
+    float gravityArg = data.getArgFloat(0);
     
     //Main logic.
-    data.scriptVM->getRunnerMob()->gravityMult = s2f(gravityArg);
+    data.scriptVM->getRunnerMob()->gravityMult = gravityArg;
 }
 
 
@@ -2395,10 +2547,10 @@ void ScriptActionRunners::setGravity(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setHealth(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& healthArg = data.args[0];
+    float healthArg = data.getArgFloat(0);
     
     //Main logic.
-    data.scriptVM->getRunnerMob()->setHealth(false, false, s2f(healthArg));
+    data.scriptVM->getRunnerMob()->setHealth(false, false, healthArg);
 }
 
 
@@ -2409,10 +2561,10 @@ void ScriptActionRunners::setHealth(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setHeight(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& heightArg = data.args[0];
+    float heightArg = data.getArgFloat(0);
     
     //Main logic.
-    data.scriptVM->getRunnerMob()->height = s2f(heightArg);
+    data.scriptVM->getRunnerMob()->height = heightArg;
     
     if(data.scriptVM->getRunnerMob()->type->walkable) {
         //Update the Z of mobs standing on top of it.
@@ -2435,10 +2587,10 @@ void ScriptActionRunners::setHeight(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setHiding(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& valueArg = data.args[0];
+    bool valueArg = data.getArgBool(0);
     
     //Main logic.
-    if(s2b(valueArg)) {
+    if(valueArg) {
         enableFlag(data.scriptVM->getRunnerMob()->flags, MOB_FLAG_HIDDEN);
     } else {
         disableFlag(data.scriptVM->getRunnerMob()->flags, MOB_FLAG_HIDDEN);
@@ -2458,8 +2610,8 @@ void ScriptActionRunners::setHoldable(ScriptActionInstRunData& data) {
     }
     
     unsigned char flags = 0;
-    forIdx(a, data.args) {
-        const string& ruleArg = data.args[a];
+    for(size_t a = 0; a < data.getNrArgs(); a++) {
+        const string& ruleArg = data.getArg(a);
         bool flagFound;
         HOLDABILITY_FLAG flag =
             enumGetValue(holdabilityFlagINames, ruleArg, &flagFound);
@@ -2486,10 +2638,10 @@ void ScriptActionRunners::setHoldable(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setHuntable(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& valueArg = data.args[0];
+    bool valueArg = data.getArgBool(0);
     
     //Main logic.
-    if(s2b(valueArg)) {
+    if(valueArg) {
         disableFlag(
             data.scriptVM->getRunnerMob()->flags, MOB_FLAG_NON_HUNTABLE
         );
@@ -2508,7 +2660,7 @@ void ScriptActionRunners::setHuntable(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setLimbAnimation(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& animArg = data.args[0];
+    const string& animArg = data.getArg(0);
     
     //Main logic.
     if(!data.scriptVM->getRunnerMob()->parent) {
@@ -2539,11 +2691,11 @@ void ScriptActionRunners::setLimbAnimation(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setListItem(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& listArg = data.args[1];
-    const string& newItemArg = data.args[2];
-    const string& numberArg = data.args[3];
-    const string& delArg = data.args[4];
+    size_t destVarArg = data.getArgVarId(0);
+    const string& listArg = data.getArg(1);
+    const string& newItemArg = data.getArg(2);
+    int numberArg = data.getArgInt(3);
+    const string& delArg = data.getArg(4);
     
     //Main logic.
     bool delFound;
@@ -2560,7 +2712,7 @@ void ScriptActionRunners::setListItem(ScriptActionInstRunData& data) {
     
     string delChar = enumGetName(scriptActionListDelimiterChars, delType);
     vector<string> items = split(listArg, delChar, true);
-    int idx = s2i(numberArg) - 1;
+    int idx = numberArg - 1;
     if(!isIdxValid(idx, items)) idx = items.size() - 1;
     
     if(isIdxValid(idx, items)) {
@@ -2582,13 +2734,13 @@ void ScriptActionRunners::setMissionMetricScriptSlot(
     ScriptActionInstRunData& data
 ) {
     //Get the arguments.
-    const string& slotNumberArg = data.args[0];
-    const string& valueArg = data.args[1];
+    int slotNumberArg = data.getArgInt(0);
+    int valueArg = data.getArgInt(1);
     
     //Main logic.
     if(game.curArea->type != AREA_TYPE_MISSION) return;
-    size_t slotNumber = s2i(slotNumberArg) - 1;
-    int value = s2i(valueArg);
+    size_t slotNumber = slotNumberArg - 1;
+    int value = valueArg;
     game.states.gameplay->missionMetricScriptSlots[slotNumber] = value;
 }
 
@@ -2600,7 +2752,7 @@ void ScriptActionRunners::setMissionMetricScriptSlot(
  */
 void ScriptActionRunners::setNearReach(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& reachArg = data.args[0];
+    const string& reachArg = data.getArg(0);
     
     //Main logic.
     size_t reachIdx = INVALID;
@@ -2630,10 +2782,10 @@ void ScriptActionRunners::setNearReach(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setRadius(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& radiusArg = data.args[0];
+    float radiusArg = data.getArgFloat(0);
     
     //Main logic.
-    data.scriptVM->getRunnerMob()->setRadius(s2f(radiusArg));
+    data.scriptVM->getRunnerMob()->setRadius(radiusArg);
 }
 
 
@@ -2644,16 +2796,16 @@ void ScriptActionRunners::setRadius(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setSectorScroll(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& xArg = data.args[0];
-    const string& yArg = data.args[1];
+    float xArg = data.getArgFloat(0);
+    float yArg = data.getArgFloat(1);
     
     //Main logic.
     Sector* sPtr =
         getSector(data.scriptVM->getRunnerMob()->center, nullptr, true);
     if(!sPtr) return;
     
-    sPtr->scroll.x = s2f(xArg);
-    sPtr->scroll.y = s2f(yArg);
+    sPtr->scroll.x = xArg;
+    sPtr->scroll.y = yArg;
 }
 
 
@@ -2664,10 +2816,10 @@ void ScriptActionRunners::setSectorScroll(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setShadowVisibility(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& valueArg = data.args[0];
+    bool valueArg = data.getArgBool(0);
     
     //Main logic.
-    if(s2b(valueArg)) {
+    if(valueArg) {
         disableFlag(
             data.scriptVM->getRunnerMob()->flags, MOB_FLAG_SHADOW_INVISIBLE
         );
@@ -2686,7 +2838,7 @@ void ScriptActionRunners::setShadowVisibility(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setState(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& stateArg = data.args[0];
+    const string& stateArg = data.getArg(0);
     
     //Main logic.
     size_t stateIdx = INVALID;
@@ -2721,10 +2873,10 @@ void ScriptActionRunners::setState(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setTangible(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& valueArg = data.args[0];
+    bool valueArg = data.getArgBool(0);
     
     //Main logic.
-    if(s2b(valueArg)) {
+    if(valueArg) {
         disableFlag(data.scriptVM->getRunnerMob()->flags, MOB_FLAG_INTANGIBLE);
     } else {
         enableFlag(data.scriptVM->getRunnerMob()->flags, MOB_FLAG_INTANGIBLE);
@@ -2739,7 +2891,7 @@ void ScriptActionRunners::setTangible(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setTeam(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& teamArg = data.args[0];
+    const string& teamArg = data.getArg(0);
     
     //Main logic.
     bool teamFound;
@@ -2762,10 +2914,10 @@ void ScriptActionRunners::setTeam(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setTimer(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& durationArg = data.args[0];
+    float durationArg = data.getArgFloat(0);
     
     //Main logic.
-    data.scriptVM->getRunnerScriptVM()->setTimer(s2f(durationArg));
+    data.scriptVM->getRunnerScriptVM()->setTimer(durationArg);
 }
 
 
@@ -2776,8 +2928,8 @@ void ScriptActionRunners::setTimer(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::setVar(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& varArg = data.args[0];
-    const string& valueArg = data.args[1];
+    size_t varArg = data.getArgVarId(0);
+    const string& valueArg = data.getArg(1);
     
     //Main logic.
     data.scriptVM->getRunnerScriptVM()->vars.setValue(varArg, valueArg);
@@ -2791,7 +2943,7 @@ void ScriptActionRunners::setVar(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::shakeCamera(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& amountArg = data.args[0];
+    float amountArg = data.getArgFloat(0);
     
     //Main logic.
     forIdx(p, game.states.gameplay->players) {
@@ -2804,7 +2956,7 @@ void ScriptActionRunners::shakeCamera(ScriptActionInstRunData& data) {
             ::interpolateNumber(
                 d, 0.0f, DRAWING::CAM_SHAKE_DROPOFF_DIST, 1.0f, 0.0f
             );
-        player.view.shaker.shake(s2f(amountArg) / 100.0f * strengthMult);
+        player.view.shaker.shake(amountArg / 100.0f * strengthMult);
     }
 }
 
@@ -2816,7 +2968,7 @@ void ScriptActionRunners::shakeCamera(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::showCutsceneMessage(ScriptActionInstRunData& data) {
     //Get the arguments.
-    string textArg = vectorTailToString(data.args, 0);
+    string textArg = data.getArgTail(0);
     
     //Main logic.
     startCutsceneMessage(textArg, nullptr);
@@ -2830,7 +2982,7 @@ void ScriptActionRunners::showCutsceneMessage(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::showMessageFromVar(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& varArg = data.args[0];
+    size_t varArg = data.getArgVarId(0);
     
     //Main logic.
     string text;
@@ -2846,11 +2998,11 @@ void ScriptActionRunners::showMessageFromVar(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::signNumber(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& numberArg = data.args[1];
+    size_t destVarArg = data.getArgVarId(0);
+    float numberArg = data.getArgFloat(1);
     
     //Main logic.
-    float result = sign(s2f(numberArg));
+    float result = sign(numberArg);
     
     //Store the result.
     data.scriptVM->getRunnerScriptVM()->vars.setValue(destVarArg, result);
@@ -2864,7 +3016,7 @@ void ScriptActionRunners::signNumber(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::spawn(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& spawnArg = data.args[0];
+    const string& spawnArg = data.getArg(0);
     
     //Main logic.
     size_t spawnIdx = INVALID;
@@ -2896,11 +3048,11 @@ void ScriptActionRunners::spawn(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::squareRootNumber(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& numberArg = data.args[1];
+    size_t destVarArg = data.getArgVarId(0);
+    float numberArg = data.getArgFloat(1);
     
     //Main logic.
-    float result = (float) sqrt(s2f(numberArg));
+    float result = (float) sqrt(numberArg);
     
     //Store the result.
     data.scriptVM->getRunnerScriptVM()->vars.setValue(destVarArg, result);
@@ -2914,8 +3066,8 @@ void ScriptActionRunners::squareRootNumber(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::stabilizeZ(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& typeArg = data.args[0];
-    const string& offsetArg = data.args[1];
+    const string& typeArg = data.getArg(0);
+    float offsetArg = data.getArgFloat(1);
     
     //Main logic.
     if(
@@ -2959,7 +3111,7 @@ void ScriptActionRunners::stabilizeZ(ScriptActionInstRunData& data) {
         
     }
     
-    data.scriptVM->getRunnerMob()->bottomZ = bestMatchZ + s2f(offsetArg);
+    data.scriptVM->getRunnerMob()->bottomZ = bestMatchZ + offsetArg;
 }
 
 
@@ -2970,14 +3122,14 @@ void ScriptActionRunners::stabilizeZ(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::startChomping(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& maxArg = data.args[0];
+    int maxArg = data.getArgInt(0);
     
     //Main logic.
-    data.scriptVM->getRunnerMob()->chompMax = s2i(maxArg);
+    data.scriptVM->getRunnerMob()->chompMax = maxArg;
     data.scriptVM->getRunnerMob()->chompBodyParts.clear();
     
-    for(size_t a = 1; a < data.args.size(); a++) {
-        const string& partArg = data.args[a];
+    for(size_t a = 1; a < data.getNrArgs(); a++) {
+        const string& partArg = data.getArg(a);
         size_t partIdx =
             data.scriptVM->getRunnerMob()->type->animDb->findBodyPart(partArg);
             
@@ -3023,15 +3175,15 @@ void ScriptActionRunners::startHeightEffect(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::startParticles(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& genArg = data.args[0];
-    const string& xArg = data.args[1];
-    const string& yArg = data.args[2];
-    const string& zArg = data.args[3];
+    const string& genArg = data.getArg(0);
+    float xArg = data.getArgFloat(1);
+    float yArg = data.getArgFloat(2);
+    float zArg = data.getArgFloat(3);
     
     //Main logic.
-    float offsetX = s2f(xArg);
-    float offsetY = s2f(yArg);
-    float offsetZ = s2f(zArg);
+    float offsetX = xArg;
+    float offsetY = yArg;
+    float offsetZ = zArg;
     
     if(!isInMap(game.content.particleGens.list, genArg)) {
         ScriptActionUtils::reportActionError(
@@ -3106,10 +3258,10 @@ void ScriptActionRunners::stopParticles(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::stopSound(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& idArg = data.args[0];
+    int idArg = data.getArgInt(0);
     
     //Main logic.
-    game.audio.destroySoundSource(s2i(idArg));
+    game.audio.destroySoundSource(idArg);
 }
 
 
@@ -3150,10 +3302,10 @@ void ScriptActionRunners::storeFocusInside(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::swallow(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& amountArg = data.args[0];
+    int amountArg = data.getArgInt(0);
     
     //Main logic.
-    data.scriptVM->getRunnerMob()->swallowChompedPikmin(s2i(amountArg));
+    data.scriptVM->getRunnerMob()->swallowChompedPikmin(amountArg);
 }
 
 
@@ -3177,14 +3329,14 @@ void ScriptActionRunners::swallowAll(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::teleportToAbsolute(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& xArg = data.args[0];
-    const string& yArg = data.args[1];
-    const string& zArg = data.args[2];
+    float xArg = data.getArgFloat(0);
+    float yArg = data.getArgFloat(1);
+    float zArg = data.getArgFloat(2);
     
     //Main logic.
     data.scriptVM->getRunnerMob()->stopChasing();
     data.scriptVM->getRunnerMob()->chase(
-        Point(s2f(xArg), s2f(yArg)), s2f(zArg), CHASE_FLAG_TELEPORT
+        Point(xArg, yArg), zArg, CHASE_FLAG_TELEPORT
     );
 }
 
@@ -3196,20 +3348,20 @@ void ScriptActionRunners::teleportToAbsolute(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::teleportToRelative(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& xArg = data.args[0];
-    const string& yArg = data.args[1];
-    const string& zArg = data.args[2];
+    float xArg = data.getArgFloat(0);
+    float yArg = data.getArgFloat(1);
+    float zArg = data.getArgFloat(2);
     
     //Main logic.
     data.scriptVM->getRunnerMob()->stopChasing();
     Point p =
         rotatePoint(
-            Point(s2f(xArg), s2f(yArg)),
+            Point(xArg, yArg),
             data.scriptVM->getRunnerMob()->angle
         );
     data.scriptVM->getRunnerMob()->chase(
         data.scriptVM->getRunnerMob()->center + p,
-        data.scriptVM->getRunnerMob()->bottomZ + s2f(zArg),
+        data.scriptVM->getRunnerMob()->bottomZ + zArg,
         CHASE_FLAG_TELEPORT
     );
 }
@@ -3222,10 +3374,10 @@ void ScriptActionRunners::teleportToRelative(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::throwFocus(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& xArg = data.args[0];
-    const string& yArg = data.args[1];
-    const string& zArg = data.args[2];
-    const string& maxHeightArg = data.args[3];
+    float xArg = data.getArgFloat(0);
+    float yArg = data.getArgFloat(1);
+    float zArg = data.getArgFloat(2);
+    float maxHeightArg = data.getArgFloat(3);
     
     //Main logic.
     if(!data.scriptVM->getRunnerScriptVM()->focusedMob) {
@@ -3241,7 +3393,7 @@ void ScriptActionRunners::throwFocus(ScriptActionInstRunData& data) {
         );
     }
     
-    float maxHeight = s2f(maxHeightArg);
+    float maxHeight = maxHeightArg;
     if(maxHeight == 0.0f) {
         //We just want to drop it, not throw it.
         return;
@@ -3251,7 +3403,7 @@ void ScriptActionRunners::throwFocus(ScriptActionInstRunData& data) {
     calculateThrow(
         data.scriptVM->getRunnerScriptVM()->focusedMob->center,
         data.scriptVM->getRunnerScriptVM()->focusedMob->bottomZ,
-        Point(s2f(xArg), s2f(yArg)), s2f(zArg),
+        Point(xArg, yArg), zArg,
         maxHeight, MOB::GRAVITY_ADDER,
         &data.scriptVM->getRunnerScriptVM()->focusedMob->speed,
         &data.scriptVM->getRunnerScriptVM()->focusedMob->speedZ,
@@ -3267,11 +3419,11 @@ void ScriptActionRunners::throwFocus(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::truncateNumber(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& destVarArg = data.args[0];
-    const string& numberArg = data.args[1];
+    size_t destVarArg = data.getArgVarId(0);
+    int numberArg = data.getArgInt(1);
     
     //Main logic.
-    int result = s2i(numberArg);
+    int result = numberArg;
     
     //Store the result.
     data.scriptVM->getRunnerScriptVM()->vars.setValue(destVarArg, result);
@@ -3285,19 +3437,19 @@ void ScriptActionRunners::truncateNumber(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::turnToAbsolute(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& angleOrXArg = data.args[0];
-    const string& yArg = data.args[1];
+    float angleOrXArg = data.getArgFloat(0);
+    const string& yArg = data.getArg(1);
     
     //Main logic.
     if(yArg.empty()) {
         //Turn to an absolute angle.
         data.scriptVM->getRunnerMob()->face(
-            degToRad(s2f(angleOrXArg)), nullptr
+            degToRad(angleOrXArg), nullptr
         );
     } else {
         //Turn to some absolute coordinates.
-        float x = s2f(angleOrXArg);
-        float y = s2f(yArg);
+        float x = angleOrXArg;
+        float y = data.getArgFloat(1);
         data.scriptVM->getRunnerMob()->face(
             getAngle(data.scriptVM->getRunnerMob()->center, Point(x, y)),
             nullptr
@@ -3313,20 +3465,20 @@ void ScriptActionRunners::turnToAbsolute(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::turnToRelative(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& angleOrXArg = data.args[0];
-    const string& yArg = data.args[1];
+    float angleOrXArg = data.getArgFloat(0);
+    const string& yArg = data.getArg(1);
     
     //Main logic.
     if(yArg.empty()) {
         //Turn to a relative angle.
         data.scriptVM->getRunnerMob()->face(
-            data.scriptVM->getRunnerMob()->angle + degToRad(s2f(angleOrXArg)),
+            data.scriptVM->getRunnerMob()->angle + degToRad(angleOrXArg),
             nullptr
         );
     } else {
         //Turn to some relative coordinates.
-        float x = s2f(angleOrXArg);
-        float y = s2f(yArg);
+        float x = angleOrXArg;
+        float y = data.getArgFloat(1);
         Point p =
             rotatePoint(Point(x, y), data.scriptVM->getRunnerMob()->angle);
         data.scriptVM->getRunnerMob()->face(
@@ -3347,7 +3499,7 @@ void ScriptActionRunners::turnToRelative(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::turnToTarget(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& targetArg = data.args[0];
+    const string& targetArg = data.getArg(0);
     
     //Main logic.
     bool targetFound;
@@ -3405,9 +3557,7 @@ void ScriptActionRunners::unfocus(ScriptActionInstRunData& data) {
  */
 void ScriptActionRunners::whileDo(ScriptActionInstRunData& data) {
     //Get the arguments.
-    const string& lhsArg = data.args[0];
-    const string& opArg = data.args[1];
-    string rhsArg = vectorTailToString(data.args, 2);
+    const string& opArg = data.getArg(1);
     
     //Main logic.
     bool opFound;
@@ -3421,7 +3571,7 @@ void ScriptActionRunners::whileDo(ScriptActionInstRunData& data) {
         return;
     }
     
-    bool result = ScriptActionUtils::doScriptCondition(lhsArg, op, rhsArg);
+    bool result = ScriptActionUtils::doScriptArgCondition(data, 0, op, 2);
     
     //Store the result.
     data.returnValue = result;
@@ -3432,6 +3582,39 @@ void ScriptActionRunners::whileDo(ScriptActionInstRunData& data) {
 #pragma region Action util functions
 
 
+/**
+ * @brief Returns whether a script condition made from an action's arguments
+ * is true or not. If both sides are single numbers, they're compared
+ * without going through strings.
+ *
+ * @param data Data about the action call.
+ * @param lhsIdx Index of the left-hand side comparand argument.
+ * @param op The operator.
+ * @param rhsStartIdx Index of the first argument of the right-hand side
+ * comparand. All arguments from there on are a part of it.
+ * @return Whether it is true.
+ */
+bool ScriptActionUtils::doScriptArgCondition(
+    const ScriptActionInstRunData& data, size_t lhsIdx,
+    SCRIPT_ACTION_IF_OP op, size_t rhsStartIdx
+) {
+    double lhs = 0.0;
+    double rhs = 0.0;
+    if(
+        data.getNrArgs() == rhsStartIdx + 1 &&
+        data.getArgNumber(lhsIdx, lhs) &&
+        data.getArgNumber(rhsStartIdx, rhs)
+    ) {
+        return doScriptNumberCondition(lhs, op, rhs);
+    }
+    
+    return
+        doScriptCondition(
+            data.getArg(lhsIdx), op, data.getArgTail(rhsStartIdx)
+        );
+}
+
+
 /**
  * @brief Returns whether a script condition is true or not.
  *
@@ -3483,6 +3666,38 @@ bool ScriptActionUtils::doScriptCondition(
 }
 
 
+/**
+ * @brief Returns whether a script condition between two numbers is
+ * true or not.
+ *
+ * @param lhs The left-hand side comparand.
+ * @param op The operator.
+ * @param rhs The right-hand side comparand.
+ * @return Whether it is true.
+ */
+bool ScriptActionUtils::doScriptNumberCondition(
+    double lhs, SCRIPT_ACTION_IF_OP op, double rhs
+) {
+    switch(op) {
+    case SCRIPT_ACTION_IF_OP_EQUAL: {
+        return lhs == rhs;
+    } case SCRIPT_ACTION_IF_OP_NOT: {
+        return lhs != rhs;
+    } case SCRIPT_ACTION_IF_OP_LESS: {
+        return lhs < rhs;
+    } case SCRIPT_ACTION_IF_OP_MORE: {
+        return lhs > rhs;
+    } case SCRIPT_ACTION_IF_OP_LESS_E: {
+        return lhs <= rhs;
+    } case SCRIPT_ACTION_IF_OP_MORE_E: {
+        return lhs >= rhs;
+    }
+    }
+    
+    return false;
+}
+
+
 /**
  * @brief Returns a mob script action mob target type from an action call.
  *
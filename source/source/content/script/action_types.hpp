@@ -1037,9 +1037,16 @@ void whileDo(ScriptActionInstRunData& data);
 
 
 namespace ScriptActionUtils {
+bool doScriptArgCondition(
+    const ScriptActionInstRunData& data, size_t lhsIdx,
+    SCRIPT_ACTION_IF_OP op, size_t rhsStartIdx
+);
 bool doScriptCondition(
     const string& lhs, SCRIPT_ACTION_IF_OP op, const string& rhs
 );
+bool doScriptNumberCondition(
+    double lhs, SCRIPT_ACTION_IF_OP op, double rhs
+);
 SCRIPT_ACTION_MOB_TARGET_TYPE getMobTargetType(
     const ScriptActionInstRunData& data, const string& name
 );
@@ -27,8 +27,7 @@ void EasyFsmCreator::changeState(const string& newState) {
     curEvent->actions.list.push_back(
         new ScriptActionDef(SCRIPT_ACTION_SET_STATE)
     );
-    curEvent->actions.list.back()->args.push_back(newState);
-    curEvent->actions.list.back()->argIsVar.push_back(false);
+    curEvent->actions.list.back()->args.push_back(ScriptActionArg(newState));
 }
 
 
@@ -303,6 +302,10 @@ void FsmInst::runEvent(
 ) {
     FsmEventDef* e = getEvent(type);
     if(e) {
+        if(script->mob && script->mob->isSleeping) {
+            //Whatever the event does, the mob needs to be checked again.
+            game.states.gameplay->areaActiveCells.wakeMob(script->mob);
+        }
         e->run(script, customData1, customData2, resetNConsecutiveActions);
     }
 }
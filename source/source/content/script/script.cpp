@@ -171,7 +171,7 @@ string ScriptVM::getMakerToolVarsStr() const {
         return result;
     }
     
-    const map<string, string>& varMap = vars.toMap();
+    map<string, string> varMap = vars.toMap();
     for(const auto& v : varMap) {
         result += v.first + "=" + v.second + "; ";
     }
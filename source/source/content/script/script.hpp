@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <deque>
 #include <map>
 #include <string>
 #include <vector>
@@ -19,6 +20,7 @@
 #include "script_utils.hpp"
 #include "../../core/misc_structs.hpp"
 
+using std::deque;
 using std::map;
 using std::string;
 using std::vector;
@@ -139,6 +141,15 @@ struct ScriptExecutionAuxData {
     //variable, or initialize it?
     bool forLoopEntryNeedsIncrement = false;
     
+    //Scratch strings for the values of variable arguments. The actions being
+    //run take theirs from the top, like a stack, so the strings keep their
+    //memory from one action to the next. Growing a deque at the end doesn't
+    //move the existing strings.
+    deque<string> argStrs;
+    
+    //How many of the argument scratch strings are in use.
+    size_t nArgStrsInUse = 0;
+    
     
     //--- Public function declarations ---
     
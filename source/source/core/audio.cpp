@@ -343,7 +343,7 @@ bool AudioManager::emit(size_t sourceId) {
     
     //Check if there's a random chance for this to not play.
     if(sourcePtr->config.randomChance < 100) {
-        unsigned char roll = game.rng.i(1, 100);
+        unsigned char roll = rng.i(1, 100);
         if(roll > sourcePtr->config.randomChance) {
             //Can't emit. Random chance failed.
             return false;
@@ -372,7 +372,7 @@ bool AudioManager::emit(size_t sourceId) {
     playbackPtr->baseVolume = sourcePtr->config.volume;
     if(sourcePtr->config.volumeDeviation != 0.0f) {
         playbackPtr->baseVolume +=
-            game.rng.f(
+            rng.f(
                 -sourcePtr->config.volumeDeviation,
                 sourcePtr->config.volumeDeviation
             );
@@ -414,7 +414,7 @@ bool AudioManager::emit(size_t sourceId) {
     float speed = sourcePtr->config.speed;
     if(sourcePtr->config.speedDeviation != 0.0f) {
         speed +=
-            game.rng.f(
+            rng.f(
                 -sourcePtr->config.speedDeviation,
                 sourcePtr->config.speedDeviation
             );
@@ -605,6 +605,9 @@ void AudioManager::handleWorldUnpause() {
  * @brief Initializes the audio manager.
  */
 void AudioManager::init() {
+    //Randomness.
+    rng.init();
+    
     //Main voice.
     voice =
         al_create_voice(
@@ -703,7 +706,7 @@ bool AudioManager::scheduleEmission(size_t sourceId, bool first) {
     sourcePtr->emitTimeLeft = first ? 0.0f : sourcePtr->config.interval;
     if(first || sourcePtr->config.interval > 0.0f) {
         sourcePtr->emitTimeLeft +=
-            game.rng.f(0, sourcePtr->config.randomDelay);
+            rng.f(0, sourcePtr->config.randomDelay);
     }
     
     return true;
@@ -485,6 +485,10 @@ private:
     //Camera corners.
     RectCorners cameraBBox;
     
+    //Randomness manager for sound effect variations. Separate from the
+    //game's, so that playing sounds doesn't change gameplay randomness.
+    RngManager rng;
+    
     
     //--- Private function declarations ---
     
@@ -104,6 +104,9 @@ const string GAME_DATA = "game_data";
 //User data folder.
 const string USER_DATA = "user_data";
 
+//Data file cache folder.
+const string DATA_FILE_CACHE = "data_file_cache";
+
 //Base content pack folder.
 const string BASE_PACK = "base";
 
@@ -216,12 +219,18 @@ const string MOB_TYPE_SCRIPT = "script.txt";
 //System content names file.
 const string SYSTEM_CONTENT_NAMES = "system_content_names.txt";
 
+//Benchmark results file.
+const string BENCHMARK_RESULTS = "benchmark_results.txt";
+
 //Debug config file.
 const string DEBUG_CONFIG = "debug.txt";
 
 //Error log file.
 const string ERROR_LOG = "error_log.txt";
 
+//Replay of the last gameplay session file.
+const string LAST_REPLAY = "last_replay.rpl";
+
 //Maker tools file.
 const string MAKER_TOOLS = "tools.txt";
 
@@ -266,6 +275,10 @@ const string USER_DATA =
 const string AREA_USER_DATA =
     USER_DATA + "/" + FOLDER_NAMES::AREAS;
     
+//Data file cache folder.
+const string DATA_FILE_CACHE =
+    USER_DATA + "/" + FOLDER_NAMES::DATA_FILE_CACHE;
+    
 };
 
 
@@ -276,6 +289,10 @@ const string AREA_USER_DATA =
 //Paths to files from the engine's root folder.
 namespace FILE_PATHS_FROM_ROOT {
 
+//Benchmark results.
+const string BENCHMARK_RESULTS =
+    FOLDER_PATHS_FROM_ROOT::USER_DATA + "/" + FILE_NAMES::BENCHMARK_RESULTS;
+    
 //Debug config.
 const string DEBUG_CONFIG =
     FOLDER_PATHS_FROM_ROOT::USER_DATA + "/" + FILE_NAMES::DEBUG_CONFIG;
@@ -284,6 +301,10 @@ const string DEBUG_CONFIG =
 const string ERROR_LOG =
     FOLDER_PATHS_FROM_ROOT::USER_DATA + "/" + FILE_NAMES::ERROR_LOG;
     
+//Replay of the last gameplay session.
+const string LAST_REPLAY =
+    FOLDER_PATHS_FROM_ROOT::USER_DATA + "/" + FILE_NAMES::LAST_REPLAY;
+    
 //Mission records.
 const string MISSION_RECORDS =
     FOLDER_PATHS_FROM_ROOT::USER_DATA + "/" + FILE_NAMES::MISSION_RECORDS;
@@ -1387,103 +1387,17 @@ void drawSectorTexture(
         
     }
     
+    SectorTextureVertexCache& cache = sPtr->textureVertexCache;
+    if(cache.needsRebuild(textureSector, where, scale, alpha)) {
+        cache.rebuild(sPtr, textureSector, where, scale, alpha);
+    }
+    
     for(unsigned char t = 0; t < nTextures; t++) {
-        bool drawSector0 = true;
-        if(!textureSector[0]) drawSector0 = false;
-        else if(textureSector[0]->isBottomlessPit) {
-            drawSector0 = false;
-        }
-        
-        if(nTextures == 2 && !drawSector0 && t == 0) {
-            //Allows fading into the void.
-            continue;
-        }
-        
-        if(!textureSector[t] || textureSector[t]->isBottomlessPit) {
-            continue;
-        }
-        
-        size_t nVertexes = sPtr->triangles.size() * 3;
-        ALLEGRO_VERTEX* av = new ALLEGRO_VERTEX[nVertexes];
-        
-        SectorTexture* textureInfoToUse =
-            &textureSector[t]->textureInfo;
-            
-        //Texture transformations.
-        ALLEGRO_TRANSFORM tra;
-        al_build_transform(
-            &tra,
-            -textureInfoToUse->tf.trans.x,
-            -textureInfoToUse->tf.trans.y,
-            1.0f / textureInfoToUse->tf.scale.x,
-            1.0f / textureInfoToUse->tf.scale.y,
-            -textureInfoToUse->tf.rot
-        );
-        
-        for(size_t v = 0; v < nVertexes; v++) {
-            const Triangle* tPtr = &sPtr->triangles[floor(v / 3.0)];
-            Vertex* vPtr = tPtr->points[v % 3];
-            float vx = vPtr->x;
-            float vy = vPtr->y;
-            
-            float alphaMult = 1;
-            float brightnessMult = textureSector[t]->brightness / 255.0f;
-            
-            if(t == 1) {
-                if(!drawSector0) {
-                    alphaMult = 0;
-                    forIdx(e, textureSector[1]->edges) {
-                        if(
-                            textureSector[1]->edges[e]->vertexes[0] == vPtr ||
-                            textureSector[1]->edges[e]->vertexes[1] == vPtr
-                        ) {
-                            alphaMult = 1;
-                        }
-                    }
-                } else {
-                    forIdx(e, textureSector[0]->edges) {
-                        if(
-                            textureSector[0]->edges[e]->vertexes[0] == vPtr ||
-                            textureSector[0]->edges[e]->vertexes[1] == vPtr
-                        ) {
-                            alphaMult = 0;
-                        }
-                    }
-                }
-            }
-            
-            av[v].x = vx - where.x;
-            av[v].y = vy - where.y;
-            if(textureSector[t]) al_transform_coordinates(&tra, &vx, &vy);
-            av[v].u = vx;
-            av[v].v = vy;
-            av[v].z = 0;
-            av[v].color =
-                multAlpha(
-                    tintColor(
-                        textureSector[t]->textureInfo.tint,
-                        mapGray(brightnessMult * 255)
-                    ),
-                    alphaMult * alpha
-                );
-        }
-        
-        for(size_t v = 0; v < nVertexes; v++) {
-            av[v].x *= scale;
-            av[v].y *= scale;
-        }
-        
-        ALLEGRO_BITMAP* tex =
-            textureSector[t] ?
-            textureSector[t]->textureInfo.bitmap :
-            textureSector[t == 0 ? 1 : 0]->textureInfo.bitmap;
-            
+        if(!cache.bitmaps[t]) continue;
         al_draw_prim(
-            av, nullptr, tex,
-            0, (int) nVertexes, ALLEGRO_PRIM_TRIANGLE_LIST
+            cache.vertexes[t].data(), nullptr, cache.bitmaps[t],
+            0, (int) cache.vertexes[t].size(), ALLEGRO_PRIM_TRIANGLE_LIST
         );
-        
-        delete[] av;
     }
 }
 
@@ -29,11 +29,12 @@
  *
  * @param caches List of caches to fetch edge info from.
  * @param eIdx Index of the edge whose effects to draw.
- * @param view Viewport to draw to.
+ * @param worldToBuffer Transformation for converting world coordinates
+ * to buffer coordinates.
  */
 void drawEdgeOffsetOnBuffer(
     const vector<EdgeOffsetCache>& caches, size_t eIdx,
-    const Viewport& view
+    const ALLEGRO_TRANSFORM& worldToBuffer
 ) {
     //Keep the end alpha as a constant, since changing it helps with
     //engine debugging.
@@ -133,9 +134,7 @@ void drawEdgeOffsetOnBuffer(
     
     //Let's transform the "rectangle" coordinates for the buffer.
     for(unsigned char v = 0; v < 4; v++) {
-        al_transform_coordinates(
-            &view.worldToWindowTransform, &av[v].x, &av[v].y
-        );
+        al_transform_coordinates(&worldToBuffer, &av[v].x, &av[v].y);
     }
     
     //Draw the "rectangle"!
@@ -167,7 +166,7 @@ void drawEdgeOffsetOnBuffer(
             elbowAV[e][v + 2].color = endColors[e];
             elbowAV[e][v + 2].color.a = END_ALPHA;
             al_transform_coordinates(
-                &view.worldToWindowTransform,
+                &worldToBuffer,
                 &elbowAV[e][v + 2].x, &elbowAV[e][v + 2].y
             );
         }
@@ -232,6 +231,33 @@ void drawSectorEdgeOffsets(
 }
 
 
+/**
+ * @brief Returns the bounding box of an edge's offset effect.
+ * The box may be a bit larger than the effect itself.
+ *
+ * @param cache Cache with the edge's effect info.
+ * @param ePtr The edge.
+ * @param outBBox The bounding box is returned here.
+ * @return Whether the edge has an effect at all.
+ */
+bool getEdgeOffsetBBox(
+    const EdgeOffsetCache& cache, const Edge* ePtr, RectCorners* outBBox
+) {
+    if(cache.lengths[0] == 0.0f && cache.lengths[1] == 0.0f) return false;
+    
+    float reach =
+        std::max(
+            std::max(cache.lengths[0], cache.lengths[1]),
+            std::max(cache.elbowLengths[0], cache.elbowLengths[1])
+        );
+    *outBBox = RectCorners(v2p(ePtr->vertexes[0]), v2p(ePtr->vertexes[0]));
+    updateMinMaxCoords(*outBBox, v2p(ePtr->vertexes[1]));
+    outBBox->tl -= reach;
+    outBBox->br += reach;
+    return true;
+}
+
+
 /**
  * @brief Returns information about one of the ends of an edge offset effect.
  *
@@ -709,7 +735,7 @@ void updateOffsetEffectBuffer(
     }
     
     for(size_t eIdx : edges) {
-        drawEdgeOffsetOnBuffer(caches, eIdx, view);
+        drawEdgeOffsetOnBuffer(caches, eIdx, view.worldToWindowTransform);
     }
     
     //Return to the old state of things.
@@ -729,21 +755,48 @@ void updateOffsetEffectBuffer(
  *  will be affected by the effect, and which won't.
  * @param lengthGetter Function that returns the length of the effect.
  * @param colorGetter Function that returns the color of the effect.
+ * @param outChangedRegion If not nullptr, the region covered by the updated
+ * edges' effects, both before and after the update, is returned here.
+ * Its corners are the same if no effect was involved.
  */
 void updateOffsetEffectCaches (
     vector<EdgeOffsetCache>& caches,
     const unordered_set<Vertex*>& vertexesToUpdate,
     OffsetEffectChecker checker,
     OffsetEffectLengthGetter lengthGetter,
-    OffsetEffectColorGetter colorGetter
+    OffsetEffectColorGetter colorGetter,
+    RectCorners* outChangedRegion
 ) {
     unordered_set<size_t> edgesToUpdate;
     for(Vertex* v : vertexesToUpdate) {
         edgesToUpdate.insert(v->edgeIdxs.begin(), v->edgeIdxs.end());
     }
     
+    bool changedAny = false;
+    auto addToChangedRegion =
+    [&caches, &changedAny, outChangedRegion] (size_t e) {
+        if(!outChangedRegion) return;
+        RectCorners effectBBox;
+        if(
+            !getEdgeOffsetBBox(
+                caches[e], game.curArea->edges[e], &effectBBox
+            )
+        ) {
+            return;
+        }
+        if(!changedAny) {
+            *outChangedRegion = effectBBox;
+            changedAny = true;
+        } else {
+            updateMinMaxCoords(*outChangedRegion, effectBBox.tl);
+            updateMinMaxCoords(*outChangedRegion, effectBBox.br);
+        }
+    };
+    if(outChangedRegion) *outChangedRegion = RectCorners();
+    
     for(size_t e : edgesToUpdate) {
         Edge* ePtr = game.curArea->edges[e];
+        addToChangedRegion(e);
         
         Sector* unaffectedSector = nullptr;
         Sector* affectedSector = nullptr;
@@ -804,5 +857,7 @@ void updateOffsetEffectCaches (
             caches[e].elbowAngles[end] = normalizeAngle(elbowAngle);
             caches[e].elbowLengths[end] = elbowLength;
         }
+        
+        addToChangedRegion(e);
     }
 }
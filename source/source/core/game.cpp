@@ -20,6 +20,7 @@
 #include "../lib/imgui/imgui_impl_allegro5.h"
 #include "../util/allegro_utils.hpp"
 #include "../util/general_utils.hpp"
+#include "../util/string_utils.hpp"
 #include "drawing.hpp"
 #include "init.hpp"
 #include "load.hpp"
@@ -145,6 +146,22 @@ void Game::drawFramerateChart(int y) const {
 }
 
 
+/**
+ * @brief Finishes recording the player's inputs in gameplay, if they were
+ * being recorded, and saves the recording to its file.
+ */
+void Game::finishInputRecording() {
+    if(!inputRecording.active) return;
+    
+    inputRecording.active = false;
+    if(!inputRecording.replay.saveToFile(inputRecording.outputPath)) {
+        std::cout << "Could not write the input replay to \"";
+        std::cout << inputRecording.outputPath << "\"!" << std::endl;
+    }
+    inputRecording.replay.clear();
+}
+
+
 /**
  * @brief Returns the name of the current state.
  *
@@ -426,6 +443,11 @@ void Game::mainLoop() {
                 GameState* prevState = curState;
                 
                 controls.newFrame(deltaT);
+                if(inputRecording.active && curState == states.gameplay) {
+                    inputRecording.replay.addFrame(
+                        deltaT, mouseCursor.winPos, controls.actionQueue
+                    );
+                }
                 globalLogicPre();
                 curState->doLogic();
                 globalLogicPost();
@@ -454,6 +476,56 @@ void Game::mainLoop() {
 }
 
 
+/**
+ * @brief Parses the arguments the program was started with.
+ *
+ * The following arguments are supported:
+ * --benchmark <area folder path>: Instead of going to the title screen,
+ * load the area and run its gameplay logic as a benchmark.
+ * --frames <number>: How many frames of logic the benchmark runs.
+ * --seed <number>: Seed for the randomness manager in the benchmark.
+ * --output <file path>: File to write the benchmark results to.
+ * --input-replay <file path>: Run the benchmark by playing back an
+ * input replay. The area and seed come from the replay.
+ * --draw: Also draw each frame of the benchmark.
+ * --record-input <file path>: Record the player's inputs in gameplay to
+ * an input replay file.
+ *
+ * Unknown or incomplete arguments are reported and ignored, since some
+ * platforms pass arguments of their own to the program.
+ *
+ * @param argc Command line argument count.
+ * @param argv Command line argument values.
+ */
+void Game::parseCommandLine(int argc, char** argv) {
+    for(int a = 1; a < argc; a++) {
+        string arg = argv[a];
+        bool hasValue = a + 1 < argc;
+        
+        if(arg == "--benchmark" && hasValue) {
+            benchmark.enabled = true;
+            benchmark.areaPath = argv[++a];
+        } else if(arg == "--frames" && hasValue) {
+            benchmark.nrFrames = std::max(1, s2i(argv[++a]));
+        } else if(arg == "--seed" && hasValue) {
+            benchmark.seed = s2i(argv[++a]);
+        } else if(arg == "--output" && hasValue) {
+            benchmark.outputPath = argv[++a];
+        } else if(arg == "--input-replay" && hasValue) {
+            benchmark.enabled = true;
+            benchmark.inputReplayPath = argv[++a];
+        } else if(arg == "--draw") {
+            benchmark.draw = true;
+        } else if(arg == "--record-input" && hasValue) {
+            inputRecording.outputPath = argv[++a];
+        } else {
+            std::cout << "Ignoring unknown or incomplete command line ";
+            std::cout << "argument \"" << arg << "\"." << std::endl;
+        }
+    }
+}
+
+
 /**
  * @brief Processes the system information visualizer for this frame.
  */
@@ -646,6 +718,138 @@ void Game::registerAudioStreamSource(ALLEGRO_AUDIO_STREAM* stream) {
 }
 
 
+/**
+ * @brief Runs the gameplay logic benchmark. This loads the benchmark's area
+ * and runs its gameplay logic for a set number of frames, each with the same
+ * time step, and with a fixed randomness seed. Nothing gets drawn, unless
+ * asked to.
+ * If there's an input replay to play back, the area, seed, and number of
+ * frames come from it instead, and each frame gets the time step and the
+ * player inputs that were recorded.
+ * The performance monitor information, the wall-clock times, and a checksum
+ * of the final gameplay state are then written to the benchmark's
+ * output file.
+ *
+ * @return 0 if everything went well, or an error number otherwise.
+ */
+int Game::runBenchmark() {
+    //Load the input replay.
+    InputReplay inputReplay;
+    if(!benchmark.inputReplayPath.empty()) {
+        if(!inputReplay.loadFromFile(benchmark.inputReplayPath)) {
+            std::cout << "Could not load the input replay \"";
+            std::cout << benchmark.inputReplayPath << "\"!" << std::endl;
+            return 1;
+        }
+        benchmark.areaPath = inputReplay.areaPath;
+        benchmark.seed = inputReplay.seed;
+        benchmark.nrFrames = inputReplay.frames.size();
+    }
+    
+    //Load the area.
+    rng.init(benchmark.seed);
+    states.gameplay->pathOfAreaToLoad = benchmark.areaPath;
+    double loadStartTime = al_get_time();
+    changeState(states.gameplay);
+    double loadDuration = al_get_time() - loadStartTime;
+    
+    if(curState != states.gameplay) {
+        std::cout << "Could not load the area \"" << benchmark.areaPath;
+        std::cout << "\" for the benchmark!" << std::endl;
+        return 1;
+    }
+    
+    //Run the frames.
+    double frameDeltaT = 1.0 / options.advanced.targetFps;
+    double logicDuration = 0.0;
+    double fastestFrameDuration = 0.0;
+    double slowestFrameDuration = 0.0;
+    size_t nrFramesRun = 0;
+    
+    for(; nrFramesRun < benchmark.nrFrames; nrFramesRun++) {
+        if(curState != states.gameplay) {
+            //The gameplay ended early, like from a mission ending.
+            break;
+        }
+        
+        double frameStartTime = al_get_time();
+        
+        const InputReplayFrame* replayFrame =
+            nrFramesRun < inputReplay.frames.size() ?
+            &inputReplay.frames[nrFramesRun] :
+            nullptr;
+        deltaT = replayFrame ? replayFrame->deltaT : frameDeltaT;
+        timePassed += deltaT;
+        controls.newFrame(deltaT);
+        if(replayFrame) {
+            controls.actionQueue = replayFrame->actions;
+            mouseCursor.winPos = replayFrame->mouseCursorWinPos;
+        }
+        globalLogicPre();
+        curState->doLogic();
+        globalLogicPost();
+        
+        if(benchmark.draw && curState == states.gameplay) {
+            curState->doDrawing();
+            globalDrawing();
+            al_flip_display();
+        } else {
+            ImGui::EndFrame();
+            if(perfMon && curState == states.gameplay) {
+                //Normally this would happen in the drawing step.
+                perfMon->leaveState();
+            }
+        }
+        
+        double frameDuration = al_get_time() - frameStartTime;
+        logicDuration += frameDuration;
+        if(nrFramesRun == 0 || frameDuration < fastestFrameDuration) {
+            fastestFrameDuration = frameDuration;
+        }
+        if(nrFramesRun == 0 || frameDuration > slowestFrameDuration) {
+            slowestFrameDuration = frameDuration;
+        }
+    }
+    
+    //Save the results.
+    DataNode resultsFile("", "");
+    GetterWriter rGW(&resultsFile);
+    
+    rGW.write("engine_version", getEngineVersionString(true, true));
+    rGW.write("area", benchmark.areaPath);
+    rGW.write("seed", benchmark.seed);
+    rGW.write("frame_delta_t", frameDeltaT);
+    rGW.write("frames_requested", benchmark.nrFrames);
+    rGW.write("frames_run", nrFramesRun);
+    rGW.write("loading_time", loadDuration);
+    rGW.write("logic_time_total", logicDuration);
+    rGW.write(
+        "logic_time_average",
+        nrFramesRun > 0 ? logicDuration / nrFramesRun : 0.0
+    );
+    rGW.write("logic_time_fastest", fastestFrameDuration);
+    rGW.write("logic_time_slowest", slowestFrameDuration);
+    if(!benchmark.inputReplayPath.empty()) {
+        rGW.write("input_replay", benchmark.inputReplayPath);
+    }
+    rGW.write("drawing", benchmark.draw);
+    if(curState == states.gameplay) {
+        rGW.write("state_checksum", states.gameplay->getLogicChecksum());
+    }
+    if(perfMon) {
+        perfMon->saveToDataNode(resultsFile.addNew("performance_monitor"));
+    }
+    
+    if(!resultsFile.saveFile(benchmark.outputPath, true, true)) {
+        std::cout << "Could not write the benchmark results to \"";
+        std::cout << benchmark.outputPath << "\"!" << std::endl;
+        return 1;
+    }
+    
+    return 0;
+}
+
+
 /**
  * @brief Shuts down the program, cleanly freeing everything.
  */
@@ -760,10 +964,15 @@ int Game::start() {
     
     dummyFsmState = new FsmStateDef("dummy");
     
-    if(makerTools.usePerfMon) {
+    if(makerTools.usePerfMon || benchmark.enabled) {
         perfMon = new PerformanceMonitor();
     }
     
+    if(benchmark.enabled) {
+        //The benchmark runner takes care of entering gameplay.
+        return 0;
+    }
+    
     //Auto-start in some state.
     if(
         makerTools.enabled &&
@@ -812,6 +1021,24 @@ int Game::start() {
 }
 
 
+/**
+ * @brief Starts recording the player's inputs in gameplay, if that was
+ * asked for from the command line. This must be called right before
+ * the area starts loading, so the randomness manager's state is the one
+ * the session started with.
+ *
+ * @param areaPath Path of the folder of the area being played.
+ */
+void Game::startInputRecording(const string& areaPath) {
+    if(inputRecording.outputPath.empty()) return;
+    
+    inputRecording.replay.clear();
+    inputRecording.replay.areaPath = areaPath;
+    inputRecording.replay.seed = rng.state;
+    inputRecording.active = true;
+}
+
+
 /**
  * @brief Unloads a loaded state that never got to be unloaded. This should only
  * be the case if changeState was called with instructions to not
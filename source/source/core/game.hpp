@@ -32,6 +32,7 @@
 #include "misc_structs.hpp"
 #include "modal_gui.hpp"
 #include "options.hpp"
+#include "replay.hpp"
 #include "shaders.hpp"
 
 
@@ -143,6 +144,9 @@ public:
     //Auxiliary data used by the current script that is running.
     ScriptExecutionAuxData scriptExecAuxData;
     
+    //IDs of all script var names in use.
+    ScriptVarNameManager scriptVarNames;
+    
     //Error manager.
     ErrorManager errors;
     
@@ -183,6 +187,9 @@ public:
     //Info on every edge's liquid limit offset effect. Cache for performance.
     vector<EdgeOffsetCache> liquidLimitEffectCaches;
     
+    //Liquid limit effects of the current area, pre-drawn in tiles.
+    EdgeOffsetTiles liquidLimitEffectTiles;
+    
     //Loading screen subtext buffer.
     ALLEGRO_BITMAP* loadingSubtextBmp = nullptr;
     
@@ -256,6 +263,10 @@ public:
     //Info on every edge's wall smoothing offset effect. Cache for performance.
     vector<EdgeOffsetCache> wallSmoothingEffectCaches;
     
+    //Wall shadow and ledge smoothing effects of the current area,
+    //pre-drawn in tiles.
+    EdgeOffsetTiles wallOffsetEffectTiles;
+    
     //Current fullscreen state.
     bool winFullscreen = OPTIONS::GRAPHICS_D::WIN_FULLSCREEN;
     
@@ -287,6 +298,53 @@ public:
         
     } quickPlay;
     
+    //Data for when the game is running a gameplay logic benchmark
+    //from the command line.
+    struct {
+        
+        //--- Public members ---
+        
+        //Is the benchmark mode enabled?
+        bool enabled = false;
+        
+        //Path of the folder of the area to benchmark.
+        string areaPath;
+        
+        //How many frames of gameplay logic to run.
+        size_t nrFrames = 3600;
+        
+        //Seed to initialize the randomness manager with.
+        int32_t seed = 0;
+        
+        //Path of the file to write the results to.
+        string outputPath = FILE_PATHS_FROM_ROOT::BENCHMARK_RESULTS;
+        
+        //Path of an input replay to play back. If empty, the area runs
+        //without any player input.
+        string inputReplayPath;
+        
+        //Whether to also draw each frame.
+        bool draw = false;
+        
+    } benchmark;
+    
+    //Data for when the player's inputs in gameplay are being recorded,
+    //as asked from the command line.
+    struct {
+        
+        //--- Public members ---
+        
+        //Path of the file to save the recording to. Empty if not recording.
+        string outputPath;
+        
+        //Is a gameplay session being recorded right now?
+        bool active = false;
+        
+        //The recording.
+        InputReplay replay;
+        
+    } inputRecording;
+    
     //Engine debugging tools.
     struct {
     
@@ -320,8 +378,12 @@ public:
     void unloadLoadedState(GameState* loadedState);
     void registerAudioStreamSource(ALLEGRO_AUDIO_STREAM* stream);
     void unregisterAudioStreamSource(ALLEGRO_AUDIO_STREAM* stream);
+    void parseCommandLine(int argc, char** argv);
     int start();
     void mainLoop();
+    int runBenchmark();
+    void startInputRecording(const string& areaPath);
+    void finishInputRecording();
     void shutdown();
     
 private:
@@ -1007,6 +1007,14 @@ void initEssentials() {
     signal(SIGILL,  signalHandler);
     signal(SIGSEGV, signalHandler);
     signal(SIGABRT, signalHandler);
+    
+    //Data files.
+    //Only the game data gets cached. User data like options or area
+    //backups changes too often for it to be worth it.
+    DataNode::setCacheFolder(
+        FOLDER_PATHS_FROM_ROOT::DATA_FILE_CACHE,
+        FOLDER_PATHS_FROM_ROOT::GAME_DATA
+    );
 }
 
 
@@ -1842,6 +1850,7 @@ void initScriptActionTypes() {
     const COMMAND_PARAM_FLAG pfConst = COMMAND_PARAM_FLAG_CONST;
     const COMMAND_PARAM_FLAG pfOpt = COMMAND_PARAM_FLAG_OPTIONAL;
     const COMMAND_PARAM_FLAG pfVector = COMMAND_PARAM_FLAG_VECTOR;
+    const COMMAND_PARAM_FLAG pfVarName = COMMAND_PARAM_FLAG_VAR_NAME;
     
     
     //-Common actions-
@@ -1857,7 +1866,7 @@ void initScriptActionTypes() {
     );
     
     //Absolute number.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("number", ptFloat);
     commitAction(
         SCRIPT_ACTION_ABSOLUTE_NUMBER,
@@ -1866,7 +1875,7 @@ void initScriptActionTypes() {
     );
     
     //Add list item.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("list or string", ptString);
     queueParam("new item", ptString);
     queueParam("item number", ptInt, pfOpt, "0");
@@ -1878,7 +1887,7 @@ void initScriptActionTypes() {
     );
     
     //Add to string.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("base string", ptString);
     queueParam("content to add", ptString);
     queueParam("add a space between", ptBool, pfOpt, "false");
@@ -1889,7 +1898,7 @@ void initScriptActionTypes() {
     );
     
     //Calculate.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("left operand", ptFloat);
     queueParam("operation", ptEnum, pfConst);
     queueParam("right operand", ptFloat);
@@ -1900,7 +1909,7 @@ void initScriptActionTypes() {
     );
     
     //Clear var.
-    queueParam("var name", ptString, pfConst);
+    queueParam("var name", ptString, pfConst | pfVarName);
     commitAction(
         SCRIPT_ACTION_CLEAR_VAR,
         "clear_var",
@@ -1908,7 +1917,7 @@ void initScriptActionTypes() {
     );
     
     //Ceil number.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("number", ptFloat);
     commitAction(
         SCRIPT_ACTION_CEIL_NUMBER,
@@ -1917,7 +1926,7 @@ void initScriptActionTypes() {
     );
     
     //Clamp number.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("number", ptFloat);
     queueParam("lower bound", ptFloat);
     queueParam("upper bound", ptFloat);
@@ -1935,7 +1944,7 @@ void initScriptActionTypes() {
     );
     
     //Ease number.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("number", ptFloat);
     queueParam("method", ptEnum);
     commitAction(
@@ -2016,7 +2025,7 @@ void initScriptActionTypes() {
     );
     
     //Start for loop.
-    queueParam("iterator var name", ptString, pfConst);
+    queueParam("iterator var name", ptString, pfConst | pfVarName);
     queueParam("target amount", ptInt);
     queueParam("starting amount", ptInt, pfOpt, "1");
     queueParam("jump", ptInt, pfOpt, "1");
@@ -2027,8 +2036,8 @@ void initScriptActionTypes() {
     );
     
     //Start for each loop.
-    queueParam("iterator var name", ptString, pfConst);
-    queueParam("item var name", ptString, pfConst);
+    queueParam("iterator var name", ptString, pfConst | pfVarName);
+    queueParam("item var name", ptString, pfConst | pfVarName);
     queueParam("list or string", ptString);
     queueParam("list delimiter", ptEnum, pfOpt, "comma");
     commitAction(
@@ -2038,7 +2047,7 @@ void initScriptActionTypes() {
     );
     
     //Get angle.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("center x", ptFloat);
     queueParam("center y", ptFloat);
     queueParam("target x", ptFloat);
@@ -2050,7 +2059,7 @@ void initScriptActionTypes() {
     );
     
     //Get angle clockwise difference.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("angle 1", ptFloat);
     queueParam("angle 2", ptFloat);
     commitAction(
@@ -2060,7 +2069,7 @@ void initScriptActionTypes() {
     );
     
     //Get angle smallest difference.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("angle 1", ptFloat);
     queueParam("angle 2", ptFloat);
     commitAction(
@@ -2071,7 +2080,7 @@ void initScriptActionTypes() {
     
     //DEPRECATED in 1.2.0 by "get_misc_info".
     //Get area info.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("info", ptString);
     commitAction(
         SCRIPT_ACTION_GET_AREA_INFO,
@@ -2080,8 +2089,8 @@ void initScriptActionTypes() {
     );
     
     //Get coordinates from angle.
-    queueParam("x destination var name", ptString, pfConst);
-    queueParam("y destination var name", ptString, pfConst);
+    queueParam("x destination var name", ptString, pfConst | pfVarName);
+    queueParam("y destination var name", ptString, pfConst | pfVarName);
     queueParam("angle", ptFloat);
     queueParam("distance", ptFloat);
     commitAction(
@@ -2091,7 +2100,7 @@ void initScriptActionTypes() {
     );
     
     //Get distance.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("center x", ptFloat);
     queueParam("center y", ptFloat);
     queueParam("target x", ptFloat);
@@ -2103,7 +2112,7 @@ void initScriptActionTypes() {
     );
     
     //Get event info.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("info", ptString);
     commitAction(
         SCRIPT_ACTION_GET_EVENT_INFO,
@@ -2112,8 +2121,8 @@ void initScriptActionTypes() {
     );
     
     //Get focus var.
-    queueParam("destination var name", ptString, pfConst);
-    queueParam("focused mob's var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
+    queueParam("focused mob's var name", ptString, pfConst | pfVarName);
     commitAction(
         SCRIPT_ACTION_GET_FOCUS_VAR,
         "get_focus_var",
@@ -2121,7 +2130,7 @@ void initScriptActionTypes() {
     );
     
     //Get leader Pikmin count var.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("target", ptString);
     queueParam("Pikmin type", ptString, pfOpt);
     commitAction(
@@ -2131,7 +2140,7 @@ void initScriptActionTypes() {
     );
     
     //Get list item.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("list or string", ptString);
     queueParam("item number", ptInt, pfOpt, "0");
     queueParam("list delimiter", ptEnum, pfOpt, "comma");
@@ -2142,7 +2151,7 @@ void initScriptActionTypes() {
     );
     
     //Get list item number.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("list or string", ptString);
     queueParam("item to search", ptInt);
     queueParam("list delimiter", ptEnum, pfOpt, "comma");
@@ -2153,7 +2162,7 @@ void initScriptActionTypes() {
     );
     
     //Get list size.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("list or string", ptString);
     queueParam("list delimiter", ptEnum, pfOpt, "comma");
     commitAction(
@@ -2163,7 +2172,7 @@ void initScriptActionTypes() {
     );
     
     //Get misc. info.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("info", ptString);
     commitAction(
         SCRIPT_ACTION_GET_MISC_INFO,
@@ -2172,7 +2181,7 @@ void initScriptActionTypes() {
     );
     
     //Get mission metric.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("metric", ptEnum);
     queueParam("number data", ptInt, pfOpt, "1");
     queueParam("get auto target instead", ptBool, pfOpt, "false");
@@ -2183,7 +2192,7 @@ void initScriptActionTypes() {
     );
     
     //Get mob IDs in region.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("region number", ptInt);
     commitAction(
         SCRIPT_ACTION_GET_MOB_IDS_IN_REGION,
@@ -2192,8 +2201,8 @@ void initScriptActionTypes() {
     );
     
     //Get mob IDs with var.
-    queueParam("destination var name", ptString, pfConst);
-    queueParam("required var name", ptString);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
+    queueParam("required var name", ptString, pfVarName);
     queueParam("required value", ptString, pfOpt, "");
     commitAction(
         SCRIPT_ACTION_GET_MOB_IDS_WITH_VAR,
@@ -2202,7 +2211,7 @@ void initScriptActionTypes() {
     );
     
     //Get mob info.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("target", ptString);
     queueParam("info", ptString);
     commitAction(
@@ -2212,7 +2221,7 @@ void initScriptActionTypes() {
     );
     
     //Get random float.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("minimum value", ptFloat);
     queueParam("maximum value", ptFloat);
     commitAction(
@@ -2222,7 +2231,7 @@ void initScriptActionTypes() {
     );
     
     //Get random int.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("minimum value", ptInt);
     queueParam("maximum value", ptInt);
     commitAction(
@@ -2232,8 +2241,8 @@ void initScriptActionTypes() {
     );
     
     //Get var presence.
-    queueParam("destination var name", ptString, pfConst);
-    queueParam("var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
+    queueParam("var name", ptString, pfConst | pfVarName);
     commitAction(
         SCRIPT_ACTION_GET_VAR_PRESENCE,
         "get_var_presence",
@@ -2259,7 +2268,7 @@ void initScriptActionTypes() {
     );
     
     //Interpolate number.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("input number", ptFloat);
     queueParam("input start", ptFloat);
     queueParam("input end", ptFloat);
@@ -2280,7 +2289,7 @@ void initScriptActionTypes() {
     );
     
     //Max number.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("first number", ptFloat);
     queueParam("second number", ptFloat);
     commitAction(
@@ -2290,7 +2299,7 @@ void initScriptActionTypes() {
     );
     
     //Min number.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("first number", ptFloat);
     queueParam("second number", ptFloat);
     commitAction(
@@ -2308,7 +2317,7 @@ void initScriptActionTypes() {
     );
     
     //Remove list item.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("list or string", ptString);
     queueParam("item number", ptInt, pfOpt, "0");
     queueParam("list delimiter", ptEnum, pfOpt, "comma");
@@ -2319,7 +2328,7 @@ void initScriptActionTypes() {
     );
     
     //Round number.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("number", ptFloat);
     commitAction(
         SCRIPT_ACTION_ROUND_NUMBER,
@@ -2360,7 +2369,9 @@ void initScriptActionTypes() {
     );
     
     //Set focus var.
-    queueParam("focused mob's destination var name", ptString, pfConst);
+    queueParam(
+        "focused mob's destination var name", ptString, pfConst | pfVarName
+    );
     queueParam("value", ptString);
     commitAction(
         SCRIPT_ACTION_SET_FOCUS_VAR,
@@ -2369,7 +2380,7 @@ void initScriptActionTypes() {
     );
     
     //Set list item.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("list or string", ptString);
     queueParam("new item", ptString);
     queueParam("item number", ptInt, pfOpt, "0");
@@ -2406,7 +2417,7 @@ void initScriptActionTypes() {
     );
     
     //Set var.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("value", ptString);
     commitAction(
         SCRIPT_ACTION_SET_VAR,
@@ -2424,7 +2435,7 @@ void initScriptActionTypes() {
     
     //DEPRECATED in 1.2.0 by "show_cutscene_message".
     //Show cutscene message from var.
-    queueParam("var name", ptString, pfConst);
+    queueParam("var name", ptString, pfConst | pfVarName);
     commitAction(
         SCRIPT_ACTION_SHOW_MESSAGE_FROM_VAR,
         "show_message_from_var",
@@ -2432,7 +2443,7 @@ void initScriptActionTypes() {
     );
     
     //Sign number.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("number", ptFloat);
     commitAction(
         SCRIPT_ACTION_SIGN_NUMBER,
@@ -2441,7 +2452,7 @@ void initScriptActionTypes() {
     );
     
     //Square root number.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("number", ptFloat);
     commitAction(
         SCRIPT_ACTION_SQUARE_ROOT_NUMBER,
@@ -2450,7 +2461,7 @@ void initScriptActionTypes() {
     );
     
     //Truncate number.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("number", ptFloat);
     commitAction(
         SCRIPT_ACTION_TRUNCATE_NUMBER,
@@ -2514,7 +2525,7 @@ void initScriptActionTypes() {
     );
     
     //Floor number.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("number", ptFloat);
     commitAction(
         SCRIPT_ACTION_FLOOR_NUMBER,
@@ -2558,7 +2569,7 @@ void initScriptActionTypes() {
     );
     
     //Get floor Z.
-    queueParam("destination var name", ptString, pfConst);
+    queueParam("destination var name", ptString, pfConst | pfVarName);
     queueParam("x", ptFloat);
     queueParam("y", ptFloat);
     commitAction(
@@ -2630,7 +2641,7 @@ void initScriptActionTypes() {
     
     //Play sound.
     queueParam("sound data", ptEnum);
-    queueParam("sound ID destination var name", ptString, pfOpt);
+    queueParam("sound ID destination var name", ptString, pfOpt | pfVarName);
     commitAction(
         SCRIPT_ACTION_PLAY_SOUND,
         "play_sound",
@@ -80,7 +80,8 @@ ALLEGRO_BITMAP* loadBmp(
         }
     }
     
-    ALLEGRO_BITMAP* b = al_load_bitmap((filePath).c_str());
+    ALLEGRO_BITMAP* b = game.content.claimPrefetchedBitmap(filePath);
+    if(!b) b = al_load_bitmap((filePath).c_str());
     
     if(!b) {
         if(reportError) {
@@ -99,16 +100,27 @@ ALLEGRO_BITMAP* loadBmp(
 
 
 /**
- * @brief Loads a data file from the game's content.
+ * @brief Loads a data file from the game's content. If the file was already
+ * read ahead of time by the content manager, that's used instead.
  *
  * @param filePath Path to the file, relative to the program root folder.
  * @param outSuccess If not nullptr, whether the file was successfully
  * opened or not is returned here.
+ * @param reportError If false, omits error reporting.
  */
-DataNode loadDataFile(const string& filePath, bool* outSuccess) {
+DataNode loadDataFile(
+    const string& filePath, bool* outSuccess, bool reportError
+) {
     bool fileWasOpened = false;
-    DataNode node = DataNode(filePath, &fileWasOpened);
-    if(!fileWasOpened) {
+    DataNode node;
+    if(
+        !game.content.claimPrefetchedDataFile(
+            filePath, &node, &fileWasOpened
+        )
+    ) {
+        node.loadFile(filePath, &fileWasOpened);
+    }
+    if(!fileWasOpened && reportError) {
         game.errors.report(
             "Could not open data file \"" + filePath + "\"!"
         );
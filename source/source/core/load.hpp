@@ -33,7 +33,10 @@ ALLEGRO_BITMAP* loadBmp(
     bool reportError = true, bool errorBmpOnError = true,
     bool errorBmpOnEmpty = true
 );
-DataNode loadDataFile(const string& filePath, bool* outSuccess = nullptr);
+DataNode loadDataFile(
+    const string& filePath, bool* outSuccess = nullptr,
+    bool reportError = true
+);
 void loadMakerTools();
 ALLEGRO_FONT* loadFont(
     const string& fileName, int n, const int ranges[], int size
@@ -55,14 +55,15 @@ bool areWallsBetween(
     RectCorners bBox(p1, p1);
     updateMinMaxCoords(bBox, p2);
     
-    set<Edge*> candidateEdges;
+    vector<size_t>& candidateEdges = game.states.gameplay->edgeQueryBuffer;
     if(!game.curArea->bmap.getEdgesInRect(bBox, candidateEdges)) {
         //Somehow out of bounds.
         if(outImpassableWalls) *outImpassableWalls = true;
         return true;
     }
     
-    for(auto const& ePtr : candidateEdges) {
+    forIdx(e, candidateEdges) {
+        Edge* ePtr = game.curArea->edges[candidateEdges[e]];
         if(
             !lineSegsIntersect(
                 p1, p2,
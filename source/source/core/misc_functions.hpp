@@ -88,11 +88,15 @@ bool doesEdgeHaveWallShadow(
     Edge* ePtr, Sector** outAffectedSector, Sector** outUnaffectedSector
 );
 void drawEdgeOffsetOnBuffer(
-    const vector<EdgeOffsetCache>& caches, size_t eIdx, const Viewport& view
+    const vector<EdgeOffsetCache>& caches, size_t eIdx,
+    const ALLEGRO_TRANSFORM& worldToBuffer
 );
 Mob* getClosestMobToMouseCursor(
     const Viewport& view, bool mustHaveHealth = false
 );
+bool getEdgeOffsetBBox(
+    const EdgeOffsetCache& cache, const Edge* ePtr, RectCorners* outBBox
+);
 void getEdgeOffsetEdgeInfo(
     Edge* ePtr, Vertex* endVertex, unsigned char endIdx,
     float edgeProcessAngle,
@@ -227,7 +231,8 @@ void updateOffsetEffectCaches (
     const unordered_set<Vertex*>& vertexesToUpdate,
     OffsetEffectChecker checker,
     OffsetEffectLengthGetter lengthGetter,
-    OffsetEffectColorGetter colorGetter
+    OffsetEffectColorGetter colorGetter,
+    RectCorners* outChangedRegion = nullptr
 );
 bool validateCommandParams(
     const vector<CommandParam>& params, const string& context
@@ -115,6 +115,24 @@ const float TOKEN_SWIPE_Y_AMOUNT = -15.0f;
 }
 
 
+namespace EDGE_OFFSET_TILES {
+
+//Maximum number of tiles that get drawn anew in one composition. Other
+//visible tiles that need it wait for the next ones.
+const size_t MAX_REDRAWS_PER_COMPOSE = 4;
+
+//Maximum number of tiles, from all levels, kept in memory. The ones that
+//were visible the longest time ago get freed first. Each one takes 1 MiB.
+//This is enough for a 1080p window at any zoom, so the visible tiles
+//only go over it on bigger windows.
+const size_t MAX_RESIDENT_TILES = 64;
+
+//Width and height of each tile's bitmap, in pixels.
+const int TILE_BMP_SIZE = 512;
+
+}
+
+
 namespace MOUSE_CURSOR {
 
 //How quickly to lower the mouse cursor's alpha, if we're hiding the cursor
@@ -401,6 +419,503 @@ CommandParam::CommandParam(
 }
 
 
+#pragma endregion
+#pragma region Edge offset tiles
+
+
+/**
+ * @brief Destroys the edge offset tiles object.
+ */
+EdgeOffsetTiles::~EdgeOffsetTiles() {
+    clear();
+}
+
+
+/**
+ * @brief Destroys all tiles and forgets the effect caches.
+ */
+void EdgeOffsetTiles::clear() {
+    forIdx(l, levels) {
+        forIdx(t, levels[l].tiles) {
+            if(levels[l].tiles[t]) al_destroy_bitmap(levels[l].tiles[t]);
+        }
+    }
+    forIdx(b, spareBitmaps) {
+        al_destroy_bitmap(spareBitmaps[b]);
+    }
+    levels.clear();
+    spareBitmaps.clear();
+    layers.clear();
+    effectReach = 0.0f;
+    nrResidentTiles = 0;
+    nrComposes = 0;
+}
+
+
+/**
+ * @brief Copies the tiles visible in a viewport onto an effect buffer,
+ * so that sectors may then sample from it to draw what effects they need.
+ * The level of tiles used depends on the viewport's zoom. A few of the
+ * visible tiles that need it get drawn again first. The ones that can't
+ * yet are covered by a less detailed level's tile in the meantime.
+ * Finally, if there are too many tiles in memory, the ones that went
+ * unused the longest get freed.
+ *
+ * @param buffer Buffer to draw to.
+ * @param view Viewport to draw for.
+ */
+void EdgeOffsetTiles::compose(ALLEGRO_BITMAP* buffer, const Viewport& view) {
+    if(levels.empty()) return;
+    
+    size_t levelIdx = pickLevel(view.cam.zoom);
+    Level& level = levels[levelIdx];
+    float fromX = (view.worldCorners.tl.x - topLeftCorner.x) / level.tileSize;
+    float toX = (view.worldCorners.br.x - topLeftCorner.x) / level.tileSize;
+    float fromY = (view.worldCorners.tl.y - topLeftCorner.y) / level.tileSize;
+    float toY = (view.worldCorners.br.y - topLeftCorner.y) / level.tileSize;
+    size_t fromCol =
+        std::clamp(floor(fromX), 0.0f, (float) (level.nCols - 1));
+    size_t toCol = std::clamp(floor(toX), 0.0f, (float) (level.nCols - 1));
+    size_t fromRow =
+        std::clamp(floor(fromY), 0.0f, (float) (level.nRows - 1));
+    size_t toRow = std::clamp(floor(toY), 0.0f, (float) (level.nRows - 1));
+    
+    nrComposes++;
+    size_t redrawsLeft = EDGE_OFFSET_TILES::MAX_REDRAWS_PER_COMPOSE;
+    for(size_t r = fromRow; r <= toRow; r++) {
+        for(size_t c = fromCol; c <= toCol; c++) {
+            size_t tIdx = r * level.nCols + c;
+            level.lastComposes[tIdx] = nrComposes;
+            if(level.dirty[tIdx] && redrawsLeft > 0) {
+                redrawTile(level, c, r);
+                redrawsLeft--;
+            }
+        }
+    }
+    
+    //Save the current state of some things.
+    ALLEGRO_BITMAP* prevTargetBmp = al_get_target_bitmap();
+    AllegroBlenderState prevBlender;
+    prevBlender.save();
+    
+    //Set the new operation modes. Tiles don't overlap, so they can
+    //just replace what's on the buffer.
+    al_set_target_bitmap(buffer);
+    ALLEGRO_TRANSFORM prevTransform;
+    al_copy_transform(&prevTransform, al_get_current_transform());
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+    al_clear_to_color(COLOR_EMPTY);
+    
+    //Draw!
+    for(size_t r = fromRow; r <= toRow; r++) {
+        for(size_t c = fromCol; c <= toCol; c++) {
+            size_t tIdx = r * level.nCols + c;
+            RectCorners corners = getTileCorners(level, c, r);
+            if(level.tiles[tIdx] || !level.dirty[tIdx]) {
+                drawTileRegion(level, c, r, corners, view);
+                continue;
+            }
+            
+            //This tile isn't drawn yet. Use the part of a less detailed
+            //tile that covers it, if any.
+            for(size_t l = levelIdx + 1; l < levels.size(); l++) {
+                Level& coarseLevel = levels[l];
+                size_t coarseCol =
+                    std::min(
+                        (size_t) (
+                            (corners.tl.x - topLeftCorner.x) /
+                            coarseLevel.tileSize
+                        ),
+                        coarseLevel.nCols - 1
+                    );
+                size_t coarseRow =
+                    std::min(
+                        (size_t) (
+                            (corners.tl.y - topLeftCorner.y) /
+                            coarseLevel.tileSize
+                        ),
+                        coarseLevel.nRows - 1
+                    );
+                size_t coarseIdx = coarseRow * coarseLevel.nCols + coarseCol;
+                if(coarseLevel.tiles[coarseIdx]) {
+                    coarseLevel.lastComposes[coarseIdx] = nrComposes;
+                    drawTileRegion(
+                        coarseLevel, coarseCol, coarseRow, corners, view
+                    );
+                    break;
+                }
+                if(!coarseLevel.dirty[coarseIdx]) {
+                    //It's up to date and has no effects, so neither
+                    //does this one.
+                    break;
+                }
+            }
+        }
+    }
+    
+    //Return to the old state of things.
+    al_use_transform(&prevTransform);
+    prevBlender.load();
+    al_set_target_bitmap(prevTargetBmp);
+    
+    evictTiles();
+}
+
+
+/**
+ * @brief Draws the part of a tile that's inside a region onto the current
+ * target bitmap. Does nothing if the tile has no bitmap.
+ *
+ * @param level Level of the tile.
+ * @param col Column of the tile.
+ * @param row Row of the tile.
+ * @param region Region to draw, in world coordinates. This must be inside
+ * the tile.
+ * @param view Viewport to draw for.
+ */
+void EdgeOffsetTiles::drawTileRegion(
+    const Level& level, size_t col, size_t row,
+    const RectCorners& region, const Viewport& view
+) {
+    ALLEGRO_BITMAP* tile = level.tiles[row * level.nCols + col];
+    if(!tile) return;
+    
+    RectCorners corners = getTileCorners(level, col, row);
+    ALLEGRO_TRANSFORM tileTransform;
+    al_identity_transform(&tileTransform);
+    al_scale_transform(
+        &tileTransform, 1.0f / level.resolution, 1.0f / level.resolution
+    );
+    al_translate_transform(&tileTransform, corners.tl.x, corners.tl.y);
+    al_compose_transform(&tileTransform, &view.worldToWindowTransform);
+    al_use_transform(&tileTransform);
+    
+    Point srcPos = (region.tl - corners.tl) * level.resolution;
+    Point srcSize = (region.br - region.tl) * level.resolution;
+    al_draw_bitmap_region(
+        tile, srcPos.x, srcPos.y, srcSize.x, srcSize.y,
+        srcPos.x, srcPos.y, 0
+    );
+}
+
+
+/**
+ * @brief If there are too many tiles in memory, frees the ones that were
+ * used the longest time ago. Tiles used in the latest composition are
+ * always kept.
+ */
+void EdgeOffsetTiles::evictTiles() {
+    if(nrResidentTiles <= EDGE_OFFSET_TILES::MAX_RESIDENT_TILES) return;
+    
+    evictionCandidates.clear();
+    forIdx(l, levels) {
+        const Level& level = levels[l];
+        forIdx(t, level.tiles) {
+            if(!level.tiles[t]) continue;
+            if(level.lastComposes[t] == nrComposes) continue;
+            evictionCandidates.push_back({level.lastComposes[t], l, t});
+        }
+    }
+    
+    size_t nrToFree =
+        std::min(
+            nrResidentTiles - EDGE_OFFSET_TILES::MAX_RESIDENT_TILES,
+            evictionCandidates.size()
+        );
+    std::partial_sort(
+        evictionCandidates.begin(),
+        evictionCandidates.begin() + nrToFree,
+        evictionCandidates.end()
+    );
+    for(size_t c = 0; c < nrToFree; c++) {
+        Level& level = levels[std::get<1>(evictionCandidates[c])];
+        size_t tIdx = std::get<2>(evictionCandidates[c]);
+        freeTile(level, tIdx);
+        level.dirty[tIdx] = true;
+    }
+}
+
+
+/**
+ * @brief Frees a tile's bitmap. It's kept around for reuse if there
+ * aren't many spare ones yet.
+ *
+ * @param level Level of the tile.
+ * @param tIdx Index of the tile.
+ */
+void EdgeOffsetTiles::freeTile(Level& level, size_t tIdx) {
+    if(!level.tiles[tIdx]) return;
+    
+    if(spareBitmaps.size() < EDGE_OFFSET_TILES::MAX_REDRAWS_PER_COMPOSE) {
+        spareBitmaps.push_back(level.tiles[tIdx]);
+    } else {
+        al_destroy_bitmap(level.tiles[tIdx]);
+    }
+    level.tiles[tIdx] = nullptr;
+    nrResidentTiles--;
+}
+
+
+/**
+ * @brief Returns the world coordinates of a tile's corners.
+ *
+ * @param level Level of the tile.
+ * @param col Column of the tile.
+ * @param row Row of the tile.
+ * @return The corners.
+ */
+RectCorners EdgeOffsetTiles::getTileCorners(
+    const Level& level, size_t col, size_t row
+) const {
+    Point tl(
+        topLeftCorner.x + col * level.tileSize,
+        topLeftCorner.y + row * level.tileSize
+    );
+    return RectCorners(tl, tl + Point(level.tileSize));
+}
+
+
+/**
+ * @brief Marks the tiles that cover a region as needing to be drawn again,
+ * in all levels. They'll be drawn the next time they are visible.
+ *
+ * @param region Region whose tiles to mark, in world coordinates.
+ */
+void EdgeOffsetTiles::markDirty(const RectCorners& region) {
+    if(region.tl.x == region.br.x && region.tl.y == region.br.y) return;
+    
+    //The effects in the region could now reach farther.
+    updateEffectReach();
+    
+    forIdx(l, levels) {
+        Level& level = levels[l];
+        float fromX = (region.tl.x - topLeftCorner.x) / level.tileSize;
+        float toX = (region.br.x - topLeftCorner.x) / level.tileSize;
+        float fromY = (region.tl.y - topLeftCorner.y) / level.tileSize;
+        float toY = (region.br.y - topLeftCorner.y) / level.tileSize;
+        size_t fromCol =
+            std::clamp(floor(fromX), 0.0f, (float) (level.nCols - 1));
+        size_t toCol =
+            std::clamp(floor(toX), 0.0f, (float) (level.nCols - 1));
+        size_t fromRow =
+            std::clamp(floor(fromY), 0.0f, (float) (level.nRows - 1));
+        size_t toRow =
+            std::clamp(floor(toY), 0.0f, (float) (level.nRows - 1));
+        for(size_t r = fromRow; r <= toRow; r++) {
+            for(size_t c = fromCol; c <= toCol; c++) {
+                level.dirty[r * level.nCols + c] = true;
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief Returns the index of the level of tiles to use for a zoom level.
+ * This is the least detailed level that's still at least as detailed as
+ * the window, so the tiles never get stretched.
+ *
+ * @param zoom Zoom level.
+ * @return The index.
+ */
+size_t EdgeOffsetTiles::pickLevel(float zoom) const {
+    size_t l = 0;
+    while(l + 1 < levels.size() && levels[l + 1].resolution >= zoom) {
+        l++;
+    }
+    return l;
+}
+
+
+/**
+ * @brief Draws a tile's effects anew. If it ends up with no effects,
+ * its bitmap is freed.
+ *
+ * @param level Level of the tile.
+ * @param col Column of the tile.
+ * @param row Row of the tile.
+ */
+void EdgeOffsetTiles::redrawTile(Level& level, size_t col, size_t row) {
+    size_t tIdx = row * level.nCols + col;
+    level.dirty[tIdx] = false;
+    RectCorners corners = getTileCorners(level, col, row);
+    
+    //Find the edges close enough that their effects could reach the tile.
+    //The blockmap can't be queried outside of its bounds, but there are
+    //no edges out there anyway.
+    const Blockmap& bmap = game.curArea->bmap;
+    RectCorners query(corners.tl - effectReach, corners.br + effectReach);
+    Point bmapBR = bmap.getBottomRightCorner() - 1.0f;
+    query.tl.x = std::max(query.tl.x, bmap.topLeftCorner.x);
+    query.tl.y = std::max(query.tl.y, bmap.topLeftCorner.y);
+    query.br.x = std::min(query.br.x, bmapBR.x);
+    query.br.y = std::min(query.br.y, bmapBR.y);
+    tileEdgeIdxs.clear();
+    if(query.tl.x <= query.br.x && query.tl.y <= query.br.y) {
+        bmap.getEdgesInRect(query, tileEdgeIdxs);
+    }
+    
+    const auto reachesTile = [this, &corners] (size_t l, size_t eIdx) {
+        RectCorners effectBBox;
+        if(
+            !getEdgeOffsetBBox(
+                (*layers[l])[eIdx], game.curArea->edges[eIdx], &effectBBox
+            )
+        ) {
+            return false;
+        }
+        return rectanglesIntersect(effectBBox, corners);
+    };
+    
+    bool hasEffects = false;
+    forIdx(l, layers) {
+        forIdx(e, tileEdgeIdxs) {
+            if(reachesTile(l, tileEdgeIdxs[e])) {
+                hasEffects = true;
+                break;
+            }
+        }
+        if(hasEffects) break;
+    }
+    
+    if(!hasEffects) {
+        freeTile(level, tIdx);
+        return;
+    }
+    
+    if(!level.tiles[tIdx]) {
+        if(!spareBitmaps.empty()) {
+            level.tiles[tIdx] = spareBitmaps.back();
+            spareBitmaps.pop_back();
+        } else {
+            level.tiles[tIdx] =
+                al_create_bitmap(
+                    EDGE_OFFSET_TILES::TILE_BMP_SIZE,
+                    EDGE_OFFSET_TILES::TILE_BMP_SIZE
+                );
+        }
+        nrResidentTiles++;
+    }
+    
+    ALLEGRO_TRANSFORM worldToTile;
+    al_identity_transform(&worldToTile);
+    al_translate_transform(&worldToTile, -corners.tl.x, -corners.tl.y);
+    al_scale_transform(&worldToTile, level.resolution, level.resolution);
+    
+    //Save the current state of some things.
+    ALLEGRO_BITMAP* prevTargetBmp = al_get_target_bitmap();
+    AllegroBlenderState prevBlender;
+    prevBlender.save();
+    
+    //Set the new operation modes. These are the same as when drawing
+    //the effects straight onto an effect buffer.
+    al_set_target_bitmap(level.tiles[tIdx]);
+    al_set_separate_blender(
+        ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO,
+        ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA
+    );
+    al_hold_bitmap_drawing(true);
+    
+    //Draw!
+    al_clear_to_color(COLOR_EMPTY);
+    forIdx(l, layers) {
+        forIdx(e, tileEdgeIdxs) {
+            if(!reachesTile(l, tileEdgeIdxs[e])) continue;
+            drawEdgeOffsetOnBuffer(*layers[l], tileEdgeIdxs[e], worldToTile);
+        }
+    }
+    
+    //Return to the old state of things.
+    al_hold_bitmap_drawing(false);
+    prevBlender.load();
+    al_set_target_bitmap(prevTargetBmp);
+}
+
+
+/**
+ * @brief Sets up the tiles to cover the current area. They are only drawn
+ * once they're visible.
+ *
+ * @param layers Caches of each effect to draw on the tiles, in the order
+ * they should be drawn. These must stay alive while the tiles are in use.
+ * @param resolution How many tile pixels there are per world unit, in the
+ * most detailed level. This should be the closest zoom level the camera
+ * can reach, so the tiles never get stretched on the window. Each next
+ * level has half of the previous one's, until one tile covers everything.
+ */
+void EdgeOffsetTiles::setup(
+    const vector<const vector<EdgeOffsetCache>*>& layers, float resolution
+) {
+    clear();
+    this->layers = layers;
+    updateEffectReach();
+    
+    //Find the region covered by the area and all effects. Effects that
+    //show up later on are drawn inward from their edges, so the area's
+    //vertexes should cover them.
+    if(game.curArea->vertexes.empty()) return;
+    RectCorners bounds(
+        v2p(game.curArea->vertexes[0]), v2p(game.curArea->vertexes[0])
+    );
+    forIdx(v, game.curArea->vertexes) {
+        updateMinMaxCoords(bounds, v2p(game.curArea->vertexes[v]));
+    }
+    forIdx(l, layers) {
+        forIdx(e, game.curArea->edges) {
+            RectCorners effectBBox;
+            if(
+                !getEdgeOffsetBBox(
+                    (*layers[l])[e], game.curArea->edges[e], &effectBBox
+                )
+            ) {
+                continue;
+            }
+            updateMinMaxCoords(bounds, effectBBox.tl);
+            updateMinMaxCoords(bounds, effectBBox.br);
+        }
+    }
+    topLeftCorner = bounds.tl;
+    
+    float levelResolution = resolution;
+    while(true) {
+        Level level;
+        level.resolution = levelResolution;
+        level.tileSize = EDGE_OFFSET_TILES::TILE_BMP_SIZE / levelResolution;
+        level.nCols = ceil((bounds.br.x - bounds.tl.x) / level.tileSize) + 1;
+        level.nRows = ceil((bounds.br.y - bounds.tl.y) / level.tileSize) + 1;
+        level.tiles.assign(level.nCols * level.nRows, nullptr);
+        level.dirty.assign(level.nCols * level.nRows, true);
+        level.lastComposes.assign(level.nCols * level.nRows, 0);
+        levels.push_back(level);
+        
+        if(level.nCols <= 2 && level.nRows <= 2) break;
+        levelResolution /= 2.0f;
+    }
+}
+
+
+/**
+ * @brief Updates how far the effects reach out from their edges,
+ * based on the current state of the caches.
+ */
+void EdgeOffsetTiles::updateEffectReach() {
+    effectReach = 0.0f;
+    forIdx(l, layers) {
+        const vector<EdgeOffsetCache>& caches = *layers[l];
+        forIdx(e, caches) {
+            effectReach =
+                std::max(
+                {
+                    effectReach,
+                    caches[e].lengths[0], caches[e].lengths[1],
+                    caches[e].elbowLengths[0], caches[e].elbowLengths[1]
+                }
+                );
+        }
+    }
+}
+
+
 #pragma endregion
 #pragma region Error manager
 
@@ -2088,6 +2603,51 @@ PerformanceMonitor::PerformanceMonitor() :
 }
 
 
+/**
+ * @brief Adds a measurement of some work that was split across threads.
+ * These are reported separately from the normal measurements, since they
+ * happen inside of them.
+ *
+ * @param name Name of the measurement.
+ * @param parallelTime How long it took from start to finish.
+ * @param serialTime Sum of how long each thread spent on it.
+ * @param nrThreads Number of threads it was split across.
+ */
+void PerformanceMonitor::addParallelMeasurement(
+    const string& name, double parallelTime, double serialTime,
+    size_t nrThreads
+) {
+    if(paused) return;
+    
+    ParallelMeasurement m;
+    m.name = name;
+    m.parallelTime = parallelTime;
+    m.serialTime = serialTime;
+    m.nrThreads = nrThreads;
+    curPage.parallelMeasurements.push_back(m);
+}
+
+
+/**
+ * @brief Adds to a counter of how many times something happened.
+ * The counter is created if it doesn't exist yet.
+ *
+ * @param name Name of the counter.
+ * @param amount Amount to add.
+ */
+void PerformanceMonitor::addToCounter(const string& name, size_t amount) {
+    if(paused) return;
+    
+    forIdx(c, counters) {
+        if(counters[c].first == name) {
+            counters[c].second += amount;
+            return;
+        }
+    }
+    counters.push_back(std::make_pair(name, amount));
+}
+
+
 /**
  * @brief Enters the given state of the monitoring process.
  *
@@ -2140,6 +2700,24 @@ void PerformanceMonitor::finishMeasurement() {
 }
 
 
+/**
+ * @brief Returns the page of information about the average frame, with
+ * the frames of gameplay already averaged out.
+ *
+ * @return The page.
+ */
+PerformanceMonitor::Page PerformanceMonitor::getFrameAvgPage() const {
+    Page result = frameAvgPage;
+    if(frameSamples == 0) return result;
+    
+    result.duration /= (double) frameSamples;
+    forIdx(m, result.measurements) {
+        result.measurements[m].second /= (double) frameSamples;
+    }
+    return result;
+}
+
+
 /**
  * @brief Leaves the current state of the monitoring process.
  */
@@ -2215,6 +2793,7 @@ void PerformanceMonitor::reset() {
     frameAvgPage = Page();
     frameFastestPage = Page();
     frameSlowestPage = Page();
+    counters.clear();
 }
 
 
@@ -2227,12 +2806,6 @@ void PerformanceMonitor::saveLog() {
         return;
     }
     
-    //Average out the frames of gameplay.
-    frameAvgPage.duration /= (double) frameSamples;
-    forIdx(m, frameAvgPage.measurements) {
-        frameAvgPage.measurements[m].second /= (double) frameSamples;
-    }
-    
     //Fill out the string.
     string s =
         "\n" +
@@ -2250,7 +2823,7 @@ void PerformanceMonitor::saveLog() {
     loadingPage.write(s);
     
     s += "\nAverage frame processing times:\n";
-    frameAvgPage.write(s);
+    getFrameAvgPage().write(s);
     
     s += "\nFastest frame processing times:\n";
     frameFastestPage.write(s);
@@ -2258,6 +2831,15 @@ void PerformanceMonitor::saveLog() {
     s += "\nSlowest frame processing times:\n";
     frameSlowestPage.write(s);
     
+    if(!counters.empty()) {
+        s += "\nCounters:\n";
+        forIdx(c, counters) {
+            s +=
+                "  " + counters[c].first + ": " +
+                i2s(counters[c].second) + "\n";
+        }
+    }
+    
     //Finally, write the string to a file.
     string prevLog;
     ALLEGRO_FILE* fileI =
@@ -2281,6 +2863,30 @@ void PerformanceMonitor::saveLog() {
 }
 
 
+/**
+ * @brief Saves all known stats into a data node, in a format that's
+ * easy for other programs to read.
+ *
+ * @param node Data node to save to.
+ */
+void PerformanceMonitor::saveToDataNode(DataNode* node) {
+    GetterWriter gw(node);
+    
+    gw.write("area", areaName);
+    gw.write("frame_samples", frameSamples);
+    
+    loadingPage.saveToDataNode(node->addNew("loading"));
+    getFrameAvgPage().saveToDataNode(node->addNew("frame_average"));
+    frameFastestPage.saveToDataNode(node->addNew("frame_fastest"));
+    frameSlowestPage.saveToDataNode(node->addNew("frame_slowest"));
+    
+    GetterWriter cGW(node->addNew("counters"));
+    forIdx(c, counters) {
+        cGW.write(counters[c].first, counters[c].second);
+    }
+}
+
+
 /**
  * @brief Sets the name of the area that was monitored.
  *
@@ -2322,6 +2928,34 @@ void PerformanceMonitor::startMeasurement(const string& name) {
 }
 
 
+/**
+ * @brief Saves a page of information into a data node. Each measurement
+ * becomes a child node, with its duration in seconds as the value.
+ *
+ * @param node Data node to save to.
+ */
+void PerformanceMonitor::Page::saveToDataNode(DataNode* node) const {
+    GetterWriter gw(node);
+    
+    gw.write("duration", duration);
+    DataNode* measurementsNode = node->addNew("measurements");
+    GetterWriter mGW(measurementsNode);
+    forIdx(m, measurements) {
+        mGW.write(measurements[m].first, measurements[m].second);
+    }
+    
+    if(parallelMeasurements.empty()) return;
+    DataNode* parallelNode = node->addNew("parallel_measurements");
+    forIdx(m, parallelMeasurements) {
+        const ParallelMeasurement& pm = parallelMeasurements[m];
+        GetterWriter pGW(parallelNode->addNew(pm.name));
+        pGW.write("parallel_time", pm.parallelTime);
+        pGW.write("serial_time", pm.serialTime);
+        pGW.write("threads", pm.nrThreads);
+    }
+}
+
+
 /**
  * @brief Writes a page of information to a string.
  *
@@ -2348,6 +2982,22 @@ void PerformanceMonitor::Page::write(string& s) {
         "  TOTAL: " + std::to_string(duration) + "s (" +
         std::to_string(totalMeasuredTime) + "s measured, " +
         std::to_string(duration - totalMeasuredTime) + "s not measured).\n";
+    
+    //Write the work split across threads.
+    if(parallelMeasurements.empty()) return;
+    s += "  Split across threads (time taken vs. time on a single thread):\n";
+    forIdx(m, parallelMeasurements) {
+        const ParallelMeasurement& pm = parallelMeasurements[m];
+        s +=
+            "    " + pm.name + ": " +
+            std::to_string(pm.parallelTime) + "s on " +
+            i2s(pm.nrThreads) + " threads vs. " +
+            std::to_string(pm.serialTime) + "s";
+        if(pm.parallelTime > 0.0) {
+            s += " (" + f2s(pm.serialTime / pm.parallelTime) + "x)";
+        }
+        s += "\n";
+    }
 }
 
 
@@ -2835,8 +3485,6 @@ void SampleManager::doUnload(ALLEGRO_SAMPLE* asset) {
 #pragma region Script var manager
 
 
-
-
 /**
  * @brief Constructs a new script var manager object.
  *
@@ -2851,7 +3499,7 @@ ScriptVarManager::ScriptVarManager(const string& str) {
  * @brief Clears the list.
  */
 void ScriptVarManager::clear() {
-    varsMap.clear();
+    slots.clear();
 }
 
 
@@ -2862,7 +3510,18 @@ void ScriptVarManager::clear() {
  * @return Whether it exists.
  */
 bool ScriptVarManager::contains(const string& name) const {
-    return varsMap.contains(name);
+    return contains(game.scriptVarNames.findId(name));
+}
+
+
+/**
+ * @brief Returns whether the given script var exists in the list.
+ *
+ * @param nameId ID of its name.
+ * @return Whether it exists.
+ */
+bool ScriptVarManager::contains(size_t nameId) const {
+    return findSlot(nameId) != nullptr;
 }
 
 
@@ -2872,7 +3531,7 @@ bool ScriptVarManager::contains(const string& name) const {
  * @return Whether it is empty.
  */
 bool ScriptVarManager::empty() const {
-    return varsMap.empty();
+    return slots.empty();
 }
 
 
@@ -2882,7 +3541,27 @@ bool ScriptVarManager::empty() const {
  * @param name Its name.
  */
 void ScriptVarManager::erase(const string& name) {
-    varsMap.erase(name);
+    size_t nameId = game.scriptVarNames.findId(name);
+    if(nameId == INVALID) return;
+    
+    size_t idx = getSlotIdx(nameId);
+    if(idx == slots.size() || slots[idx].first != nameId) return;
+    slots.erase(slots.begin() + idx);
+}
+
+
+/**
+ * @brief Returns the value in the slot of a given var, if it exists.
+ *
+ * @param nameId ID of the var's name.
+ * @return The value, or nullptr if it doesn't exist.
+ */
+const ScriptVarValue* ScriptVarManager::findSlot(size_t nameId) const {
+    if(nameId == INVALID) return nullptr;
+    
+    size_t idx = getSlotIdx(nameId);
+    if(idx == slots.size() || slots[idx].first != nameId) return nullptr;
+    return &slots[idx].second;
 }
 
 
@@ -2902,7 +3581,7 @@ bool ScriptVarManager::fromString(const string& str) {
         if(rawParts.size() < 2) {
             continue;
         }
-        varsMap[trimSpaces(rawParts[0])] = trimSpaces(rawParts[1]);
+        setValue(trimSpaces(rawParts[0]), trimSpaces(rawParts[1]));
         success = true;
     }
     
@@ -2910,6 +3589,66 @@ bool ScriptVarManager::fromString(const string& str) {
 }
 
 
+/**
+ * @brief Assigns the value of a given variable as a number, if it is one.
+ * A variable that doesn't exist reads as an empty string would, which
+ * counts as the number 0.
+ *
+ * @param nameId ID of the name of the script variable to read.
+ * @param dest Destination for the value. This is set even if it's not
+ * a number, with what s2f would return.
+ * @return Whether it is a number.
+ */
+bool ScriptVarManager::getNumber(size_t nameId, double& dest) const {
+    const ScriptVarValue* value = findSlot(nameId);
+    if(!value) {
+        dest = 0.0;
+        return true;
+    }
+    return value->toNumber(dest);
+}
+
+
+/**
+ * @brief Returns the value in the slot of a given var. The var will be
+ * created if it does not exist.
+ *
+ * @param nameId ID of the var's name.
+ * @return The value.
+ */
+ScriptVarValue& ScriptVarManager::getSlot(size_t nameId) {
+    size_t idx = getSlotIdx(nameId);
+    if(idx == slots.size() || slots[idx].first != nameId) {
+        slots.insert(
+            slots.begin() + idx, std::make_pair(nameId, ScriptVarValue())
+        );
+    }
+    return slots[idx].second;
+}
+
+
+/**
+ * @brief Returns the index of the slot of a given var. If it doesn't exist,
+ * returns the index at which it would need to be inserted.
+ *
+ * @param nameId ID of the var's name.
+ * @return The index.
+ */
+size_t ScriptVarManager::getSlotIdx(size_t nameId) const {
+    size_t lowIdx = 0;
+    size_t highIdx = slots.size();
+    while(lowIdx < highIdx) {
+        size_t midIdx = (lowIdx + highIdx) / 2;
+        if(slots[midIdx].first < nameId) {
+            lowIdx = midIdx + 1;
+        } else {
+            highIdx = midIdx;
+        }
+    }
+    return lowIdx;
+}
+
+
 /**
  * @brief Assigns an Allegro color to the value of a given variable,
  * if it exists.
@@ -2919,11 +3658,11 @@ bool ScriptVarManager::fromString(const string& str) {
  * @return Whether it exists.
  */
 bool ScriptVarManager::getValue(const string& name, ALLEGRO_COLOR& dest) const {
-    auto v = varsMap.find(name);
-    if(v == varsMap.end()) {
+    const ScriptVarValue* value = findSlot(game.scriptVarNames.findId(name));
+    if(!value) {
         return false;
     }
-    dest = s2c(v->second);
+    dest = value->toColor();
     return true;
 }
 
@@ -2936,12 +3675,7 @@ bool ScriptVarManager::getValue(const string& name, ALLEGRO_COLOR& dest) const {
  * @return Whether it exists.
  */
 bool ScriptVarManager::getValue(const string& name, string& dest) const {
-    auto v = varsMap.find(name);
-    if(v == varsMap.end()) {
-        return false;
-    }
-    dest = v->second;
-    return true;
+    return getValue(game.scriptVarNames.findId(name), dest);
 }
 
 
@@ -2953,11 +3687,11 @@ bool ScriptVarManager::getValue(const string& name, string& dest) const {
  * @return Whether it exists.
  */
 bool ScriptVarManager::getValue(const string& name, size_t& dest) const {
-    auto v = varsMap.find(name);
-    if(v == varsMap.end()) {
+    const ScriptVarValue* value = findSlot(game.scriptVarNames.findId(name));
+    if(!value) {
         return false;
     }
-    dest = s2i(v->second);
+    dest = value->toInt();
     return true;
 }
 
@@ -2970,12 +3704,7 @@ bool ScriptVarManager::getValue(const string& name, size_t& dest) const {
  * @return Whether it exists.
  */
 bool ScriptVarManager::getValue(const string& name, int& dest) const {
-    auto v = varsMap.find(name);
-    if(v == varsMap.end()) {
-        return false;
-    }
-    dest = s2i(v->second);
-    return true;
+    return getValue(game.scriptVarNames.findId(name), dest);
 }
 
 
@@ -2988,11 +3717,11 @@ bool ScriptVarManager::getValue(const string& name, int& dest) const {
  * @return Whether it exists.
  */
 bool ScriptVarManager::getValue(const string& name, unsigned char& dest) const {
-    auto v = varsMap.find(name);
-    if(v == varsMap.end()) {
+    const ScriptVarValue* value = findSlot(game.scriptVarNames.findId(name));
+    if(!value) {
         return false;
     }
-    dest = s2i(v->second);
+    dest = value->toInt();
     return true;
 }
 
@@ -3005,12 +3734,7 @@ bool ScriptVarManager::getValue(const string& name, unsigned char& dest) const {
  * @return Whether it exists.
  */
 bool ScriptVarManager::getValue(const string& name, bool& dest) const {
-    auto v = varsMap.find(name);
-    if(v == varsMap.end()) {
-        return false;
-    }
-    dest = s2b(v->second);
-    return true;
+    return getValue(game.scriptVarNames.findId(name), dest);
 }
 
 
@@ -3022,12 +3746,7 @@ bool ScriptVarManager::getValue(const string& name, bool& dest) const {
  * @return Whether it exists.
  */
 bool ScriptVarManager::getValue(const string& name, float& dest) const {
-    auto v = varsMap.find(name);
-    if(v == varsMap.end()) {
-        return false;
-    }
-    dest = s2f(v->second);
-    return true;
+    return getValue(game.scriptVarNames.findId(name), dest);
 }
 
 
@@ -3039,11 +3758,79 @@ bool ScriptVarManager::getValue(const string& name, float& dest) const {
  * @return Whether it exists.
  */
 bool ScriptVarManager::getValue(const string& name, Point& dest) const {
-    auto v = varsMap.find(name);
-    if(v == varsMap.end()) {
+    const ScriptVarValue* value = findSlot(game.scriptVarNames.findId(name));
+    if(!value) {
         return false;
     }
-    dest = s2p(v->second);
+    dest = value->toPoint();
+    return true;
+}
+
+
+/**
+ * @brief Assigns a string to the value of a given variable, if it exists.
+ *
+ * @param nameId ID of the name of the script variable to read.
+ * @param dest Destination for the value.
+ * @return Whether it exists.
+ */
+bool ScriptVarManager::getValue(size_t nameId, string& dest) const {
+    const ScriptVarValue* value = findSlot(nameId);
+    if(!value) {
+        return false;
+    }
+    dest = value->toString();
+    return true;
+}
+
+
+/**
+ * @brief Assigns an int to the value of a given variable, if it exists.
+ *
+ * @param nameId ID of the name of the script variable to read.
+ * @param dest Destination for the value.
+ * @return Whether it exists.
+ */
+bool ScriptVarManager::getValue(size_t nameId, int& dest) const {
+    const ScriptVarValue* value = findSlot(nameId);
+    if(!value) {
+        return false;
+    }
+    dest = value->toInt();
+    return true;
+}
+
+
+/**
+ * @brief Assigns a bool to the value of a given variable, if it exists.
+ *
+ * @param nameId ID of the name of the script variable to read.
+ * @param dest Destination for the value.
+ * @return Whether it exists.
+ */
+bool ScriptVarManager::getValue(size_t nameId, bool& dest) const {
+    const ScriptVarValue* value = findSlot(nameId);
+    if(!value) {
+        return false;
+    }
+    dest = value->toBool();
+    return true;
+}
+
+
+/**
+ * @brief Assigns a float to the value of a given variable, if it exists.
+ *
+ * @param nameId ID of the name of the script variable to read.
+ * @param dest Destination for the value.
+ * @return Whether it exists.
+ */
+bool ScriptVarManager::getValue(size_t nameId, float& dest) const {
+    const ScriptVarValue* value = findSlot(nameId);
+    if(!value) {
+        return false;
+    }
+    dest = value->toFloat();
     return true;
 }
 
@@ -3056,7 +3843,7 @@ bool ScriptVarManager::getValue(const string& name, Point& dest) const {
  * @param value Value to give it.
  */
 void ScriptVarManager::setValue(const string& name, const string& value) {
-    varsMap[name] = value;
+    setValue(game.scriptVarNames.getId(name), value);
 }
 
 
@@ -3068,7 +3855,7 @@ void ScriptVarManager::setValue(const string& name, const string& value) {
  * @param value Value to give it.
  */
 void ScriptVarManager::setValue(const string& name, size_t value) {
-    varsMap[name] = i2s(value);
+    setValue(game.scriptVarNames.getId(name), value);
 }
 
 
@@ -3080,7 +3867,7 @@ void ScriptVarManager::setValue(const string& name, size_t value) {
  * @param value Value to give it.
  */
 void ScriptVarManager::setValue(const string& name, int value) {
-    varsMap[name] = i2s(value);
+    setValue(game.scriptVarNames.getId(name), value);
 }
 
 
@@ -3092,7 +3879,7 @@ void ScriptVarManager::setValue(const string& name, int value) {
  * @param value Value to give it.
  */
 void ScriptVarManager::setValue(const string& name, unsigned char value) {
-    varsMap[name] = i2s(value);
+    setValue(game.scriptVarNames.getId(name), (int) value);
 }
 
 
@@ -3104,7 +3891,7 @@ void ScriptVarManager::setValue(const string& name, unsigned char value) {
  * @param value Value to give it.
  */
 void ScriptVarManager::setValue(const string& name, bool value) {
-    varsMap[name] = b2s(value);
+    setValue(game.scriptVarNames.getId(name), value);
 }
 
 
@@ -3116,7 +3903,7 @@ void ScriptVarManager::setValue(const string& name, bool value) {
  * @param value Value to give it.
  */
 void ScriptVarManager::setValue(const string& name, float value) {
-    varsMap[name] = f2s(value);
+    setValue(game.scriptVarNames.getId(name), value);
 }
 
 
@@ -3130,7 +3917,9 @@ void ScriptVarManager::setValue(const string& name, float value) {
 void ScriptVarManager::setValue(
     const string& name, const ALLEGRO_COLOR& value
 ) {
-    varsMap[name] = c2s(value);
+    ScriptVarValue& slot = getSlot(game.scriptVarNames.getId(name));
+    slot.type = SCRIPT_VAR_TYPE_COLOR;
+    slot.colorValue = value;
 }
 
 
@@ -3142,7 +3931,79 @@ void ScriptVarManager::setValue(
  * @param value Value to give it.
  */
 void ScriptVarManager::setValue(const string& name, const Point& value) {
-    varsMap[name] = p2s(value);
+    ScriptVarValue& slot = getSlot(game.scriptVarNames.getId(name));
+    slot.type = SCRIPT_VAR_TYPE_POINT;
+    slot.pointValue = value;
+}
+
+
+/**
+ * @brief Makes one of the script vars to have the specified value. The var
+ * will be created if it does not exist.
+ *
+ * @param nameId ID of the name of the script variable to write to.
+ * @param value Value to give it.
+ */
+void ScriptVarManager::setValue(size_t nameId, const string& value) {
+    ScriptVarValue& slot = getSlot(nameId);
+    slot.type = SCRIPT_VAR_TYPE_STRING;
+    slot.strValue = value;
+}
+
+
+/**
+ * @brief Makes one of the script vars to have the specified value. The var
+ * will be created if it does not exist.
+ *
+ * @param nameId ID of the name of the script variable to write to.
+ * @param value Value to give it.
+ */
+void ScriptVarManager::setValue(size_t nameId, size_t value) {
+    ScriptVarValue& slot = getSlot(nameId);
+    slot.type = SCRIPT_VAR_TYPE_INT;
+    slot.intValue = value;
+}
+
+
+/**
+ * @brief Makes one of the script vars to have the specified value. The var
+ * will be created if it does not exist.
+ *
+ * @param nameId ID of the name of the script variable to write to.
+ * @param value Value to give it.
+ */
+void ScriptVarManager::setValue(size_t nameId, int value) {
+    ScriptVarValue& slot = getSlot(nameId);
+    slot.type = SCRIPT_VAR_TYPE_INT;
+    slot.intValue = value;
+}
+
+
+/**
+ * @brief Makes one of the script vars to have the specified value. The var
+ * will be created if it does not exist.
+ *
+ * @param nameId ID of the name of the script variable to write to.
+ * @param value Value to give it.
+ */
+void ScriptVarManager::setValue(size_t nameId, bool value) {
+    ScriptVarValue& slot = getSlot(nameId);
+    slot.type = SCRIPT_VAR_TYPE_BOOL;
+    slot.boolValue = value;
+}
+
+
+/**
+ * @brief Makes one of the script vars to have the specified value. The var
+ * will be created if it does not exist.
+ *
+ * @param nameId ID of the name of the script variable to write to.
+ * @param value Value to give it.
+ */
+void ScriptVarManager::setValue(size_t nameId, float value) {
+    ScriptVarValue& slot = getSlot(nameId);
+    slot.type = SCRIPT_VAR_TYPE_FLOAT;
+    slot.floatValue = value;
 }
 
 
@@ -3152,8 +4013,13 @@ void ScriptVarManager::setValue(const string& name, const Point& value) {
  *
  * @return The map.
  */
-const map<string, string>& ScriptVarManager::toMap() const {
-    return varsMap;
+map<string, string> ScriptVarManager::toMap() const {
+    map<string, string> result;
+    forIdx(s, slots) {
+        result[game.scriptVarNames.getName(slots[s].first)] =
+            slots[s].second.toString();
+    }
+    return result;
 }
 
 
@@ -3166,7 +4032,8 @@ string ScriptVarManager::toString() const {
     bool wroteFirst = false;
     string result;
     
-    for(const auto& v : varsMap) {
+    //Write them sorted by name, like a data file would have them.
+    for(const auto& v : toMap()) {
         if(wroteFirst) result += ";";
         result += v.first + "=" + v.second;
         wroteFirst = true;
@@ -3176,6 +4043,209 @@ string ScriptVarManager::toString() const {
 }
 
 
+#pragma endregion
+#pragma region Script var name manager
+
+
+/**
+ * @brief Returns the ID of a script var name, if it has one.
+ *
+ * @param name The name.
+ * @return The ID, or INVALID if the name never got one.
+ */
+size_t ScriptVarNameManager::findId(const string& name) const {
+    auto it = ids.find(name);
+    if(it == ids.end()) return INVALID;
+    return it->second;
+}
+
+
+/**
+ * @brief Returns the ID of a script var name. If it doesn't have one yet,
+ * it is given one.
+ *
+ * @param name The name.
+ * @return The ID.
+ */
+size_t ScriptVarNameManager::getId(const string& name) {
+    auto it = ids.find(name);
+    if(it != ids.end()) return it->second;
+    
+    size_t newId = names.size();
+    ids[name] = newId;
+    names.push_back(name);
+    return newId;
+}
+
+
+/**
+ * @brief Returns the script var name with the given ID.
+ *
+ * @param id The ID.
+ * @return The name.
+ */
+const string& ScriptVarNameManager::getName(size_t id) const {
+    return names[id];
+}
+
+
+#pragma endregion
+#pragma region Script var value
+
+
+/**
+ * @brief Returns the float value rounded to 4 decimal places, like f2s does.
+ * This way, reading it as another type gives the same result as converting
+ * it to a string and then to that type would, so something like
+ * 2.9999998 is read as the integer 3 instead of 2.
+ *
+ * @return The rounded value.
+ */
+double ScriptVarValue::getRoundedFloat() const {
+    //A float times 10000 fits in a double's precision, so there's no
+    //extra error in the multiplication.
+    return round((double) floatValue * 10000.0) / 10000.0;
+}
+
+
+/**
+ * @brief Returns the value as a boolean.
+ *
+ * @return The value.
+ */
+bool ScriptVarValue::toBool() const {
+    switch(type) {
+    case SCRIPT_VAR_TYPE_BOOL: {
+        return boolValue;
+    } case SCRIPT_VAR_TYPE_INT: {
+        return intValue != 0;
+    } case SCRIPT_VAR_TYPE_FLOAT: {
+        return (long long) getRoundedFloat() != 0;
+    } case SCRIPT_VAR_TYPE_STRING: {
+        return s2b(strValue);
+    } default: {
+        return s2b(toString());
+    }
+    }
+}
+
+
+/**
+ * @brief Returns the value as an Allegro color.
+ *
+ * @return The value.
+ */
+ALLEGRO_COLOR ScriptVarValue::toColor() const {
+    if(type == SCRIPT_VAR_TYPE_COLOR) return colorValue;
+    return s2c(toString());
+}
+
+
+/**
+ * @brief Returns the value as a float.
+ *
+ * @return The value.
+ */
+float ScriptVarValue::toFloat() const {
+    switch(type) {
+    case SCRIPT_VAR_TYPE_FLOAT: {
+        return floatValue;
+    } case SCRIPT_VAR_TYPE_INT: {
+        return (float) intValue;
+    } case SCRIPT_VAR_TYPE_STRING: {
+        return s2f(strValue);
+    } default: {
+        return s2f(toString());
+    }
+    }
+}
+
+
+/**
+ * @brief Returns the value as an integer.
+ *
+ * @return The value.
+ */
+long long ScriptVarValue::toInt() const {
+    switch(type) {
+    case SCRIPT_VAR_TYPE_INT: {
+        return intValue;
+    } case SCRIPT_VAR_TYPE_FLOAT: {
+        return (long long) getRoundedFloat();
+    } case SCRIPT_VAR_TYPE_STRING: {
+        return s2i(strValue);
+    } default: {
+        return s2i(toString());
+    }
+    }
+}
+
+
+/**
+ * @brief Returns the value as a number, if it is one. This gives the same
+ * results as checking its string form with isNumber and converting it
+ * with s2f, but numeric values skip the string.
+ *
+ * @param dest Destination for the value. This is set even if it's not
+ * a number, with what s2f would return.
+ * @return Whether it is a number.
+ */
+bool ScriptVarValue::toNumber(double& dest) const {
+    switch(type) {
+    case SCRIPT_VAR_TYPE_INT: {
+        dest = (double) intValue;
+        return true;
+    } case SCRIPT_VAR_TYPE_FLOAT: {
+        dest = getRoundedFloat();
+        return true;
+    } case SCRIPT_VAR_TYPE_STRING: {
+        dest = s2f(strValue);
+        return isNumber(strValue);
+    } default: {
+        string str = toString();
+        dest = s2f(str);
+        return isNumber(str);
+    }
+    }
+}
+
+
+/**
+ * @brief Returns the value as a point.
+ *
+ * @return The value.
+ */
+Point ScriptVarValue::toPoint() const {
+    if(type == SCRIPT_VAR_TYPE_POINT) return pointValue;
+    return s2p(toString());
+}
+
+
+/**
+ * @brief Returns the value as a string.
+ *
+ * @return The value.
+ */
+string ScriptVarValue::toString() const {
+    switch(type) {
+    case SCRIPT_VAR_TYPE_STRING: {
+        return strValue;
+    } case SCRIPT_VAR_TYPE_INT: {
+        return i2s(intValue);
+    } case SCRIPT_VAR_TYPE_FLOAT: {
+        return f2s(floatValue);
+    } case SCRIPT_VAR_TYPE_BOOL: {
+        return b2s(boolValue);
+    } case SCRIPT_VAR_TYPE_POINT: {
+        return p2s(pointValue);
+    } case SCRIPT_VAR_TYPE_COLOR: {
+        return c2s(colorValue);
+    }
+    }
+    return "";
+}
+
+
 #pragma endregion
 #pragma region Subgroup type manager
 
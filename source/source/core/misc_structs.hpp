@@ -13,6 +13,7 @@
 
 #include <functional>
 #include <map>
+#include <tuple>
 #include <vector>
 
 #include <allegro5/allegro.h>
@@ -77,6 +78,13 @@ extern const float TOKEN_SWIPE_Y_AMOUNT;
 }
 
 
+namespace EDGE_OFFSET_TILES {
+extern const size_t MAX_REDRAWS_PER_COMPOSE;
+extern const size_t MAX_RESIDENT_TILES;
+extern const int TILE_BMP_SIZE;
+}
+
+
 namespace MOUSE_CURSOR {
 extern const float HIDE_DOWN_SPEED;
 extern const float HIDE_TIMER_DURATION;
@@ -161,6 +169,10 @@ enum COMMAND_PARAM_FLAG {
     //this parameter.
     COMMAND_PARAM_FLAG_VECTOR = 1 << 2,
     
+    //The argument is the name of a script variable. If it's a constant,
+    //the name can be resolved when the script is loaded.
+    COMMAND_PARAM_FLAG_VAR_NAME = 1 << 3,
+    
 };
 
 
@@ -217,6 +229,30 @@ enum OPEN_CLOSE_STATE {
 };
 
 
+//Types of value a script variable can hold.
+enum SCRIPT_VAR_TYPE {
+
+    //A string. Values read from data files are always strings.
+    SCRIPT_VAR_TYPE_STRING,
+    
+    //An integer number.
+    SCRIPT_VAR_TYPE_INT,
+    
+    //A float number.
+    SCRIPT_VAR_TYPE_FLOAT,
+    
+    //A boolean.
+    SCRIPT_VAR_TYPE_BOOL,
+    
+    //A point.
+    SCRIPT_VAR_TYPE_POINT,
+    
+    //A color.
+    SCRIPT_VAR_TYPE_COLOR,
+    
+};
+
+
 //Types of string token.
 enum STRING_TOKEN {
 
@@ -871,8 +907,88 @@ struct ReaderSetter {
 };
 
 
+/**
+ * @brief Gives each script var name a unique number, so that script vars
+ * can be found without comparing their names.
+ */
+struct ScriptVarNameManager {
+
+    //--- Public function declarations ---
+    
+    size_t findId(const string& name) const;
+    size_t getId(const string& name);
+    const string& getName(size_t id) const;
+    
+    
+    private:
+    
+    //--- Private members ---
+    
+    //ID of each name.
+    map<string, size_t> ids;
+    
+    //Name of each ID.
+    vector<string> names;
+    
+};
+
+
+/**
+ * @brief The value of a script var. It is kept in the type it was given in,
+ * and converted when it's read as a different type. Converting to and from
+ * strings gives the same results as if it had been stored as a string.
+ */
+struct ScriptVarValue {
+
+    //--- Public members ---
+    
+    //Type of value.
+    SCRIPT_VAR_TYPE type = SCRIPT_VAR_TYPE_STRING;
+    
+    //Value, if it's a string.
+    string strValue;
+    
+    //Value, if it's an integer.
+    long long intValue = 0;
+    
+    //Value, if it's a float.
+    float floatValue = 0.0f;
+    
+    //Value, if it's a boolean.
+    bool boolValue = false;
+    
+    //Value, if it's a point.
+    Point pointValue;
+    
+    //Value, if it's a color.
+    ALLEGRO_COLOR colorValue = COLOR_EMPTY;
+    
+    
+    //--- Public function declarations ---
+    
+    bool toBool() const;
+    ALLEGRO_COLOR toColor() const;
+    float toFloat() const;
+    long long toInt() const;
+    bool toNumber(double& dest) const;
+    Point toPoint() const;
+    string toString() const;
+    
+    
+    private:
+    
+    //--- Private function declarations ---
+    
+    double getRoundedFloat() const;
+    
+};
+
+
 /**
  * @brief Manages a collection of script vars and their values.
+ * Vars are stored in slots, sorted by the ID of their name, as given by
+ * the game's script var name manager. The functions that take a name ID
+ * skip the name lookup, and should be preferred in hot code.
  */
 struct ScriptVarManager {
 
@@ -883,7 +999,7 @@ struct ScriptVarManager {
     
     bool fromString(const string& str);
     string toString() const;
-    const map<string, string>& toMap() const;
+    map<string, string> toMap() const;
     bool getValue(const string& name, string& dest) const;
     bool getValue(const string& name, size_t& dest) const;
     bool getValue(const string& name, int& dest) const;
@@ -892,6 +1008,11 @@ struct ScriptVarManager {
     bool getValue(const string& name, float& dest) const;
     bool getValue(const string& name, ALLEGRO_COLOR& dest) const;
     bool getValue(const string& name, Point& dest) const;
+    bool getValue(size_t nameId, string& dest) const;
+    bool getValue(size_t nameId, int& dest) const;
+    bool getValue(size_t nameId, bool& dest) const;
+    bool getValue(size_t nameId, float& dest) const;
+    bool getNumber(size_t nameId, double& dest) const;
     void setValue(const string& name, const string& value);
     void setValue(const string& name, size_t value);
     void setValue(const string& name, int value);
@@ -900,15 +1021,31 @@ struct ScriptVarManager {
     void setValue(const string& name, float value);
     void setValue(const string& name, const ALLEGRO_COLOR& value);
     void setValue(const string& name, const Point& value);
+    void setValue(size_t nameId, const string& value);
+    void setValue(size_t nameId, size_t value);
+    void setValue(size_t nameId, int value);
+    void setValue(size_t nameId, bool value);
+    void setValue(size_t nameId, float value);
     bool contains(const string& name) const;
+    bool contains(size_t nameId) const;
     void erase(const string& name);
     void clear();
     bool empty() const;
     
+    
+    private:
+    
     //--- Private members ---
     
-    //The list proper.
-    map<string, string> varsMap;
+    //Slots, each with a name ID and value. Sorted by name ID.
+    vector<std::pair<size_t, ScriptVarValue> > slots;
+    
+    
+    //--- Private function declarations ---
+    
+    const ScriptVarValue* findSlot(size_t nameId) const;
+    ScriptVarValue& getSlot(size_t nameId);
+    size_t getSlotIdx(size_t nameId) const;
     
 };
 
@@ -1827,6 +1964,11 @@ struct PerformanceMonitor {
     //--- Public function declarations ---
     
     PerformanceMonitor();
+    void addParallelMeasurement(
+        const string& name, double parallelTime, double serialTime,
+        size_t nrThreads
+    );
+    void addToCounter(const string& name, size_t amount = 1);
     void setAreaName(const string& name);
     void setPaused(bool paused);
     void enterState(const PERF_MON_STATE mode);
@@ -1834,12 +1976,35 @@ struct PerformanceMonitor {
     void startMeasurement(const string& name);
     void finishMeasurement();
     void saveLog();
+    void saveToDataNode(DataNode* node);
     void reset();
     
     private:
     
     //--- Private misc. declarations ---
     
+    /**
+     * @brief A measurement of some work that was split across threads.
+     */
+    struct ParallelMeasurement {
+        
+        //--- Public members ---
+        
+        //Name of the measurement.
+        string name;
+        
+        //How long it took from start to finish.
+        double parallelTime = 0.0;
+        
+        //Sum of how long each thread spent on it, i.e. roughly how long it
+        //would've taken on a single thread.
+        double serialTime = 0.0;
+        
+        //Number of threads it was split across.
+        size_t nrThreads = 1;
+        
+    };
+    
     /**
      * @brief A page in the report.
      */
@@ -1855,9 +2020,13 @@ struct PerformanceMonitor {
         //Measurements took, and how long each one took.
         vector<std::pair<string, double> > measurements;
         
+        //Measurements of work split across threads.
+        vector<ParallelMeasurement> parallelMeasurements;
+        
         
         //--- Public function declarations ---
         
+        void saveToDataNode(DataNode* node) const;
         void write(string& s);
         
         private:
@@ -1909,6 +2078,14 @@ struct PerformanceMonitor {
     //Page of information about the slowest frame.
     PerformanceMonitor::Page frameSlowestPage;
     
+    //Counters of how many times certain things happened, and their names.
+    vector<std::pair<string, size_t> > counters;
+    
+    
+    //--- Private function declarations ---
+    
+    PerformanceMonitor::Page getFrameAvgPage() const;
+    
 };
 
 
@@ -2071,6 +2248,118 @@ struct EdgeOffsetCache {
 };
 
 
+/**
+ * @brief Edge offset effects, pre-drawn onto tiles that cover the area's
+ * world space. Since the effects only change when their caches do, this
+ * lets a frame just copy the visible tiles onto the effect buffer, instead
+ * of drawing every visible edge's effect anew.
+ * The tiles exist in several levels of resolution, each half of the
+ * previous, so that the camera's current zoom can use tiles that are about
+ * as detailed as the window shows them. Only so many tiles are kept in
+ * memory, and only so many get drawn per frame.
+ */
+struct EdgeOffsetTiles {
+
+    //--- Public function declarations ---
+    
+    EdgeOffsetTiles() = default;
+    ~EdgeOffsetTiles();
+    EdgeOffsetTiles(const EdgeOffsetTiles&) = delete;
+    EdgeOffsetTiles& operator=(const EdgeOffsetTiles&) = delete;
+    void clear();
+    void compose(ALLEGRO_BITMAP* buffer, const Viewport& view);
+    void markDirty(const RectCorners& region);
+    void setup(
+        const vector<const vector<EdgeOffsetCache>*>& layers, float resolution
+    );
+    
+    
+    private:
+    
+    //--- Private misc. definitions ---
+    
+    /**
+     * @brief Tiles that cover the region at one resolution.
+     */
+    struct Level {
+    
+        //--- Public members ---
+        
+        //How many tile pixels there are per world unit.
+        float resolution = 1.0f;
+        
+        //Width and height of each tile, in world units.
+        float tileSize = 1.0f;
+        
+        //Number of columns of tiles.
+        size_t nCols = 0;
+        
+        //Number of rows of tiles.
+        size_t nRows = 0;
+        
+        //Bitmap of each tile, row by row. nullptr if it has no effects,
+        //or if it isn't in memory.
+        vector<ALLEGRO_BITMAP*> tiles;
+        
+        //Whether each tile needs to be drawn again.
+        vector<bool> dirty;
+        
+        //Number of the last composition each tile was used in.
+        vector<size_t> lastComposes;
+        
+    };
+    
+    
+    //--- Private members ---
+    
+    //Caches of each effect drawn on the tiles, in the order they're drawn.
+    vector<const vector<EdgeOffsetCache>*> layers;
+    
+    //Levels of tiles, from the most detailed to the least.
+    vector<Level> levels;
+    
+    //Top-left corner of the first tile of every level, in world coordinates.
+    Point topLeftCorner;
+    
+    //How far any effect reaches out from its edge, in world units.
+    float effectReach = 0.0f;
+    
+    //Number of tiles, from all levels, that have a bitmap.
+    size_t nrResidentTiles = 0;
+    
+    //Bitmaps of tiles that were freed, ready to be used again.
+    vector<ALLEGRO_BITMAP*> spareBitmaps;
+    
+    //Number of times the tiles were composed since they were set up.
+    size_t nrComposes = 0;
+    
+    //Edges that could have effects on the tile being drawn.
+    //Cache for performance.
+    vector<size_t> tileEdgeIdxs;
+    
+    //Tiles that could be freed, with when they were last used.
+    //Cache for performance.
+    vector<std::tuple<size_t, size_t, size_t> > evictionCandidates;
+    
+    
+    //--- Private function declarations ---
+    
+    void drawTileRegion(
+        const Level& level, size_t col, size_t row,
+        const RectCorners& region, const Viewport& view
+    );
+    void evictTiles();
+    void freeTile(Level& level, size_t tIdx);
+    RectCorners getTileCorners(
+        const Level& level, size_t col, size_t row
+    ) const;
+    size_t pickLevel(float zoom) const;
+    void redrawTile(Level& level, size_t col, size_t row);
+    void updateEffectReach();
+    
+};
+
+
 /**
  * @brief Info about the current whistle usage.
  */
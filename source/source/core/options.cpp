@@ -44,6 +44,16 @@ const float JOYSTICK_MAX_DEADZONE = 0.9f;
 //Default value for the joystick minimum deadzone.
 const float JOYSTICK_MIN_DEADZONE = 0.2f;
 
+//Default value for the number of threads that load content.
+//0 means one per processor core.
+const size_t LOADING_THREADS = 0;
+
+//Default value for the fixed gameplay logic rate. 0 means disabled.
+const unsigned int LOGIC_FPS = 0;
+
+//Default value for the number of threads that tick gameplay logic.
+const size_t LOGIC_THREADS = 1;
+
 //Default value for the maximum amount of particles.
 const size_t MAX_PARTICLES = 1000;
 
@@ -53,6 +63,9 @@ const bool MIPMAPS_ENABLED = true;
 //Default value for whether to enter pause menu when window focus is lost.
 const bool PAUSE_ON_FOCUS_LOST = true;
 
+//Default value for whether to record replays of gameplay sessions.
+const bool RECORD_REPLAYS = false;
+
 //Default value for whether shader compatibility mode is enabled.
 const bool SHADER_COMPATIBILITY_MODE = false;
 
@@ -316,9 +329,13 @@ void Options::loadFromDataNode(DataNode* file) {
         aRS.set("hide_stopped_mouse_cursor", advanced.hideStoppedMouseCursor);
         aRS.set("joystick_max_deadzone", advanced.joystickMaxDeadzone);
         aRS.set("joystick_min_deadzone", advanced.joystickMinDeadzone);
+        aRS.set("loading_threads", advanced.loadingThreads);
+        aRS.set("logic_fps", advanced.logicFps);
+        aRS.set("logic_threads", advanced.logicThreads);
         aRS.set("max_particles", advanced.maxParticles);
         aRS.set("mipmaps", advanced.mipmapsEnabled);
         aRS.set("pause_on_focus_lost", advanced.pauseOnFocusLost);
+        aRS.set("record_replays", advanced.recordReplays);
         aRS.set("shader_compatibility_mode", advanced.shaderCompatMode);
         aRS.set("show_os_mouse_cursor", advanced.showOSMouseCursor);
         aRS.set("smooth_scaling", advanced.smoothScaling);
@@ -326,6 +343,10 @@ void Options::loadFromDataNode(DataNode* file) {
         aRS.set("zoom_medium_reach", advanced.zoomMediumReach);
         
         advanced.targetFps = std::max(LOWEST_FRAMERATE, advanced.targetFps);
+        if(advanced.logicFps != 0) {
+            advanced.logicFps = std::max(LOWEST_FRAMERATE, advanced.logicFps);
+        }
+        advanced.logicThreads = std::max((size_t) 1, advanced.logicThreads);
         
         if(advanced.joystickMinDeadzone > advanced.joystickMaxDeadzone) {
             std::swap(
@@ -619,9 +640,13 @@ void Options::saveToDataNode(DataNode* file) const {
         aGW.write("hide_stopped_mouse_cursor", advanced.hideStoppedMouseCursor);
         aGW.write("joystick_max_deadzone", advanced.joystickMaxDeadzone);
         aGW.write("joystick_min_deadzone", advanced.joystickMinDeadzone);
+        aGW.write("loading_threads", advanced.loadingThreads);
+        aGW.write("logic_fps", advanced.logicFps);
+        aGW.write("logic_threads", advanced.logicThreads);
         aGW.write("max_particles", advanced.maxParticles);
         aGW.write("mipmaps", advanced.mipmapsEnabled);
         aGW.write("pause_on_focus_lost", advanced.pauseOnFocusLost);
+        aGW.write("record_replays", advanced.recordReplays);
         aGW.write("show_os_mouse_cursor", advanced.showOSMouseCursor);
         aGW.write("shader_compatibility_mode", advanced.shaderCompatMode);
         aGW.write("smooth_scaling", advanced.smoothScaling);
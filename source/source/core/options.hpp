@@ -73,9 +73,13 @@ extern const bool EXPO_MODE;
 extern const bool HIDE_STOPPED_MOUSE_CURSOR;
 extern const float JOYSTICK_MAX_DEADZONE;
 extern const float JOYSTICK_MIN_DEADZONE;
+extern const size_t LOADING_THREADS;
+extern const unsigned int LOGIC_FPS;
+extern const size_t LOGIC_THREADS;
 extern const size_t MAX_PARTICLES;
 extern const bool MIPMAPS_ENABLED;
 extern const bool PAUSE_ON_FOCUS_LOST;
+extern const bool RECORD_REPLAYS;
 extern const bool SHADER_COMPATIBILITY_MODE;
 extern const bool SHOW_OS_MOUSE_CURSOR;
 extern const bool SMOOTH_SCALING;
@@ -207,6 +211,15 @@ struct Options {
         //Minimum deadzone for joysticks.
         float joystickMinDeadzone = ADVANCED_D::JOYSTICK_MIN_DEADZONE;
         
+        //Threads that load content. 0 to use one per processor core.
+        size_t loadingThreads = ADVANCED_D::LOADING_THREADS;
+        
+        //Fixed rate at which gameplay logic ticks. 0 to tick once per frame.
+        int logicFps = ADVANCED_D::LOGIC_FPS;
+        
+        //Threads that tick gameplay logic. 1 to only use the main one.
+        size_t logicThreads = ADVANCED_D::LOGIC_THREADS;
+        
         //Maximum number of particles.
         size_t maxParticles = ADVANCED_D::MAX_PARTICLES;
         
@@ -216,6 +229,9 @@ struct Options {
         //Enter the pause menu when window focus is lost?
         bool pauseOnFocusLost = ADVANCED_D::PAUSE_ON_FOCUS_LOST;
         
+        //Record a replay of each gameplay session to the disk?
+        bool recordReplays = ADVANCED_D::RECORD_REPLAYS;
+        
         //Shader compatibility mode, which simply disables failed shaders.
         bool shaderCompatMode = ADVANCED_D::SHADER_COMPATIBILITY_MODE;
         
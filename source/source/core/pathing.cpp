@@ -9,6 +9,7 @@
  */
 
 #include <algorithm>
+#include <functional>
 
 #include "pathing.hpp"
 
@@ -29,12 +30,122 @@ namespace PATHS {
 //Default distance at which the mob considers the chase finished.
 const float DEF_CHASE_TARGET_DISTANCE = 3.0f;
 
+//Maximum number of path query results to keep in the path cache.
+//If it gets full, it's emptied.
+const size_t MAX_CACHED_PATHS = 2048;
+
 //Minimum radius of a path stop.
 const float MIN_STOP_RADIUS = 16.0f;
 
+//Width and height of each cell in the path stop grid.
+const float STOP_GRID_CELL_SIZE = 256.0f;
+
+}
+
+
+#pragma region A* scratch
+
+
+/**
+ * @brief Initializes a stop's data for the current search, if it
+ * hasn't been initialized for it yet.
+ *
+ * @param stopIdx Index of the stop.
+ */
+void AStarScratch::initStop(size_t stopIdx) {
+    if(generations[stopIdx] == curGeneration) return;
+    generations[stopIdx] = curGeneration;
+    sinceStart[stopIdx] = FLT_MAX;
+    prev[stopIdx] = INVALID;
+    visited[stopIdx] = false;
+}
+
+
+/**
+ * @brief Prepares everything for a new search.
+ *
+ * @param nrStops Total number of path stops.
+ */
+void AStarScratch::startSearch(size_t nrStops) {
+    if(generations.size() < nrStops) {
+        sinceStart.resize(nrStops);
+        prev.resize(nrStops);
+        visited.resize(nrStops);
+        generations.resize(nrStops, 0);
+        prevChainIdxs.resize(nrStops);
+        prevChainFromPoss.resize(nrStops);
+        prevChainToPoss.resize(nrStops);
+    }
+    
+    curGeneration++;
+    if(curGeneration == 0) {
+        //Wrapped around. Make sure no old data passes as current.
+        std::fill(generations.begin(), generations.end(), 0);
+        curGeneration = 1;
+    }
+    
+    toVisit.clear();
+    obstacleLinks.clear();
+}
+
+
+#pragma endregion
+#pragma region Path chain
+
+
+/**
+ * @brief Returns the link between two neighboring stops in the chain.
+ *
+ * @param fromPos Position of the stop the link starts at.
+ * @param toPos Position of the stop the link ends at.
+ * @return The link, or nullptr if there is none.
+ */
+PathLink* PathChain::getLink(size_t fromPos, size_t toPos) const {
+    if(toPos == fromPos + 1) return forwardLinks[fromPos];
+    if(toPos + 1 == fromPos && !backwardLinks.empty()) {
+        return backwardLinks[toPos];
+    }
+    return nullptr;
+}
+
+
+/**
+ * @brief Checks if any link in a stretch of the chain is blocked by
+ * an obstacle.
+ *
+ * @param fromPos Position in the chain to start at.
+ * @param toPos Position in the chain to end at.
+ * @return Whether there are obstacles.
+ */
+bool PathChain::hasObstacles(size_t fromPos, size_t toPos) const {
+    if(toPos > fromPos) {
+        return forwardBlockedCounts[toPos] > forwardBlockedCounts[fromPos];
+    }
+    return backwardBlockedCounts[fromPos] > backwardBlockedCounts[toPos];
+}
+
+
+/**
+ * @brief Updates the information about which links are blocked by
+ * obstacles.
+ */
+void PathChain::updateObstacles() {
+    forwardBlockedCounts.assign(stops.size(), 0);
+    backwardBlockedCounts.assign(stops.size(), 0);
+    for(size_t p = 1; p < stops.size(); p++) {
+        forwardBlockedCounts[p] =
+            forwardBlockedCounts[p - 1] +
+            (forwardLinks[p - 1]->blockedByObstacle ? 1 : 0);
+        if(!backwardLinks.empty()) {
+            backwardBlockedCounts[p] =
+                backwardBlockedCounts[p - 1] +
+                (backwardLinks[p - 1]->blockedByObstacle ? 1 : 0);
+        }
+    }
 }
 
 
+#pragma endregion
 #pragma region Path link
 
 
@@ -101,10 +212,135 @@ bool PathLink::isOneWay() const {
 #pragma region Path manager
 
 
+/**
+ * @brief Builds the contracted path graph, by splitting the stops into
+ * chains. The stops' indexes must be up-to-date.
+ */
+void PathManager::buildChains() {
+    vector<PathStop*>& stops = game.curArea->pathStops;
+    chains.clear();
+    linkChainIdxs.clear();
+    stopChainExits.assign(stops.size(), vector<std::pair<size_t, bool> >());
+    stopChainIdxs.assign(stops.size(), INVALID);
+    stopChainPoss.assign(stops.size(), 0);
+    
+    //Figure out which stops can be in the middle of a chain.
+    vector<size_t> nrIncomingLinks(stops.size(), 0);
+    forIdx(s, stops) {
+        forIdx(l, stops[s]->links) {
+            PathStop* endPtr = stops[s]->links[l]->endPtr;
+            if(endPtr) nrIncomingLinks[endPtr->idx]++;
+        }
+    }
+    
+    vector<bool> inMiddle(stops.size(), false);
+    forIdx(s, stops) {
+        PathStop* sPtr = stops[s];
+        if(sPtr->links.size() != 2 || nrIncomingLinks[s] != 2) continue;
+        PathStop* n1Ptr = sPtr->links[0]->endPtr;
+        PathStop* n2Ptr = sPtr->links[1]->endPtr;
+        if(!n1Ptr || !n2Ptr) continue;
+        if(n1Ptr == n2Ptr || n1Ptr == sPtr || n2Ptr == sPtr) continue;
+        if(!n1Ptr->getLink(sPtr) || !n2Ptr->getLink(sPtr)) continue;
+        inMiddle[s] = true;
+    }
+    
+    //Follows the stops from a chain's start until its other end.
+    const auto buildChain = [&] (PathStop* startStop, PathLink* firstLink) {
+        PathChain chain;
+        chain.stops.push_back(startStop);
+        PathLink* lPtr = firstLink;
+        while(true) {
+            PathStop* prevStop = chain.stops.back();
+            PathStop* nextStop = lPtr->endPtr;
+            chain.forwardLinks.push_back(lPtr);
+            chain.stops.push_back(nextStop);
+            if(!inMiddle[nextStop->idx]) break;
+            
+            //Keep going through the link that doesn't go back.
+            lPtr =
+                nextStop->links[0]->endPtr == prevStop ?
+                nextStop->links[1] :
+                nextStop->links[0];
+        }
+        
+        chain.distances.assign(chain.stops.size(), 0.0f);
+        for(size_t p = 1; p < chain.stops.size(); p++) {
+            chain.distances[p] =
+                chain.distances[p - 1] + chain.forwardLinks[p - 1]->distance;
+            PathLink* backLink =
+                chain.stops[p]->getLink(chain.stops[p - 1]);
+            if(backLink) chain.backwardLinks.push_back(backLink);
+        }
+        if(chain.backwardLinks.size() != chain.forwardLinks.size()) {
+            chain.backwardLinks.clear();
+        }
+        chain.updateObstacles();
+        
+        size_t chainIdx = chains.size();
+        for(size_t p = 1; p < chain.stops.size() - 1; p++) {
+            stopChainIdxs[chain.stops[p]->idx] = chainIdx;
+            stopChainPoss[chain.stops[p]->idx] = p;
+        }
+        stopChainExits[chain.stops.front()->idx].push_back(
+            std::make_pair(chainIdx, true)
+        );
+        if(!chain.backwardLinks.empty()) {
+            stopChainExits[chain.stops.back()->idx].push_back(
+                std::make_pair(chainIdx, false)
+            );
+        }
+        forIdx(l, chain.forwardLinks) {
+            linkChainIdxs[chain.forwardLinks[l]] = chainIdx;
+        }
+        forIdx(l, chain.backwardLinks) {
+            linkChainIdxs[chain.backwardLinks[l]] = chainIdx;
+        }
+        chains.push_back(chain);
+    };
+    
+    //Build the chains that start at each stop that isn't in the middle.
+    forIdx(s, stops) {
+        if(inMiddle[s]) continue;
+        PathStop* sPtr = stops[s];
+        forIdx(l, sPtr->links) {
+            PathStop* nextStop = sPtr->links[l]->endPtr;
+            if(!nextStop) continue;
+            if(inMiddle[nextStop->idx]) {
+                //Skip if it was already built from the other end.
+                if(stopChainIdxs[nextStop->idx] != INVALID) continue;
+            } else if(nextStop->getLink(sPtr) && nextStop->idx < s) {
+                //Two-way link that was already built from the other end.
+                continue;
+            }
+            buildChain(sPtr, sPtr->links[l]);
+        }
+    }
+    
+    //Any stops left over are in closed loops with no ends.
+    //Make one stop in each loop an end.
+    forIdx(s, stops) {
+        if(!inMiddle[s] || stopChainIdxs[s] != INVALID) continue;
+        inMiddle[s] = false;
+        buildChain(stops[s], stops[s]->links[0]);
+    }
+}
+
+
 /**
  * @brief Clears all info.
  */
 void PathManager::clear() {
+    pathCache.clear();
+    stopGrid.clear();
+    chains.clear();
+    stopChainExits.clear();
+    stopChainIdxs.clear();
+    stopChainPoss.clear();
+    linkChainIdxs.clear();
+    pathProfiles.clear();
+    cachesReady = false;
+    
     if(!game.curArea) return;
     
     obstructions.clear();
@@ -119,11 +355,278 @@ void PathManager::clear() {
 }
 
 
+/**
+ * @brief Uses A* to get the shortest path between two stops, like aStar()
+ * does, but on the contracted path graph. Each step goes across a whole
+ * chain of stops at a time, so stops in the middle of a chain are never
+ * visited on their own. The path returned still includes every stop.
+ *
+ * @param outPath The stops to visit, in order, are returned here.
+ * @param startStop Start stop.
+ * @param endStop End stop.
+ * @param settings Settings about how the path should be followed.
+ * @param outTotalDist If not nullptr, the total path distance is
+ * returned here.
+ * @return The operation's result.
+ */
+PATH_RESULT PathManager::contractedAStar(
+    vector<PathStop*>& outPath,
+    PathStop* startStop, PathStop* endStop,
+    const PathFollowSettings& settings,
+    float* outTotalDist
+) {
+    vector<PathStop*>& stops = game.curArea->pathStops;
+    AStarScratch& scr = game.curArea->pathFindingScratch;
+    const auto heapCmp = std::greater<std::pair<float, size_t> >();
+    size_t endChainIdx = stopChainIdxs[endStop->idx];
+    size_t endChainPos = stopChainPoss[endStop->idx];
+    
+    PathFollowSettings curSettings = settings;
+    bool ignoringObstacles =
+        hasFlag(settings.flags, PATH_FOLLOW_FLAG_IGNORE_OBSTACLES);
+    bool retriedIgnoringObstacles = false;
+    obstacleStretches.clear();
+    
+    //Checks if a stretch can be traversed, and if it leads to a better path
+    //towards the stop at its end. If so, saves that and adds the stop
+    //to the stops to visit.
+    const auto relax = [&] (const ChainStretch& st) {
+        const PathChain& chain = chains[st.chainIdx];
+        bool forward = st.toPos > st.fromPos;
+        
+        if(!ignoringObstacles && chain.hasObstacles(st.fromPos, st.toPos)) {
+            obstacleStretches.push_back(st);
+            return;
+        }
+        for(size_t p = st.fromPos; p != st.toPos; forward ? p++ : p--) {
+            PathLink* lPtr = chain.getLink(p, forward ? p + 1 : p - 1);
+            if(!canTraversePathLink(lPtr, curSettings)) return;
+        }
+        
+        PathStop* target = chain.stops[st.toPos];
+        size_t tIdx = target->idx;
+        scr.initStop(tIdx);
+        
+        float tentativeScore =
+            scr.sinceStart[st.fromStopIdx] +
+            fabs(chain.distances[st.toPos] - chain.distances[st.fromPos]);
+        if(tentativeScore >= scr.sinceStart[tIdx]) return;
+        
+        //Found a better path from the start to this stop.
+        scr.sinceStart[tIdx] = tentativeScore;
+        scr.prev[tIdx] = st.fromStopIdx;
+        scr.prevChainIdxs[tIdx] = st.chainIdx;
+        scr.prevChainFromPoss[tIdx] = st.fromPos;
+        scr.prevChainToPoss[tIdx] = st.toPos;
+        scr.visited[tIdx] = false;
+        scr.toVisit.push_back(
+            std::make_pair(
+                tentativeScore +
+                Distance(target->center, endStop->center).toFloat(),
+                tIdx
+            )
+        );
+        std::push_heap(scr.toVisit.begin(), scr.toVisit.end(), heapCmp);
+    };
+    
+    //Goes along a chain until its end, and also until the end stop,
+    //if it's along the way.
+    const auto relaxChain =
+    [&] (size_t fromStopIdx, size_t chainIdx, size_t fromPos, bool forward) {
+        ChainStretch st;
+        st.fromStopIdx = fromStopIdx;
+        st.chainIdx = chainIdx;
+        st.fromPos = fromPos;
+        if(
+            chainIdx == endChainIdx &&
+            (forward ? endChainPos > fromPos : endChainPos < fromPos)
+        ) {
+            st.toPos = endChainPos;
+            relax(st);
+        }
+        st.toPos = forward ? chains[chainIdx].stops.size() - 1 : 0;
+        relax(st);
+    };
+    
+    //Part 1: Initialize the algorithm.
+    scr.startSearch(stops.size());
+    scr.initStop(startStop->idx);
+    scr.sinceStart[startStop->idx] = 0.0f;
+    scr.toVisit.push_back(std::make_pair(0.0f, startStop->idx));
+    
+    while(true) {
+        //Start iterating.
+        while(!scr.toVisit.empty()) {
+            //Part 2: Figure out what stop to work on in this iteration.
+            std::pop_heap(scr.toVisit.begin(), scr.toVisit.end(), heapCmp);
+            size_t curIdx = scr.toVisit.back().second;
+            scr.toVisit.pop_back();
+            
+            //Outdated entry for a stop that's been visited since.
+            if(scr.visited[curIdx]) continue;
+            
+            //Part 3: If the stop we're processing is the end stop, then
+            //that's it, best path found!
+            if(curIdx == endStop->idx) {
+                //Construct the path, with the stops in each stretch.
+                outPath.clear();
+                size_t next = curIdx;
+                while(scr.prev[next] != INVALID) {
+                    const PathChain& chain = chains[scr.prevChainIdxs[next]];
+                    size_t fromPos = scr.prevChainFromPoss[next];
+                    size_t toPos = scr.prevChainToPoss[next];
+                    for(
+                        size_t p = toPos; p != fromPos;
+                        toPos > fromPos ? p-- : p++
+                    ) {
+                        outPath.push_back(chain.stops[p]);
+                    }
+                    next = scr.prev[next];
+                }
+                outPath.push_back(stops[next]);
+                std::reverse(outPath.begin(), outPath.end());
+                
+                if(outTotalDist) *outTotalDist = scr.sinceStart[curIdx];
+                return
+                    retriedIgnoringObstacles ?
+                    PATH_RESULT_PATH_WITH_OBSTACLES :
+                    PATH_RESULT_NORMAL_PATH;
+            }
+            
+            //This stop's been visited.
+            scr.visited[curIdx] = true;
+            
+            //Part 4: Check the chains out of it.
+            if(stopChainIdxs[curIdx] != INVALID) {
+                //Only the start stop can be in the middle of a chain.
+                size_t chainIdx = stopChainIdxs[curIdx];
+                size_t pos = stopChainPoss[curIdx];
+                relaxChain(curIdx, chainIdx, pos, true);
+                relaxChain(curIdx, chainIdx, pos, false);
+            } else {
+                forIdx(e, stopChainExits[curIdx]) {
+                    size_t chainIdx = stopChainExits[curIdx][e].first;
+                    bool forward = stopChainExits[curIdx][e].second;
+                    relaxChain(
+                        curIdx, chainIdx,
+                        forward ? 0 : chains[chainIdx].stops.size() - 1,
+                        forward
+                    );
+                }
+            }
+        }
+        
+        //If we got to this point, there means that there is no
+        //available path!
+        if(ignoringObstacles) break;
+        
+        //Let's try again, this time ignoring obstacles, going from the
+        //stretches that were skipped because of them.
+        ignoringObstacles = true;
+        retriedIgnoringObstacles = true;
+        enableFlag(curSettings.flags, PATH_FOLLOW_FLAG_IGNORE_OBSTACLES);
+        //This doesn't add any more stretches to the list.
+        forIdx(s, obstacleStretches) {
+            relax(obstacleStretches[s]);
+        }
+    }
+    
+    //Nothing that can be done. No path.
+    outPath.clear();
+    if(outTotalDist) *outTotalDist = 0;
+    return PATH_RESULT_END_STOP_UNREACHABLE;
+}
+
+
+/**
+ * @brief Returns the path between two stops, like aStar() would.
+ * If the same query was made before, and no obstacle or hazard changed
+ * since, the result is reused instead.
+ *
+ * @param outPath The stops to visit, in order, are returned here. This
+ * points to the cached result, which stays valid until the next query
+ * or until the cache is emptied.
+ * @param startStop Start stop.
+ * @param endStop End stop.
+ * @param settings Settings about how the path should be followed.
+ * @param outTotalDist If not nullptr, the total path distance is
+ * returned here.
+ * @return The operation's result.
+ */
+PATH_RESULT PathManager::getCachedPath(
+    const vector<PathStop*>** outPath,
+    PathStop* startStop, PathStop* endStop,
+    const PathFollowSettings& settings,
+    float* outTotalDist
+) {
+    if(pathCache.size() >= PATHS::MAX_CACHED_PATHS) {
+        pathCache.clear();
+        pathProfiles.clear();
+    }
+    
+    //There are only ever a few different profiles, so a linear search
+    //is fine, and it saves having to copy them into the key.
+    size_t profileIdx = INVALID;
+    forIdx(p, pathProfiles) {
+        if(
+            pathProfiles[p].first == settings.invulnerabilities &&
+            pathProfiles[p].second == settings.label
+        ) {
+            profileIdx = p;
+            break;
+        }
+    }
+    if(profileIdx == INVALID) {
+        profileIdx = pathProfiles.size();
+        pathProfiles.push_back(
+            std::make_pair(settings.invulnerabilities, settings.label)
+        );
+    }
+    
+    CachedPathKey key;
+    key.startIdx = startStop->idx;
+    key.endIdx = endStop->idx;
+    key.flags =
+        settings.flags & (
+            PATH_FOLLOW_FLAG_IGNORE_OBSTACLES |
+            PATH_FOLLOW_FLAG_SCRIPT_USE |
+            PATH_FOLLOW_FLAG_LIGHT_LOAD |
+            PATH_FOLLOW_FLAG_AIRBORNE
+        );
+    key.profileIdx = profileIdx;
+    
+    auto it = pathCache.find(key);
+    if(it != pathCache.end()) {
+        if(game.perfMon) game.perfMon->addToCounter("Path cache hits");
+    } else {
+        if(game.perfMon) game.perfMon->addToCounter("Path cache misses");
+        it = pathCache.insert(std::make_pair(key, CachedPath())).first;
+        CachedPath& newEntry = it->second;
+        newEntry.result =
+            contractedAStar(
+                newEntry.path, startStop, endStop, settings,
+                &newEntry.totalDist
+            );
+    }
+    
+    const CachedPath& entry = it->second;
+    *outPath = &entry.path;
+    if(outTotalDist) *outTotalDist = entry.totalDist;
+    return entry.result;
+}
+
+
 /**
  * @brief Handles the area having been loaded. It checks all path stops
  * and saves any sector hazards found.
  */
 void PathManager::handleAreaLoad() {
+    pathCache.clear();
+    pathProfiles.clear();
+    stopGrid.build(game.curArea->pathStops);
+    buildChains();
+    cachesReady = true;
+    
     //Go through all path stops and check if they're on hazardous sectors.
     forIdx(s, game.curArea->pathStops) {
         PathStop* sPtr = game.curArea->pathStops[s];
@@ -159,12 +662,15 @@ void PathManager::handleObstacleAdd(Mob* m) {
             ) {
                 obstructions[lPtr].insert(m);
                 lPtr->blockedByObstacle = true;
+                updateLinkObstacles(lPtr);
                 pathsChanged = true;
             }
         }
     }
     
     if(pathsChanged) {
+        pathCache.clear();
+        
         //Re-calculate the paths of mobs taking paths.
         forIdx(m2, game.states.gameplay->mobs.all) {
             Mob* m2Ptr = game.states.gameplay->mobs.all[m2];
@@ -191,6 +697,7 @@ void PathManager::handleObstacleRemove(Mob* m) {
         if(o->second.erase(m) > 0) {
             if(o->second.empty()) {
                 o->first->blockedByObstacle = false;
+                updateLinkObstacles(o->first);
                 toDelete = true;
                 pathsChanged = true;
             }
@@ -203,6 +710,8 @@ void PathManager::handleObstacleRemove(Mob* m) {
     }
     
     if(pathsChanged) {
+        pathCache.clear();
+        
         //Re-calculate the paths of mobs taking paths.
         forIdx(m2, game.states.gameplay->mobs.all) {
             Mob* m2Ptr = game.states.gameplay->mobs.all[m2];
@@ -221,6 +730,10 @@ void PathManager::handleObstacleRemove(Mob* m) {
  * @param sectorPtr Pointer to the sector whose hazards got updated.
  */
 void PathManager::handleSectorHazardChange(Sector* sectorPtr) {
+    //Even if the sector had no known hazardous stops, it could have
+    //stops that are hazardous now, so any cached path could be outdated.
+    pathCache.clear();
+    
     //Remove relevant stops from our list.
     bool pathsChanged = false;
     
@@ -253,6 +766,33 @@ void PathManager::handleSectorHazardChange(Sector* sectorPtr) {
 }
 
 
+/**
+ * @brief Checks if one cached path key comes before another, for sorting.
+ *
+ * @param k2 Key to compare against.
+ * @return Whether it comes before.
+ */
+bool PathManager::CachedPathKey::operator<(const CachedPathKey& k2) const {
+    if(startIdx != k2.startIdx) return startIdx < k2.startIdx;
+    if(endIdx != k2.endIdx) return endIdx < k2.endIdx;
+    if(flags != k2.flags) return flags < k2.flags;
+    return profileIdx < k2.profileIdx;
+}
+
+
+/**
+ * @brief Updates the obstacle information of the path chain that a link
+ * belongs to, after the link got blocked or unblocked by an obstacle.
+ *
+ * @param lPtr The link.
+ */
+void PathManager::updateLinkObstacles(PathLink* lPtr) {
+    auto cIt = linkChainIdxs.find(lPtr);
+    if(cIt == linkChainIdxs.end()) return;
+    chains[cIt->second].updateObstacles();
+}
+
+
 #pragma endregion
 #pragma region Path stop
 
@@ -409,12 +949,173 @@ PathLink* PathStop::getLink(const PathStop* otherStop) const {
 }
 
 
+#pragma endregion
+#pragma region Path stop grid
+
+
+/**
+ * @brief Builds the grid, covering all of the given stops.
+ *
+ * @param stops List of all path stops. Their indexes must be up-to-date.
+ */
+void PathStopGrid::build(const vector<PathStop*>& stops) {
+    clear();
+    if(stops.empty()) return;
+    
+    //Figure out the region to cover.
+    Point tl = stops[0]->center;
+    Point br = stops[0]->center;
+    forIdx(s, stops) {
+        PathStop* sPtr = stops[s];
+        tl.x = std::min(tl.x, sPtr->center.x - sPtr->radius);
+        tl.y = std::min(tl.y, sPtr->center.y - sPtr->radius);
+        br.x = std::max(br.x, sPtr->center.x + sPtr->radius);
+        br.y = std::max(br.y, sPtr->center.y + sPtr->radius);
+    }
+    
+    topLeftCorner = tl;
+    nCols = floor((br.x - tl.x) / PATHS::STOP_GRID_CELL_SIZE) + 1;
+    nRows = floor((br.y - tl.y) / PATHS::STOP_GRID_CELL_SIZE) + 1;
+    cells.assign(nCols * nRows, vector<PathStop*>());
+    checkStamps.assign(stops.size(), 0);
+    
+    //Add each stop to every cell its circle overlaps.
+    forIdx(s, stops) {
+        PathStop* sPtr = stops[s];
+        size_t fromCol =
+            (sPtr->center.x - sPtr->radius - tl.x) /
+            PATHS::STOP_GRID_CELL_SIZE;
+        size_t toCol =
+            (sPtr->center.x + sPtr->radius - tl.x) /
+            PATHS::STOP_GRID_CELL_SIZE;
+        size_t fromRow =
+            (sPtr->center.y - sPtr->radius - tl.y) /
+            PATHS::STOP_GRID_CELL_SIZE;
+        size_t toRow =
+            (sPtr->center.y + sPtr->radius - tl.y) /
+            PATHS::STOP_GRID_CELL_SIZE;
+        for(size_t r = fromRow; r <= toRow; r++) {
+            for(size_t c = fromCol; c <= toCol; c++) {
+                cells[r * nCols + c].push_back(sPtr);
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief Clears the grid.
+ */
+void PathStopGrid::clear() {
+    topLeftCorner = Point();
+    nCols = 0;
+    nRows = 0;
+    cells.clear();
+    checkStamps.clear();
+    curCheckStamp = 0;
+}
+
+
+/**
+ * @brief Returns the path stop closest to the given point that can be taken.
+ * The distance to a stop takes its radius into account, and is 0 if the
+ * point is inside of it. Ties go to the stop with the lowest index.
+ *
+ * The cells are checked in rings around the point's cell, and the search
+ * stops as soon as no stop in any further ring can be closer
+ * than the best so far.
+ *
+ * @param pos Point to check.
+ * @param settings Settings about how the path should be followed.
+ * @param outDist If not nullptr, the distance to the stop is returned here.
+ * @return The stop, or nullptr if there is no stop that can be taken.
+ */
+PathStop* PathStopGrid::getClosestStop(
+    const Point& pos, const PathFollowSettings& settings, float* outDist
+) {
+    if(nCols == 0 || nRows == 0) return nullptr;
+    
+    curCheckStamp++;
+    if(curCheckStamp == 0) {
+        //Wrapped around. Make sure no old stamp passes as current.
+        std::fill(checkStamps.begin(), checkStamps.end(), 0);
+        curCheckStamp = 1;
+    }
+    
+    PathStop* bestStop = nullptr;
+    float bestDist = FLT_MAX;
+    
+    const auto checkCell = [&] (int col, int row) {
+        if(col < 0 || col >= (int) nCols) return;
+        if(row < 0 || row >= (int) nRows) return;
+        const vector<PathStop*>& cell = cells[row * nCols + col];
+        forIdx(s, cell) {
+            PathStop* sPtr = cell[s];
+            if(checkStamps[sPtr->idx] == curCheckStamp) continue;
+            checkStamps[sPtr->idx] = curCheckStamp;
+            
+            float d = Distance(pos, sPtr->center).toFloat() - sPtr->radius;
+            d = std::max(0.0f, d);
+            if(bestStop) {
+                if(d > bestDist) continue;
+                if(d == bestDist && sPtr->idx > bestStop->idx) continue;
+            }
+            
+            //We're not checking this earlier due to performance.
+            if(!canTakePathStop(sPtr, settings)) continue;
+            
+            bestStop = sPtr;
+            bestDist = d;
+        }
+    };
+    
+    int centerCol =
+        std::clamp(
+            (int) floor((pos.x - topLeftCorner.x) / PATHS::STOP_GRID_CELL_SIZE),
+            0, (int) nCols - 1
+        );
+    int centerRow =
+        std::clamp(
+            (int) floor((pos.y - topLeftCorner.y) / PATHS::STOP_GRID_CELL_SIZE),
+            0, (int) nRows - 1
+        );
+    int maxRing = (int) std::max(nCols, nRows);
+    
+    for(int ring = 0; ring <= maxRing; ring++) {
+        //Anything in this ring or beyond is at least this far away.
+        if(bestStop && bestDist < (ring - 1) * PATHS::STOP_GRID_CELL_SIZE) {
+            break;
+        }
+        
+        if(ring == 0) {
+            checkCell(centerCol, centerRow);
+            continue;
+        }
+        for(int c = centerCol - ring; c <= centerCol + ring; c++) {
+            checkCell(c, centerRow - ring);
+            checkCell(c, centerRow + ring);
+        }
+        for(int r = centerRow - ring + 1; r <= centerRow + ring - 1; r++) {
+            checkCell(centerCol - ring, r);
+            checkCell(centerCol + ring, r);
+        }
+    }
+    
+    if(outDist) *outDist = bestDist;
+    return bestStop;
+}
+
+
 #pragma endregion
 #pragma region Global functions
 
 
 /**
  * @brief Uses A* to get the shortest path between two nodes.
+ * The stops' indexes must be up-to-date.
+ *
+ * If no path exists, the search continues, this time going through links
+ * blocked by obstacles, and reusing the work done so far.
  *
  * @param outPath The stops to visit, in order, are returned here.
  * @param startNode Start node.
@@ -432,115 +1133,110 @@ PATH_RESULT aStar(
 ) {
     //https://en.wikipedia.org/wiki/A*_search_algorithm
     
-    /**
-     * @brief Represents a node's data in the algorithm.
-     */
-    struct Node {
-        //In the best known path to this node, this is the known
-        //distance from the start node to this one.
-        float sinceStart = FLT_MAX;
+    vector<PathStop*>& stops = game.curArea->pathStops;
+    AStarScratch& scr = game.curArea->pathFindingScratch;
+    const auto heapCmp = std::greater<std::pair<float, size_t> >();
+    
+    //Checks if a link leads to a better path towards its end stop,
+    //and if so, saves that and adds the end stop to the stops to visit.
+    const auto relax = [&] (size_t curIdx, const PathLink* lPtr) {
+        PathStop* neighbor = lPtr->endPtr;
+        size_t nIdx = neighbor->idx;
+        scr.initStop(nIdx);
         
-        //In the best known path to this node, this is the node that
-        //came before this one.
-        PathStop* prev = nullptr;
+        float tentativeScore = scr.sinceStart[curIdx] + lPtr->distance;
+        if(tentativeScore >= scr.sinceStart[nIdx]) return;
         
-        //Estimated distance if the final path takes this node.
-        float estimated = FLT_MAX;
+        //Found a better path from the start to this neighbor.
+        scr.sinceStart[nIdx] = tentativeScore;
+        scr.prev[nIdx] = curIdx;
+        scr.visited[nIdx] = false;
+        scr.toVisit.push_back(
+            std::make_pair(
+                tentativeScore +
+                Distance(neighbor->center, endNode->center).toFloat(),
+                nIdx
+            )
+        );
+        std::push_heap(scr.toVisit.begin(), scr.toVisit.end(), heapCmp);
     };
     
-    //All nodes that we want to visit.
-    unordered_set<PathStop*> toVisit;
-    //Data for all the nodes.
-    map<PathStop*, Node> data;
-    
     //Part 1: Initialize the algorithm.
-    toVisit.insert(startNode);
-    data[startNode].sinceStart = 0.0f;
-    data[startNode].estimated = 0.0f;
-    
-    //Start iterating.
-    while(!toVisit.empty()) {
-        //Part 2: Figure out what node to work on in this iteration.
-        PathStop* curNode = nullptr;
-        float curNodeDist = 0.0f;
-        Node curNodeData;
-        
-        for(auto u = toVisit.begin(); u != toVisit.end(); u++) {
-            Node n = data[*u];
-            float estDist = n.estimated;
-            
-            if(!curNode || estDist < curNodeDist) {
-                curNode = *u;
-                curNodeDist = estDist;
-                curNodeData = n;
-            }
-        }
-        
-        //Part 3: If the node we're processing is the end node, then
-        //that's it, best path found!
-        if(curNode == endNode) {
-            //Construct the path.
-            float td = data[endNode].sinceStart;
-            outPath.clear();
-            outPath.push_back(endNode);
-            PathStop* next = data[endNode].prev;
-            while(next) {
-                outPath.insert(outPath.begin(), next);
-                next = data[next].prev;
-            }
+    PathFollowSettings curSettings = settings;
+    bool ignoringObstacles =
+        hasFlag(settings.flags, PATH_FOLLOW_FLAG_IGNORE_OBSTACLES);
+    bool retriedIgnoringObstacles = false;
+    scr.startSearch(stops.size());
+    scr.initStop(startNode->idx);
+    scr.sinceStart[startNode->idx] = 0.0f;
+    scr.toVisit.push_back(std::make_pair(0.0f, startNode->idx));
+    
+    while(true) {
+        //Start iterating.
+        while(!scr.toVisit.empty()) {
+            //Part 2: Figure out what node to work on in this iteration.
+            std::pop_heap(scr.toVisit.begin(), scr.toVisit.end(), heapCmp);
+            size_t curIdx = scr.toVisit.back().second;
+            scr.toVisit.pop_back();
             
-            if(outTotalDist) *outTotalDist = td;
-            return PATH_RESULT_NORMAL_PATH;
+            //Outdated entry for a node that's been visited since.
+            if(scr.visited[curIdx]) continue;
             
-        }
-        
-        //This node's been visited.
-        toVisit.erase(curNode);
-        
-        //Part 4: Check the neighbors.
-        forIdx(l, curNode->links) {
-            PathLink* lPtr = curNode->links[l];
-            PathStop* neighbor = lPtr->endPtr;
+            PathStop* curNode = stops[curIdx];
             
-            //Can this link be traversed?
-            if(!canTraversePathLink(lPtr, settings)) {
-                continue;
+            //Part 3: If the node we're processing is the end node, then
+            //that's it, best path found!
+            if(curNode == endNode) {
+                //Construct the path.
+                outPath.clear();
+                size_t next = curIdx;
+                while(next != INVALID) {
+                    outPath.push_back(stops[next]);
+                    next = scr.prev[next];
+                }
+                std::reverse(outPath.begin(), outPath.end());
+                
+                if(outTotalDist) *outTotalDist = scr.sinceStart[curIdx];
+                return
+                    retriedIgnoringObstacles ?
+                    PATH_RESULT_PATH_WITH_OBSTACLES :
+                    PATH_RESULT_NORMAL_PATH;
             }
             
-            float tentativeScore =
-                data[curNode].sinceStart + lPtr->distance;
+            //This node's been visited.
+            scr.visited[curIdx] = true;
+            
+            //Part 4: Check the neighbors.
+            forIdx(l, curNode->links) {
+                PathLink* lPtr = curNode->links[l];
                 
-            if(tentativeScore < data[neighbor].sinceStart) {
-                //Found a better path from the start to this neighbor.
-                data[neighbor].sinceStart = tentativeScore;
-                data[neighbor].prev = curNode;
-                data[neighbor].estimated =
-                    tentativeScore +
-                    Distance(neighbor->center, endNode->center).toFloat();
-                toVisit.insert(neighbor);
+                //Can this link be traversed?
+                if(!canTraversePathLink(lPtr, curSettings)) {
+                    if(!ignoringObstacles && lPtr->blockedByObstacle) {
+                        scr.obstacleLinks.push_back(lPtr);
+                    }
+                    continue;
+                }
+                
+                relax(curIdx, lPtr);
             }
         }
-    }
-    
-    //If we got to this point, there means that there is no available path!
-    
-    if(!hasFlag(settings.flags, PATH_FOLLOW_FLAG_IGNORE_OBSTACLES)) {
-        //Let's try again, this time ignoring obstacles.
-        PathFollowSettings newSettings = settings;
-        enableFlag(newSettings.flags, PATH_FOLLOW_FLAG_IGNORE_OBSTACLES);
-        PATH_RESULT newResult =
-            aStar(
-                outPath,
-                startNode, endNode,
-                newSettings,
-                outTotalDist
-            );
-        if(newResult == PATH_RESULT_NORMAL_PATH) {
-            //If we only managed to succeed with this ignore-obstacle attempt,
-            //then that means a path exists, but there are obstacles.
-            return PATH_RESULT_PATH_WITH_OBSTACLES;
-        } else {
-            return newResult;
+        
+        //If we got to this point, there means that there is no
+        //available path!
+        if(ignoringObstacles) break;
+        
+        //Let's try again, this time ignoring obstacles. Everything visited
+        //so far still holds, so just go from the links that were
+        //skipped because of obstacles. If we only manage to succeed like
+        //this, then that means a path exists, but there are obstacles.
+        ignoringObstacles = true;
+        retriedIgnoringObstacles = true;
+        enableFlag(curSettings.flags, PATH_FOLLOW_FLAG_IGNORE_OBSTACLES);
+        forIdx(l, scr.obstacleLinks) {
+            PathLink* lPtr = scr.obstacleLinks[l];
+            if(!canTraversePathLink(lPtr, curSettings)) continue;
+            relax(lPtr->startPtr->idx, lPtr);
         }
     }
     
@@ -804,45 +1500,61 @@ PATH_RESULT getPath(
         end;
         
     //Start by finding the closest stops to the start and finish.
+    PathManager& pathMgr = game.states.gameplay->pathMgr;
     PathStop* closestToStart = nullptr;
     PathStop* closestToEnd = nullptr;
     float closestToStartDist = 0.0f;
     float closestToEndDist = 0.0f;
     
-    forIdx(s, game.curArea->pathStops) {
-        PathStop* sPtr = game.curArea->pathStops[s];
-        
-        float distToStart =
-            Distance(startToUse, sPtr->center).toFloat() - sPtr->radius;
-        float distToEnd =
-            Distance(endToUse, sPtr->center).toFloat() - sPtr->radius;
-        distToStart = std::max(0.0f, distToStart);
-        distToEnd = std::max(0.0f, distToEnd);
-        
-        bool isNewStart =
-            !closestToStart || distToStart < closestToStartDist;
-        bool isNewEnd =
-            !closestToEnd || distToEnd < closestToEndDist;
+    if(pathMgr.cachesReady) {
+        closestToStart =
+            pathMgr.stopGrid.getClosestStop(
+                startToUse, settings, &closestToStartDist
+            );
+        closestToEnd =
+            pathMgr.stopGrid.getClosestStop(
+                endToUse, settings, &closestToEndDist
+            );
+    } else {
+        forIdx(s, game.curArea->pathStops) {
+            PathStop* sPtr = game.curArea->pathStops[s];
             
-        if(isNewStart || isNewEnd) {
-            //We actually want this stop. Check now if it can be used.
-            //We're not checking this earlier due to performance.
-            if(!canTakePathStop(sPtr, settings)) {
-                //Can't be taken. Skip.
+            //The area editor can add and remove stops at any time,
+            //so refresh the index while we're here.
+            sPtr->idx = s;
+            
+            float distToStart =
+                Distance(startToUse, sPtr->center).toFloat() - sPtr->radius;
+            float distToEnd =
+                Distance(endToUse, sPtr->center).toFloat() - sPtr->radius;
+            distToStart = std::max(0.0f, distToStart);
+            distToEnd = std::max(0.0f, distToEnd);
+            
+            bool isNewStart =
+                !closestToStart || distToStart < closestToStartDist;
+            bool isNewEnd =
+                !closestToEnd || distToEnd < closestToEndDist;
+                
+            if(isNewStart || isNewEnd) {
+                //We actually want this stop. Check now if it can be used.
+                //We're not checking this earlier due to performance.
+                if(!canTakePathStop(sPtr, settings)) {
+                    //Can't be taken. Skip.
+                    continue;
+                }
+            } else {
+                //Not the closest so far. Skip.
                 continue;
             }
-        } else {
-            //Not the closest so far. Skip.
-            continue;
-        }
-        
-        if(isNewStart) {
-            closestToStartDist = distToStart;
-            closestToStart = sPtr;
-        }
-        if(isNewEnd) {
-            closestToEndDist = distToEnd;
-            closestToEnd = sPtr;
+            
+            if(isNewStart) {
+                closestToStartDist = distToStart;
+                closestToStart = sPtr;
+            }
+            if(isNewEnd) {
+                closestToEndDist = distToEnd;
+                closestToEnd = sPtr;
+            }
         }
     }
     
@@ -879,19 +1591,31 @@ PATH_RESULT getPath(
         return PATH_RESULT_PATH_WITH_SINGLE_STOP;
     }
     
-    //Potential optimization: instead of calculating with this graph, consult
-    //a different one where nodes that only have two links are deleted.
+    //During gameplay, this uses a contracted graph where chains of stops
+    //that only have two links are skipped over.
     //e.g. A -> B -> C becomes A -> C.
     //This means traversing fewer nodes when figuring out the shortest path.
     
     //Calculate the path.
-    PATH_RESULT result =
-        aStar(
-            fullPath,
-            closestToStart, closestToEnd,
-            settings, outTotalDist
-        );
-        
+    PATH_RESULT result;
+    if(pathMgr.cachesReady) {
+        const vector<PathStop*>* cachedPath = nullptr;
+        result =
+            pathMgr.getCachedPath(
+                &cachedPath,
+                closestToStart, closestToEnd,
+                settings, outTotalDist
+            );
+        fullPath.assign(cachedPath->begin(), cachedPath->end());
+    } else {
+        result =
+            aStar(
+                fullPath,
+                closestToStart, closestToEnd,
+                settings, outTotalDist
+            );
+    }
+    
     if(outTotalDist && !fullPath.empty()) {
         *outTotalDist +=
             Distance(startToUse, fullPath[0]->center).toFloat();
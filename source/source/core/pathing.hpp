@@ -166,7 +166,9 @@ enum PATH_BLOCK_REASON {
 
 namespace PATHS {
 extern const float DEF_CHASE_TARGET_DISTANCE;
+extern const size_t MAX_CACHED_PATHS;
 extern const float MIN_STOP_RADIUS;
+extern const float STOP_GRID_CELL_SIZE;
 }
 
 
@@ -194,7 +196,8 @@ struct PathFollowSettings {
     //Some flags. Use PATH_FOLLOW_FLAG.
     Bitmask8 flags = 0;
     
-    //Invulnerabilities of the mob/carriers.
+    //Invulnerabilities of the mob/carriers. Sorted by pointer, which is
+    //how they come out of the mob types' vulnerability maps.
     vector<Hazard*> invulnerabilities;
     
     //If not empty, only follow path links with this label.
@@ -240,6 +243,9 @@ struct PathStop {
     //Sector it's on. Only applicable during gameplay. Cache for performance.
     Sector* sectorPtr = nullptr;
     
+    //Index number in the area's list of path stops. Cache for performance.
+    size_t idx = INVALID;
+    
     
     //--- Public function declarations ---
     
@@ -297,6 +303,146 @@ struct PathLink {
 };
 
 
+/**
+ * @brief Working memory for the A* algorithm, meant to be reused from one
+ * search to the next so that path-finding doesn't need to allocate anything.
+ * The data is indexed by path stop index. A stop's data is only valid if
+ * its generation matches the current search's, which means starting a new
+ * search doesn't require clearing everything.
+ */
+struct AStarScratch {
+
+    //--- Public members ---
+    
+    //Per stop, in the best known path to it, this is the known
+    //distance from the start stop.
+    vector<float> sinceStart;
+    
+    //Per stop, in the best known path to it, this is the index of the stop
+    //that came before. INVALID if none.
+    vector<size_t> prev;
+    
+    //Per stop, whether it has already been visited.
+    vector<bool> visited;
+    
+    //Per stop, the search generation its data belongs to.
+    vector<uint32_t> generations;
+    
+    //Per stop, in contracted searches, the index of the path chain taken
+    //to get to it in the best known path.
+    vector<size_t> prevChainIdxs;
+    
+    //Per stop, in contracted searches, the position in the path chain
+    //where the stretch that got to it started.
+    vector<size_t> prevChainFromPoss;
+    
+    //Per stop, in contracted searches, its position in the path chain
+    //that got to it.
+    vector<size_t> prevChainToPoss;
+    
+    //Stops to visit, as a min-heap of estimated distance and stop index.
+    vector<std::pair<float, size_t> > toVisit;
+    
+    //Links skipped only because of an obstacle.
+    vector<PathLink*> obstacleLinks;
+    
+    //Generation of the current search.
+    uint32_t curGeneration = 0;
+    
+    
+    //--- Public function declarations ---
+    
+    void initStop(size_t stopIdx);
+    void startSearch(size_t nrStops);
+    
+};
+
+
+/**
+ * @brief A sequence of path stops where every stop in the middle has exactly
+ * two neighbors, and is linked to both of them both ways. The contracted
+ * path graph goes from one end of a chain to the other in one step, instead
+ * of visiting each stop in the middle. A chain can also be made of a single
+ * link between two stops.
+ */
+struct PathChain {
+
+    //--- Public members ---
+    
+    //Stops in the chain, in order, including the stops at both ends.
+    vector<PathStop*> stops;
+    
+    //Links from each stop to the next one.
+    vector<PathLink*> forwardLinks;
+    
+    //Links from each stop to the previous one, starting with the link
+    //from the second stop to the first. Empty if the chain is one-way.
+    vector<PathLink*> backwardLinks;
+    
+    //Distance along the chain, from the first stop to each stop.
+    vector<float> distances;
+    
+    //Number of forward links blocked by obstacles, from the first stop
+    //to each stop. Cache for performance.
+    vector<size_t> forwardBlockedCounts;
+    
+    //Number of backward links blocked by obstacles, from the first stop
+    //to each stop. Cache for performance.
+    vector<size_t> backwardBlockedCounts;
+    
+    
+    //--- Public function declarations ---
+    
+    PathLink* getLink(size_t fromPos, size_t toPos) const;
+    bool hasObstacles(size_t fromPos, size_t toPos) const;
+    void updateObstacles();
+    
+};
+
+
+/**
+ * @brief Splits the area into square cells, with each cell listing the
+ * path stops that overlap it. This way, finding the closest stop to a point
+ * only needs to check the stops around it.
+ */
+struct PathStopGrid {
+
+    public:
+    
+    //--- Public function declarations ---
+    
+    void build(const vector<PathStop*>& stops);
+    void clear();
+    PathStop* getClosestStop(
+        const Point& pos, const PathFollowSettings& settings,
+        float* outDist = nullptr
+    );
+    
+    private:
+    
+    //--- Private members ---
+    
+    //Top-left corner of the grid.
+    Point topLeftCorner;
+    
+    //Number of columns.
+    size_t nCols = 0;
+    
+    //Number of rows.
+    size_t nRows = 0;
+    
+    //Stops in each cell, row by row.
+    vector<vector<PathStop*> > cells;
+    
+    //Per stop, the query in which it was last checked.
+    vector<uint32_t> checkStamps;
+    
+    //Number of the current query.
+    uint32_t curCheckStamp = 0;
+    
+};
+
+
 /**
  * @brief Represents a path link in the editor. This can represent either one
  * one-way link, or both of the links that make up a two-way link.
@@ -328,6 +474,8 @@ struct EditorPathLink {
  */
 struct PathManager {
 
+    public:
+    
     //--- Public members ---
     
     //Known obstructions.
@@ -336,15 +484,143 @@ struct PathManager {
     //Stops known to have hazards.
     unordered_set<PathStop*> hazardousStops;
     
+    //Are the path cache and the stop grid usable? Only during gameplay,
+    //since the area editor can change the stops at any time.
+    bool cachesReady = false;
+    
+    //Grid with the path stops.
+    PathStopGrid stopGrid;
+    
     
     //--- Public function declarations ---
     
+    PATH_RESULT getCachedPath(
+        const vector<PathStop*>** outPath,
+        PathStop* startStop, PathStop* endStop,
+        const PathFollowSettings& settings,
+        float* outTotalDist
+    );
     void handleAreaLoad();
     void handleObstacleAdd(Mob* m);
     void handleObstacleRemove(Mob* m);
     void handleSectorHazardChange(Sector* sectorPtr);
     void clear();
     
+    private:
+    
+    //--- Private misc. declarations ---
+    
+    /**
+     * @brief A stretch of a path chain, going from one of its stops to
+     * another, and the stop whose search node it starts from.
+     */
+    struct ChainStretch {
+    
+        //--- Public members ---
+        
+        //Index of the stop the stretch is traversed from.
+        size_t fromStopIdx = INVALID;
+        
+        //Index of the path chain.
+        size_t chainIdx = INVALID;
+        
+        //Position in the chain to start at.
+        size_t fromPos = 0;
+        
+        //Position in the chain to end at.
+        size_t toPos = 0;
+        
+    };
+    
+    /**
+     * @brief Everything that makes a path query between two stops unique.
+     */
+    struct CachedPathKey {
+    
+        //--- Public members ---
+        
+        //Index of the start stop.
+        size_t startIdx = INVALID;
+        
+        //Index of the end stop.
+        size_t endIdx = INVALID;
+        
+        //Path follow flags that affect which links can be taken.
+        Bitmask8 flags = 0;
+        
+        //Index of the invulnerabilities and label combination,
+        //in the list of path profiles.
+        size_t profileIdx = INVALID;
+        
+        
+        //--- Public function declarations ---
+        
+        bool operator<(const CachedPathKey& k2) const;
+        
+    };
+    
+    /**
+     * @brief The result of a path query between two stops.
+     */
+    struct CachedPath {
+    
+        //--- Public members ---
+        
+        //Stops to visit, in order.
+        vector<PathStop*> path;
+        
+        //Total distance.
+        float totalDist = 0.0f;
+        
+        //The operation's result.
+        PATH_RESULT result = PATH_RESULT_NOT_CALCULATED;
+        
+    };
+    
+    
+    //--- Private members ---
+    
+    //Results of past path queries. Emptied whenever an obstacle or hazard
+    //changes, since that makes them outdated.
+    map<CachedPathKey, CachedPath> pathCache;
+    
+    //Combinations of invulnerabilities and label used in path queries.
+    //The keys of the path cache refer to these by index.
+    vector<std::pair<vector<Hazard*>, string> > pathProfiles;
+    
+    //Chains of stops that make up the contracted path graph.
+    vector<PathChain> chains;
+    
+    //Per stop, the chains that start or end at it, and whether it's at the
+    //start, meaning the chain is traversed forward. Empty for stops in the
+    //middle of a chain.
+    vector<vector<std::pair<size_t, bool> > > stopChainExits;
+    
+    //Per stop, if it's in the middle of a chain, the chain's index.
+    //INVALID otherwise.
+    vector<size_t> stopChainIdxs;
+    
+    //Per stop, if it's in the middle of a chain, its position in it.
+    vector<size_t> stopChainPoss;
+    
+    //Index of the chain each link belongs to.
+    map<PathLink*, size_t> linkChainIdxs;
+    
+    //Stretches skipped in the current search only because of obstacles.
+    vector<ChainStretch> obstacleStretches;
+    
+    
+    //--- Private function declarations ---
+    
+    void buildChains();
+    PATH_RESULT contractedAStar(
+        vector<PathStop*>& outPath,
+        PathStop* startStop, PathStop* endStop,
+        const PathFollowSettings& settings,
+        float* outTotalDist
+    );
+    void updateLinkObstacles(PathLink* lPtr);
+    
 };
 
 
@@ -72,6 +72,9 @@ struct Player {
     //Viewport during gameplay.
     Viewport view;
     
+    //Camera center as of the previous fixed-step logic tick.
+    Point prevTickCamCenter;
+    
     //The HUD.
     Hud* hud = nullptr;
     
@@ -12,12 +12,162 @@
 
 #include "replay.hpp"
 
+#include "../util/allegro_utils.hpp"
+
 
 using std::size_t;
 using std::string;
 using std::vector;
 
 
+namespace REPLAY {
+
+//Magic number at the start of a replay file, so it can be told apart from
+//the first format, which had none. These are the characters "PKRP".
+const uint32_t FILE_MAGIC = 0x504B5250;
+
+//Version of the replay file format that gets written.
+const unsigned char FORMAT_VERSION = 2;
+
+//Magic number at the very end of a replay file, after the offset of the
+//keyframe index. These are the characters "PKRI".
+const uint32_t INDEX_MAGIC = 0x504B5249;
+
+//Magic number at the start of an input replay file.
+//These are the characters "PKIN".
+const uint32_t INPUT_FILE_MAGIC = 0x504B494E;
+
+//Version of the input replay file format that gets written.
+const unsigned char INPUT_FORMAT_VERSION = 1;
+
+//Write a keyframe at least once every this many states.
+const size_t KEYFRAME_INTERVAL = 32;
+
+}
+
+
+/**
+ * @brief Adds a frame to the end of the input replay.
+ *
+ * @param deltaT Time the frame took, in seconds.
+ * @param mouseCursorWinPos Position of the mouse cursor,
+ * in window coordinates.
+ * @param actions Player actions that happened in the frame.
+ */
+void InputReplay::addFrame(
+    float deltaT, const Point& mouseCursorWinPos,
+    const vector<Inpution::Action>& actions
+) {
+    InputReplayFrame frame;
+    frame.deltaT = deltaT;
+    frame.mouseCursorWinPos = mouseCursorWinPos;
+    frame.actions = actions;
+    frames.push_back(frame);
+}
+
+
+/**
+ * @brief Clears all data about this input replay.
+ */
+void InputReplay::clear() {
+    areaPath.clear();
+    seed = 0;
+    frames.clear();
+}
+
+
+/**
+ * @brief Loads input replay data from a file in the disk.
+ *
+ * @param filePath Path to the file to load from.
+ * @return Whether it succeeded.
+ */
+bool InputReplay::loadFromFile(const string& filePath) {
+    clear();
+    ALLEGRO_FILE* file = al_fopen(filePath.c_str(), "rb");
+    if(!file) return false;
+    
+    if(
+        (uint32_t) al_fread32be(file) != REPLAY::INPUT_FILE_MAGIC ||
+        al_fgetc(file) != REPLAY::INPUT_FORMAT_VERSION
+    ) {
+        al_fclose(file);
+        return false;
+    }
+    
+    seed = al_fread32be(file);
+    areaPath.resize(freadVarint(file));
+    if(!areaPath.empty()) {
+        al_fread(file, &areaPath[0], areaPath.size());
+    }
+    
+    size_t nFrames = freadVarint(file);
+    for(size_t f = 0; f < nFrames && !al_feof(file); f++) {
+        InputReplayFrame frame;
+        frame.deltaT = freadFloat32be(file);
+        frame.mouseCursorWinPos.x = freadFloat32be(file);
+        frame.mouseCursorWinPos.y = freadFloat32be(file);
+        
+        size_t nActions = freadVarint(file);
+        for(size_t a = 0; a < nActions && !al_feof(file); a++) {
+            Inpution::Action action;
+            action.actionTypeId = freadVarint(file);
+            action.playerNr = freadVarint(file);
+            action.value = freadFloat32be(file);
+            action.flags = al_fgetc(file);
+            action.reinsertionLifetime = freadFloat32be(file);
+            frame.actions.push_back(action);
+        }
+        
+        frames.push_back(frame);
+    }
+    
+    bool success = !al_feof(file) && frames.size() == nFrames;
+    al_fclose(file);
+    return success;
+}
+
+
+/**
+ * @brief Saves input replay data to a file in the disk.
+ *
+ * @param filePath Path to the file to save to.
+ * @return Whether it succeeded.
+ */
+bool InputReplay::saveToFile(const string& filePath) const {
+    ALLEGRO_FILE* file = al_fopen(filePath.c_str(), "wb");
+    if(!file) return false;
+    
+    al_fwrite32be(file, (int32_t) REPLAY::INPUT_FILE_MAGIC);
+    al_fputc(file, REPLAY::INPUT_FORMAT_VERSION);
+    al_fwrite32be(file, seed);
+    fwriteVarint(file, areaPath.size());
+    al_fwrite(file, areaPath.c_str(), areaPath.size());
+    
+    fwriteVarint(file, frames.size());
+    forIdx(f, frames) {
+        const InputReplayFrame& frame = frames[f];
+        fwriteFloat32be(file, frame.deltaT);
+        fwriteFloat32be(file, frame.mouseCursorWinPos.x);
+        fwriteFloat32be(file, frame.mouseCursorWinPos.y);
+        
+        fwriteVarint(file, frame.actions.size());
+        forIdx(a, frame.actions) {
+            const Inpution::Action& action = frame.actions[a];
+            fwriteVarint(file, action.actionTypeId);
+            fwriteVarint(file, action.playerNr);
+            fwriteFloat32be(file, action.value);
+            al_fputc(file, action.flags);
+            fwriteFloat32be(file, action.reinsertionLifetime);
+        }
+    }
+    
+    bool success = !al_ferror(file);
+    al_fclose(file);
+    return success;
+}
+
+
 /**
  * @brief Construct a new replay object.
  */
@@ -47,10 +197,17 @@ void Replay::addNewState(
     const vector<Mob*>& obstacleList,
     size_t curLeaderIdx
 ) {
-    states.push_back(ReplayState());
-    ReplayState* newStatePtr = &(states[states.size() - 1]);
+    ReplayState* newStatePtr = nullptr;
+    if(recordingWriter.isOpen()) {
+        recordingState.elements.clear();
+        recordingState.events.clear();
+        newStatePtr = &recordingState;
+    } else {
+        states.push_back(ReplayState());
+        newStatePtr = &(states[states.size() - 1]);
+    }
     
-    vector<Mob*> newStateMobs;
+    newStateMobs.clear();
     newStateMobs.insert(
         newStateMobs.end(), leaderList.begin(), leaderList.end()
     );
@@ -69,10 +226,12 @@ void Replay::addNewState(
     newStateMobs.insert(
         newStateMobs.end(), obstacleList.begin(), obstacleList.end()
     );
+    newStateMobSet.clear();
+    newStateMobSet.insert(newStateMobs.begin(), newStateMobs.end());
     
     if(!prevStateMobs.empty()) {
         forIdx(pm, prevStateMobs) {
-            if(!isInContainer(newStateMobs, prevStateMobs[pm])) {
+            if(newStateMobSet.find(prevStateMobs[pm]) == newStateMobSet.end()) {
                 //This isn't in the list of new mobs. That means it was removed.
                 ReplayEvent ev(REPLAY_EVENT_REMOVED, pm);
                 newStatePtr->events.push_back(ev);
@@ -80,7 +239,10 @@ void Replay::addNewState(
         }
         
         forIdx(m, newStateMobs) {
-            if(!isInContainer(prevStateMobs, newStateMobs[m])) {
+            if(
+                prevStateMobSet.find(newStateMobs[m]) ==
+                prevStateMobSet.end()
+            ) {
                 //This isn't in the list of previous mobs. That means it's new.
                 ReplayEvent ev(REPLAY_EVENT_ADDED, m);
                 newStatePtr->events.push_back(ev);
@@ -133,7 +295,12 @@ void Replay::addNewState(
         );
     }
     
-    prevStateMobs = newStateMobs;
+    prevStateMobs.swap(newStateMobs);
+    prevStateMobSet.swap(newStateMobSet);
+    
+    if(recordingWriter.isOpen()) {
+        recordingWriter.writeState(*newStatePtr);
+    }
 }
 
 
@@ -144,26 +311,221 @@ void Replay::clear() {
     states.clear();
     prevLeaderIdx = INVALID;
     prevStateMobs.clear();
+    prevStateMobSet.clear();
 }
 
 
 /**
- * @brief Finishes the recording of a new replay.
+ * @brief Finishes the recording of a new replay. If it was being streamed
+ * to a file, the file is finished and closed.
  */
 void Replay::finishRecording() {
+    recordingWriter.finish();
     clear();
 }
 
 
 /**
- * @brief Loads replay data from a file in the disk.
+ * @brief Loads replay data from a file in the disk. Files in the
+ * first format are also supported.
  *
  * @param filePath Path to the file to load from.
  */
 void Replay::loadFromFile(const string& filePath) {
     clear();
     ALLEGRO_FILE* file = al_fopen(filePath.c_str(), "rb");
+    if(!file) return;
+    
+    if((uint32_t) al_fread32be(file) != REPLAY::FILE_MAGIC) {
+        al_fseek(file, 0, ALLEGRO_SEEK_SET);
+        readV1States(file);
+        al_fclose(file);
+        return;
+    }
+    if(al_fgetc(file) != REPLAY::FORMAT_VERSION) {
+        al_fclose(file);
+        return;
+    }
+    
+    ReplayState emptyState;
+    ReplayState newState;
+    while(
+        readFrame(
+            file, states.empty() ? emptyState : states.back(), &newState
+        )
+    ) {
+        states.push_back(newState);
+    }
+    
+    al_fclose(file);
+}
+
+
+/**
+ * @brief Loads a single state from a replay file in the disk, without
+ * loading the others. Thanks to the file's keyframe index, this only needs
+ * to decode the states from the keyframe before it onward.
+ *
+ * @param filePath Path to the file to load from.
+ * @param stateIdx Index of the state to load.
+ * @param outState The state is returned here.
+ * @return Whether it succeeded.
+ */
+bool Replay::loadStateFromFile(
+    const string& filePath, size_t stateIdx, ReplayState* outState
+) const {
+    ALLEGRO_FILE* file = al_fopen(filePath.c_str(), "rb");
+    if(!file) return false;
+    
+    //Find the keyframe index.
+    bool valid =
+        (uint32_t) al_fread32be(file) == REPLAY::FILE_MAGIC &&
+        al_fgetc(file) == REPLAY::FORMAT_VERSION &&
+        al_fseek(file, -12, ALLEGRO_SEEK_END);
+    uint64_t indexOffset = (uint32_t) al_fread32be(file);
+    indexOffset = (indexOffset << 32) | (uint32_t) al_fread32be(file);
+    valid &=
+        (uint32_t) al_fread32be(file) == REPLAY::INDEX_MAGIC &&
+        al_fseek(file, indexOffset, ALLEGRO_SEEK_SET) &&
+        al_fgetc(file) == REPLAY_FRAME_END;
+    size_t nStates = freadVarint(file);
+    if(!valid || stateIdx >= nStates) {
+        al_fclose(file);
+        return false;
+    }
+    
+    //Pick the last keyframe at or before the state.
+    size_t nKeyframes = freadVarint(file);
+    size_t keyframeStateIdx = 0;
+    int64_t keyframeOffset = 0;
+    for(size_t k = 0; k < nKeyframes; k++) {
+        size_t kStateIdx = freadVarint(file);
+        int64_t kOffset = freadVarint(file);
+        if(kStateIdx > stateIdx) break;
+        keyframeStateIdx = kStateIdx;
+        keyframeOffset = kOffset;
+    }
+    
+    //Decode from there.
+    al_fseek(file, keyframeOffset, ALLEGRO_SEEK_SET);
+    ReplayState prevState;
+    for(size_t s = keyframeStateIdx; s <= stateIdx; s++) {
+        if(!readFrame(file, prevState, outState)) {
+            al_fclose(file);
+            return false;
+        }
+        prevState = *outState;
+    }
+    
+    al_fclose(file);
+    return true;
+}
+
+
+/**
+ * @brief Reads a frame from a replay file, and decodes it into a state.
+ *
+ * @param file File to read from.
+ * @param prevState The state before this one. Only used for delta frames.
+ * @param outState The state is returned here.
+ * @return Whether a state was read. This is false at the end of the frames,
+ * or if the frame is invalid.
+ */
+bool Replay::readFrame(
+    ALLEGRO_FILE* file, const ReplayState& prevState,
+    ReplayState* outState
+) const {
+    outState->elements.clear();
+    outState->events.clear();
+    
+    int frameType = al_fgetc(file);
+    if(frameType != REPLAY_FRAME_KEY && frameType != REPLAY_FRAME_DELTA) {
+        return false;
+    }
     
+    size_t nEvents = freadVarint(file);
+    if(al_feof(file)) return false;
+    outState->events.reserve(nEvents);
+    for(size_t e = 0; e < nEvents; e++) {
+        REPLAY_EVENT type = (REPLAY_EVENT) al_fgetc(file);
+        outState->events.push_back(ReplayEvent(type, freadVarint(file)));
+    }
+    
+    if(frameType == REPLAY_FRAME_KEY) {
+        size_t nElements = freadVarint(file);
+        if(al_feof(file)) return false;
+        outState->elements.reserve(nElements);
+        for(size_t e = 0; e < nElements; e++) {
+            REPLAY_ELEMENT type = (REPLAY_ELEMENT) al_fgetc(file);
+            int64_t x = freadSignedVarint(file);
+            int64_t y = freadSignedVarint(file);
+            outState->elements.push_back(ReplayElement(type, Point(x, y)));
+        }
+        return !al_feof(file);
+    }
+    
+    //Delta frame. Figure out which elements were added and removed.
+    vector<bool> removed(prevState.elements.size(), false);
+    size_t nRemoved = 0;
+    size_t nAdded = 0;
+    forIdx(e, outState->events) {
+        const ReplayEvent& ev = outState->events[e];
+        if(ev.type == REPLAY_EVENT_REMOVED) {
+            if(ev.data >= removed.size() || removed[ev.data]) return false;
+            removed[ev.data] = true;
+            nRemoved++;
+        } else if(ev.type == REPLAY_EVENT_ADDED) {
+            nAdded++;
+        }
+    }
+    size_t nElements = prevState.elements.size() - nRemoved + nAdded;
+    vector<bool> added(nElements, false);
+    forIdx(e, outState->events) {
+        const ReplayEvent& ev = outState->events[e];
+        if(ev.type != REPLAY_EVENT_ADDED) continue;
+        if(ev.data >= added.size() || added[ev.data]) return false;
+        added[ev.data] = true;
+    }
+    
+    //Decode the elements. Those that stayed are in the same order.
+    outState->elements.reserve(nElements);
+    size_t prevIdx = 0;
+    for(size_t e = 0; e < nElements; e++) {
+        if(added[e]) {
+            REPLAY_ELEMENT type = (REPLAY_ELEMENT) al_fgetc(file);
+            int64_t x = freadSignedVarint(file);
+            int64_t y = freadSignedVarint(file);
+            outState->elements.push_back(ReplayElement(type, Point(x, y)));
+            continue;
+        }
+        
+        while(removed[prevIdx]) prevIdx++;
+        const ReplayElement& prevElement = prevState.elements[prevIdx];
+        int64_t dx = freadSignedVarint(file);
+        int64_t dy = freadSignedVarint(file);
+        outState->elements.push_back(
+            ReplayElement(
+                prevElement.type,
+                Point(
+                    (int64_t) prevElement.pos.x + dx,
+                    (int64_t) prevElement.pos.y + dy
+                )
+            )
+        );
+        prevIdx++;
+    }
+    
+    return !al_feof(file);
+}
+
+
+/**
+ * @brief Reads all states from a replay file in the first format, which
+ * saves every state in full.
+ *
+ * @param file File to read from.
+ */
+void Replay::readV1States(ALLEGRO_FILE* file) {
     size_t nStates = al_fread32be(file);
     states.reserve(nStates);
     
@@ -206,27 +568,28 @@ void Replay::loadFromFile(const string& filePath) {
  * @param filePath Path to the file to save to.
  */
 void Replay::saveToFile(const string& filePath) const {
-    ALLEGRO_FILE* file = al_fopen(filePath.c_str(), "wb");
+    ReplayWriter writer;
+    if(!writer.start(filePath)) return;
     
-    al_fwrite32be(file, (int32_t) states.size());
     forIdx(s, states) {
-        const ReplayState* sPtr = &states[s];
-        
-        al_fwrite32be(file, (int32_t) sPtr->elements.size());
-        forIdx(e, sPtr->elements) {
-            al_fputc(file, sPtr->elements[e].type);
-            al_fwrite32be(file, floor(sPtr->elements[e].pos.x));
-            al_fwrite32be(file, floor(sPtr->elements[e].pos.y));
-        }
-        
-        al_fwrite32be(file, (int32_t) sPtr->events.size());
-        forIdx(e, sPtr->events) {
-            al_fputc(file, sPtr->events[e].type);
-            al_fwrite32be(file, (int32_t) sPtr->events[e].data);
-        }
+        writer.writeState(states[s]);
     }
     
-    al_fclose(file);
+    writer.finish();
+}
+
+
+/**
+ * @brief Starts recording a new replay, streaming each state to a file in
+ * the disk as it gets added, instead of keeping them in memory.
+ *
+ * @param filePath Path to the file to record to.
+ * @return Whether the file could be opened.
+ */
+bool Replay::startRecording(const string& filePath) {
+    recordingWriter.finish();
+    clear();
+    return recordingWriter.start(filePath);
 }
 
 
@@ -258,3 +621,179 @@ ReplayEvent::ReplayEvent(
     data(data) {
     
 }
+
+
+/**
+ * @brief Destroys the replay writer object, finishing the file if needed.
+ */
+ReplayWriter::~ReplayWriter() {
+    finish();
+}
+
+
+/**
+ * @brief Returns whether a state can be written as a delta frame of the
+ * previous one. This needs the added and removed elements to match the
+ * state's events, and the elements that stayed to keep their type.
+ *
+ * @param state State to check.
+ * @return Whether it can.
+ */
+bool ReplayWriter::canWriteDelta(const ReplayState& state) {
+    if(nrStates == 0) return false;
+    
+    removedFlags.assign(prevState.elements.size(), false);
+    addedFlags.assign(state.elements.size(), false);
+    forIdx(e, state.events) {
+        const ReplayEvent& ev = state.events[e];
+        if(ev.type == REPLAY_EVENT_REMOVED) {
+            if(ev.data >= removedFlags.size() || removedFlags[ev.data]) {
+                return false;
+            }
+            removedFlags[ev.data] = true;
+        } else if(ev.type == REPLAY_EVENT_ADDED) {
+            if(ev.data >= addedFlags.size() || addedFlags[ev.data]) {
+                return false;
+            }
+            addedFlags[ev.data] = true;
+        }
+    }
+    
+    size_t prevIdx = 0;
+    forIdx(e, state.elements) {
+        if(addedFlags[e]) continue;
+        while(prevIdx < removedFlags.size() && removedFlags[prevIdx]) {
+            prevIdx++;
+        }
+        if(prevIdx >= prevState.elements.size()) return false;
+        if(prevState.elements[prevIdx].type != state.elements[e].type) {
+            return false;
+        }
+        prevIdx++;
+    }
+    while(prevIdx < removedFlags.size() && removedFlags[prevIdx]) {
+        prevIdx++;
+    }
+    return prevIdx == prevState.elements.size();
+}
+
+
+/**
+ * @brief Writes the end marker and the keyframe index, and closes the file.
+ * Does nothing if no file is open.
+ */
+void ReplayWriter::finish() {
+    if(!file) return;
+    
+    int64_t indexOffset = al_ftell(file);
+    al_fputc(file, REPLAY_FRAME_END);
+    fwriteVarint(file, nrStates);
+    fwriteVarint(file, keyframeStateIdxs.size());
+    forIdx(k, keyframeStateIdxs) {
+        fwriteVarint(file, keyframeStateIdxs[k]);
+        fwriteVarint(file, keyframeOffsets[k]);
+    }
+    al_fwrite32be(file, (int32_t) ((uint64_t) indexOffset >> 32));
+    al_fwrite32be(file, (int32_t) indexOffset);
+    al_fwrite32be(file, (int32_t) REPLAY::INDEX_MAGIC);
+    
+    al_fclose(file);
+    file = nullptr;
+    prevState.elements.clear();
+    prevState.events.clear();
+    nrStates = 0;
+    keyframeStateIdxs.clear();
+    keyframeOffsets.clear();
+}
+
+
+/**
+ * @brief Returns whether a file is open for writing.
+ *
+ * @return Whether it is open.
+ */
+bool ReplayWriter::isOpen() const {
+    return file != nullptr;
+}
+
+
+/**
+ * @brief Opens a file for writing and writes the header. If another file
+ * was open, it is finished first.
+ *
+ * @param filePath Path to the file to write to.
+ * @return Whether the file could be opened.
+ */
+bool ReplayWriter::start(const string& filePath) {
+    finish();
+    file = al_fopen(filePath.c_str(), "wb");
+    if(!file) return false;
+    
+    al_fwrite32be(file, (int32_t) REPLAY::FILE_MAGIC);
+    al_fputc(file, REPLAY::FORMAT_VERSION);
+    return true;
+}
+
+
+/**
+ * @brief Writes a state to the file, as a keyframe or as a delta frame of
+ * the previous state.
+ *
+ * @param state State to write.
+ */
+void ReplayWriter::writeState(const ReplayState& state) {
+    if(!file) return;
+    
+    bool isKeyframe =
+        nrStates % REPLAY::KEYFRAME_INTERVAL == 0 || !canWriteDelta(state);
+    
+    if(isKeyframe) {
+        keyframeStateIdxs.push_back(nrStates);
+        keyframeOffsets.push_back(al_ftell(file));
+    }
+    al_fputc(file, isKeyframe ? REPLAY_FRAME_KEY : REPLAY_FRAME_DELTA);
+    
+    fwriteVarint(file, state.events.size());
+    forIdx(e, state.events) {
+        al_fputc(file, state.events[e].type);
+        fwriteVarint(file, state.events[e].data);
+    }
+    
+    if(isKeyframe) {
+        fwriteVarint(file, state.elements.size());
+    }
+    
+    size_t prevIdx = 0;
+    forIdx(e, state.elements) {
+        const ReplayElement& element = state.elements[e];
+        int64_t x = floor(element.pos.x);
+        int64_t y = floor(element.pos.y);
+        if(isKeyframe || addedFlags[e]) {
+            al_fputc(file, element.type);
+            fwriteSignedVarint(file, x);
+            fwriteSignedVarint(file, y);
+            continue;
+        }
+        
+        while(removedFlags[prevIdx]) prevIdx++;
+        const ReplayElement& prevElement = prevState.elements[prevIdx];
+        fwriteSignedVarint(file, x - (int64_t) prevElement.pos.x);
+        fwriteSignedVarint(file, y - (int64_t) prevElement.pos.y);
+        prevIdx++;
+    }
+    
+    prevState.elements.clear();
+    prevState.elements.reserve(state.elements.size());
+    forIdx(e, state.elements) {
+        prevState.elements.push_back(
+            ReplayElement(
+                state.elements[e].type,
+                Point(
+                    floor(state.elements[e].pos.x),
+                    floor(state.elements[e].pos.y)
+                )
+            )
+        );
+    }
+    nrStates++;
+}
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <unordered_set>
 #include <vector>
 
 #include <allegro5/allegro.h>
@@ -20,15 +21,30 @@
 #include "../content/mob/onion.hpp"
 #include "../content/mob/pikmin.hpp"
 #include "../content/mob/treasure.hpp"
+#include "../lib/inpution/inpution.hpp"
 #include "../util/general_utils.hpp"
 #include "../util/geometry_utils.hpp"
 
 
 using std::size_t;
 using std::string;
+using std::unordered_set;
 using std::vector;
 
 
+#pragma region Constants
+
+
+namespace REPLAY {
+extern const uint32_t FILE_MAGIC;
+extern const unsigned char FORMAT_VERSION;
+extern const uint32_t INDEX_MAGIC;
+extern const uint32_t INPUT_FILE_MAGIC;
+extern const unsigned char INPUT_FORMAT_VERSION;
+extern const size_t KEYFRAME_INTERVAL;
+}
+
+
 //Types of elements in a replay.
 enum REPLAY_ELEMENT {
 
@@ -68,6 +84,25 @@ enum REPLAY_EVENT {
 };
 
 
+//Types of frames in a replay file.
+enum REPLAY_FRAME {
+    
+    //A keyframe, which has every element's absolute position.
+    REPLAY_FRAME_KEY,
+    
+    //A delta frame, which only has what changed since the previous state.
+    REPLAY_FRAME_DELTA,
+    
+    //Marks the end of the frames. The keyframe index comes after.
+    REPLAY_FRAME_END,
+    
+};
+
+
+#pragma endregion
+#pragma region Classes
+
+
 /**
  * @brief Represents a Pikmin, a leader, or any other object we want to keep in
  * the replay.
@@ -132,6 +167,71 @@ struct ReplayState {
 };
 
 
+/**
+ * @brief Writes replay states to a file in the disk as they come, so that
+ * a recording doesn't need to keep every state in memory.
+ *
+ * The file starts with a magic number and the format version. Then comes
+ * one frame per state, each starting with its type and its events.
+ * Keyframes have every element's type and position, whereas delta frames
+ * only have what changed. In a delta frame, the elements that weren't
+ * added or removed are in the same order as in the previous state,
+ * so they only store how much they moved, and added elements store
+ * their type and position. The end marker is followed by an index
+ * of where each keyframe is, so a player can jump to any state by
+ * decoding from the keyframe before it.
+ * The file ends with a trailer: the index's offset, as a 64-bit integer,
+ * and another magic number.
+ * Positions are truncated to whole units, and all numbers except the
+ * magic numbers and the trailer are variable-length integers.
+ */
+struct ReplayWriter {
+    
+    //--- Public function declarations ---
+    
+    ReplayWriter() = default;
+    ~ReplayWriter();
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+    void finish();
+    bool isOpen() const;
+    bool start(const string& filePath);
+    void writeState(const ReplayState& state);
+    
+    
+    private:
+    
+    //--- Private members ---
+    
+    //File being written to.
+    ALLEGRO_FILE* file = nullptr;
+    
+    //Previous state written, with its positions truncated.
+    ReplayState prevState;
+    
+    //Number of states written so far.
+    size_t nrStates = 0;
+    
+    //Index of the state of each keyframe written so far.
+    vector<size_t> keyframeStateIdxs;
+    
+    //Offset in the file of each keyframe written so far.
+    vector<int64_t> keyframeOffsets;
+    
+    //Cache for performance.
+    vector<bool> removedFlags;
+    
+    //Cache for performance.
+    vector<bool> addedFlags;
+    
+    
+    //--- Private function declarations ---
+    
+    bool canWriteDelta(const ReplayState& state);
+    
+};
+
+
 /**
  * @brief A replay contains data about a playthrough of an area.
  *
@@ -139,9 +239,10 @@ struct ReplayState {
  * minimal and abstract data about what happened, such as what Pikmin
  * have moved where and when, considering the replay is only meant for the
  * player to review their strategy, not to actually watch the action again.
- * This replay is state-based, not delta-based. This means it does not save
- * the changes that have happened every moment, but rather saves the entire
- * relevant data of every moment.
+ * In memory, the replay is state-based, meaning it has the entire relevant
+ * data of every moment. On the disk, it's mostly delta-based, so the file
+ * stays small. While recording, states can be streamed straight to
+ * the file instead of being kept in memory.
  */
 class Replay {
 
@@ -168,7 +269,11 @@ public:
     void clear();
     void finishRecording();
     void loadFromFile(const string& filePath);
+    bool loadStateFromFile(
+        const string& filePath, size_t stateIdx, ReplayState* outState
+    ) const;
     void saveToFile(const string& filePath) const;
+    bool startRecording(const string& filePath);
     
 private:
 
@@ -177,7 +282,90 @@ private:
     //List of mobs in the previous state.
     vector<Mob*> prevStateMobs;
     
+    //Same as prevStateMobs, but for quick lookups.
+    unordered_set<Mob*> prevStateMobSet;
+    
     //Index of the previous leader.
     size_t prevLeaderIdx = INVALID;
     
+    //Writes the states to the disk while recording, if streaming.
+    ReplayWriter recordingWriter;
+    
+    //State being recorded, if streaming.
+    ReplayState recordingState;
+    
+    //Cache for performance.
+    vector<Mob*> newStateMobs;
+    
+    //Cache for performance.
+    unordered_set<Mob*> newStateMobSet;
+    
+    
+    //--- Private function declarations ---
+    
+    bool readFrame(
+        ALLEGRO_FILE* file, const ReplayState& prevState,
+        ReplayState* outState
+    ) const;
+    void readV1States(ALLEGRO_FILE* file);
+    
+};
+
+
+/**
+ * @brief One frame of an input replay.
+ */
+struct InputReplayFrame {
+    
+    //--- Public members ---
+    
+    //Time the frame took, in seconds.
+    float deltaT = 0.0f;
+    
+    //Position of the mouse cursor, in window coordinates.
+    Point mouseCursorWinPos;
+    
+    //Player actions that happened in the frame.
+    vector<Inpution::Action> actions;
+    
+};
+
+
+/**
+ * @brief An input replay contains everything needed to play a gameplay
+ * session again: the area, the randomness seed, and the player's inputs
+ * and time step of every frame.
+ *
+ * Unlike the normal replays, this doesn't save what happened, but rather
+ * what caused it, so feeding it back into the gameplay logic plays the
+ * session out the same way again, as long as the engine, the content,
+ * the options, and the window size are the same.
+ */
+struct InputReplay {
+    
+    //--- Public members ---
+    
+    //Path of the folder of the area that was played.
+    string areaPath;
+    
+    //State of the randomness manager when the area started loading.
+    int32_t seed = 0;
+    
+    //Frames, in order.
+    vector<InputReplayFrame> frames;
+    
+    
+    //--- Public function declarations ---
+    
+    void addFrame(
+        float deltaT, const Point& mouseCursorWinPos,
+        const vector<Inpution::Action>& actions
+    );
+    void clear();
+    bool loadFromFile(const string& filePath);
+    bool saveToFile(const string& filePath) const;
+    
 };
+
+
+#pragma endregion
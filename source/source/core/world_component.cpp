@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Andre 'Espyo' Silva 2013.
+ * The following source file belongs to the open-source project Pikifen.
+ * Please read the included README and LICENSE files for more information.
+ * Pikmin is copyright (c) Nintendo.
+ *
+ * === FILE DESCRIPTION ===
+ * World component class and related functions.
+ */
+
+#include <cstring>
+
+#include "world_component.hpp"
+
+
+/**
+ * @brief Removes all components, but keeps the memory for later.
+ */
+void WorldComponentList::clear() {
+    components.clear();
+}
+
+
+/**
+ * @brief Sorts the components by their Z coordinate. Components with the
+ * same Z keep the order they were added in.
+ *
+ * This is a radix sort on the bits of the Z coordinate, which takes linear
+ * time no matter how the components were added. Passes where all components
+ * have the same digit are skipped, which is common for the highest bits.
+ */
+void WorldComponentList::sort() {
+    size_t nComponents = components.size();
+    if(nComponents < 2) return;
+    
+    //Turn each Z into an unsigned number with the same order. Positive
+    //floats compare like their bits do, so setting the sign bit just puts
+    //them above the negatives. Negative floats compare backwards, so all of
+    //their bits get flipped.
+    sortKeys.resize(nComponents);
+    sortKeysBuffer.resize(nComponents);
+    for(size_t c = 0; c < nComponents; c++) {
+        //Adding 0 turns -0 into 0, so they count as the same.
+        float z = components[c].z + 0.0f;
+        uint32_t bits;
+        memcpy(&bits, &z, sizeof(bits));
+        bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+        sortKeys[c] = ((uint64_t) bits << 32) | (uint64_t) c;
+    }
+    
+    //Sort by each byte of the Z key, from the lowest to the highest.
+    //Each pass is stable, so same-Z components stay in their added order.
+    for(unsigned char pass = 0; pass < 4; pass++) {
+        unsigned char shift = 32 + pass * 8;
+        size_t counts[256] = {};
+        for(size_t c = 0; c < nComponents; c++) {
+            counts[(sortKeys[c] >> shift) & 0xFF]++;
+        }
+        if(counts[(sortKeys[0] >> shift) & 0xFF] == nComponents) {
+            //Every key has the same digit here.
+            continue;
+        }
+        
+        size_t offset = 0;
+        for(size_t d = 0; d < 256; d++) {
+            size_t count = counts[d];
+            counts[d] = offset;
+            offset += count;
+        }
+        for(size_t c = 0; c < nComponents; c++) {
+            size_t digit = (sortKeys[c] >> shift) & 0xFF;
+            sortKeysBuffer[counts[digit]] = sortKeys[c];
+            counts[digit]++;
+        }
+        sortKeys.swap(sortKeysBuffer);
+    }
+    
+    //Place the components in the sorted order.
+    componentsBuffer.resize(nComponents);
+    for(size_t c = 0; c < nComponents; c++) {
+        componentsBuffer[c] = components[sortKeys[c] & 0xFFFFFFFFu];
+    }
+    components.swap(componentsBuffer);
+}
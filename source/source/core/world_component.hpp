@@ -10,7 +10,13 @@
 
 #pragma once
 
+#include <cstdint>
 #include <cstdio>
+#include <vector>
+
+
+using std::size_t;
+using std::vector;
 
 
 struct Sector;
@@ -46,7 +52,41 @@ public:
     //Its Z coordinate.
     float z = 0.0f;
     
-    //Index in the list of world components. Used for sorting.
-    size_t idx = 0;
+};
+
+
+/**
+ * @brief A list of world components to draw, which can be sorted by
+ * their Z coordinate. Its memory is kept between frames, so that the list
+ * can be filled and sorted every frame without allocating anything.
+ */
+class WorldComponentList {
+
+public:
+
+    //--- Public members ---
+    
+    //Components, in the order they were added, or sorted after sort().
+    vector<WorldComponent> components;
+    
+    
+    //--- Public function declarations ---
+    
+    void clear();
+    void sort();
+    
+    
+private:
+
+    //--- Private members ---
+    
+    //Sort key of each component, followed by its index in the list.
+    vector<uint64_t> sortKeys;
+    
+    //Buffer for the sort keys, while sorting.
+    vector<uint64_t> sortKeysBuffer;
+    
+    //Buffer for the components, while sorting.
+    vector<WorldComponent> componentsBuffer;
     
 };
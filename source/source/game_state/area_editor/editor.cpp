@@ -3249,6 +3249,14 @@ void AreaEditor::registerChange(
 ) {
     changesMgr.markAsChanged();
     
+    //Any edit can change how the sectors' textures need to be drawn.
+    //Re-triangulated sectors get marked on their own, but edits like
+    //bottomless pit changes don't, so mark them all. This is only done
+    //on edits, so the texture vertexes are kept between frames otherwise.
+    forIdx(s, game.curArea->sectors) {
+        game.curArea->sectors[s]->textureVertexCache.geometryChanged = true;
+    }
+    
     if(game.options.areaEd.undoLimit == 0) {
         if(prePreparedState) {
             forgetPreparedState(prePreparedState);
@@ -27,6 +27,61 @@
 #pragma warning(disable: 4701)
 
 
+/**
+ * @brief When using fixed-step logic, swaps out the mobs' positions and the
+ * cameras' positions for ones interpolated between the previous logic tick
+ * and the latest one, so that drawing is smooth regardless of the logic rate.
+ * The real values are kept, and must be put back with
+ * restoreLogicInterpolation().
+ */
+void GameplayState::applyLogicInterpolation() {
+    size_t nrMobs = mobs.all.size();
+    logicRealMobCenters.resize(nrMobs);
+    logicRealMobBottomZs.resize(nrMobs);
+    logicRealCamCenters.resize(players.size());
+    
+    forIdx(m, mobs.all) {
+        Mob* mPtr = mobs.all[m];
+        logicRealMobCenters[m] = mPtr->center;
+        logicRealMobBottomZs[m] = mPtr->bottomZ;
+        if(
+            Distance(mPtr->prevTickCenter, mPtr->center) >
+            GAMEPLAY::MAX_INTERPOLATION_DIST
+        ) {
+            continue;
+        }
+        mPtr->center =
+            interpolatePoint(
+                logicInterpolationRatio, 0.0f, 1.0f,
+                mPtr->prevTickCenter, mPtr->center
+            );
+        mPtr->bottomZ =
+            interpolateNumber(
+                logicInterpolationRatio, 0.0f, 1.0f,
+                mPtr->prevTickBottomZ, mPtr->bottomZ
+            );
+    }
+    
+    forIdx(p, players) {
+        Player& player = players[p];
+        logicRealCamCenters[p] = player.view.cam.center;
+        if(
+            Distance(player.prevTickCamCenter, player.view.cam.center) >
+            GAMEPLAY::MAX_INTERPOLATION_DIST
+        ) {
+            continue;
+        }
+        player.view.cam.center =
+            interpolatePoint(
+                logicInterpolationRatio, 0.0f, 1.0f,
+                player.prevTickCamCenter, player.view.cam.center
+            );
+        player.view.updateTransformations();
+        player.view.updateWorldCorners();
+    }
+}
+
+
 /**
  * @brief Does the drawing for the main game loop.
  *
@@ -1662,7 +1717,7 @@ void GameplayState::drawThrowPreview(Player* player) {
     }
     
     //Check which edges exist near the throw.
-    set<Edge*> candidateEdges;
+    vector<size_t>& candidateEdges = edgeQueryBuffer;
     
     game.curArea->bmap.getEdgesInRect(
         RectCorners(
@@ -1702,7 +1757,8 @@ void GameplayState::drawThrowPreview(Player* player) {
         );
         
     //For each edge, check if it crosses the throw line.
-    for(Edge* e : candidateEdges) {
+    forIdx(c, candidateEdges) {
+        Edge* e = game.curArea->edges[candidateEdges[c]];
         if(!e->sectors[0] || !e->sectors[1]) {
             continue;
         }
@@ -1980,23 +2036,11 @@ void GameplayState::drawWorldComponents(
     ALLEGRO_BITMAP* customWallOffsetEffectBuffer = nullptr;
     ALLEGRO_BITMAP* customLiquidLimitEffectBuffer = nullptr;
     if(!bmpOutput) {
-        updateOffsetEffectBuffer(
-            view.worldCorners,
-            game.liquidLimitEffectCaches,
-            game.liquidLimitEffectBuffer,
-            true, view
-        );
-        updateOffsetEffectBuffer(
-            view.worldCorners,
-            game.wallSmoothingEffectCaches,
-            game.wallOffsetEffectBuffer,
-            true, view
+        game.liquidLimitEffectTiles.compose(
+            game.liquidLimitEffectBuffer, view
         );
-        updateOffsetEffectBuffer(
-            view.worldCorners,
-            game.wallShadowEffectCaches,
-            game.wallOffsetEffectBuffer,
-            false, view
+        game.wallOffsetEffectTiles.compose(
+            game.wallOffsetEffectBuffer, view
         );
         
     } else {
@@ -2031,19 +2075,24 @@ void GameplayState::drawWorldComponents(
         
     }
     
-    vector<WorldComponent> components;
-    //Let's reserve some space. We might need more or less,
-    //but this is a nice estimate.
-    components.reserve(
-        game.curArea->sectors.size() + //Sectors.
-        mobs.all.size() + //Mob shadows.
-        mobs.all.size() + //Mobs.
-        particles.getCount() //Particles.
-    );
+    //The list keeps its memory between frames.
+    worldComponents.clear();
+    vector<WorldComponent>& components = worldComponents.components;
     
-    //Sectors.
-    forIdx(s, game.curArea->sectors) {
-        Sector* sPtr = game.curArea->sectors[s];
+    //Sectors. Only the ones in the blockmap blocks the viewport covers
+    //need to be checked.
+    visibleSectors.clear();
+    if(bmpOutput) {
+        forIdx(s, game.curArea->sectors) {
+            visibleSectors.push_back(s);
+        }
+    } else {
+        //These also come sorted by index, so same-Z sectors get added
+        //in the area's order either way.
+        game.curArea->bmap.getSectorsInRect(view.worldCorners, visibleSectors);
+    }
+    forIdx(s, visibleSectors) {
+        Sector* sPtr = game.curArea->sectors[visibleSectors[s]];
         
         if(
             !bmpOutput &&
@@ -2143,19 +2192,7 @@ void GameplayState::drawWorldComponents(
     }
     
     //Time to draw!
-    forIdx(c, components) {
-        components[c].idx = c;
-    }
-    
-    sort(
-        components.begin(), components.end(),
-    [] (const WorldComponent & c1, const WorldComponent & c2) -> bool {
-        if(c1.z == c2.z) {
-            return c1.idx < c2.idx;
-        }
-        return c1.z < c2.z;
-    }
-    );
+    worldComponents.sort();
     
     float mobShadowStretch = 0;
     
@@ -2287,3 +2324,23 @@ void GameplayState::drawWorldComponents(
         al_destroy_bitmap(customWallOffsetEffectBuffer);
     }
 }
+
+
+/**
+ * @brief Puts back the real mob and camera positions after drawing with
+ * the ones from applyLogicInterpolation().
+ */
+void GameplayState::restoreLogicInterpolation() {
+    forIdx(m, mobs.all) {
+        if(m >= logicRealMobCenters.size()) break;
+        mobs.all[m]->center = logicRealMobCenters[m];
+        mobs.all[m]->bottomZ = logicRealMobBottomZs[m];
+    }
+    
+    forIdx(p, players) {
+        Player& player = players[p];
+        player.view.cam.center = logicRealCamCenters[p];
+        player.view.updateTransformations();
+        player.view.updateWorldCorners();
+    }
+}
@@ -117,12 +117,27 @@ extern const float LEADER_MOVEMENT_MAGNITUDE_THRESHOLD = 0.75f;
 //Multiply a leader's speed by this, when the analog stick is at the threshold.
 extern const float LEADER_MOVEMENT_MIN_SPEED_MULT = 0.50f;
 
+//When using fixed-step logic, if a mob or camera moves more than this
+//in one logic tick, it is drawn at its new spot, instead of interpolated.
+const float MAX_INTERPOLATION_DIST = 128.0f;
+
+//When using fixed-step logic, this is the maximum number of logic ticks
+//to run in one frame. Any time beyond that is dropped.
+const size_t MAX_LOGIC_TICKS_PER_FRAME = 5;
+
 //How long the HUD moves for when a menu is entered.
 const float MENU_ENTRY_HUD_MOVE_TIME = 0.4f;
 
 //How long the HUD moves for when a menu is exited.
 const float MENU_EXIT_HUD_MOVE_TIME = 0.5f;
 
+//For this long after being created, a mob runs its logic even if it's
+//inactive, so it can settle in. It also can't go to sleep until then.
+const float MOB_INACTIVE_GRACE_TIME = 0.1f;
+
+//Width and height of each cell in the mob interaction grid.
+const float MOB_INTERACTION_GRID_CELL_SIZE = 128.0f;
+
 //Alpha of the throw preview [0 - 1].
 const float PREVIEW_ALPHA = 0.66f;
 
@@ -416,7 +431,10 @@ void GameplayState::changeSprayCount(
  * @brief Draws the gameplay.
  */
 void GameplayState::doDrawing() {
+    bool interpolate = game.options.advanced.logicFps != 0;
+    if(interpolate) applyLogicInterpolation();
     doGameDrawing();
+    if(interpolate) restoreLogicInterpolation();
     
     if(game.perfMon) {
         game.perfMon->leaveState();
@@ -477,7 +495,16 @@ void GameplayState::doLogic() {
     //Game logic.
     if(!paused && !game.modal.responsive) {
         game.statistics.gameplayTime += regularDeltaT;
-        doGameplayLogic(game.deltaT * deltaTMult);
+        if(
+            game.options.advanced.logicFps != 0 &&
+            !game.makerTools.frameAdvanceMode
+        ) {
+            doFixedStepGameplayLogic(game.deltaT * deltaTMult);
+        } else {
+            logicTimeAccumulator = 0.0;
+            logicInterpolationRatio = 1.0f;
+            doGameplayLogic(game.deltaT * deltaTMult);
+        }
         doAestheticLogic(game.deltaT * deltaTMult);
     }
     doMenuLogic();
@@ -599,19 +626,7 @@ void GameplayState::enter() {
         player.view.updateTransformations();
     }
     
-    float zoomReaches[3] = {
-        game.config.rules.zoomClosestReach,
-        game.options.advanced.zoomMediumReach,
-        game.config.rules.zoomFarthestReach
-    };
-    float viewportReach =
-        sqrt(
-            players[0].view.windowRect.size.x *
-            players[0].view.windowRect.size.y
-        );
-    for(int z = 0; z < 3; z++) {
-        zoomLevels[z] = viewportReach / zoomReaches[z];
-    }
+    updateZoomLevels();
     
     forIdx(p, players) {
         Player& player = players[p];
@@ -1036,19 +1051,46 @@ Mob* GameplayState::getClosestGroupMember(
 
 
 /**
- * @brief Goes through all mobs and returns the mob has the given ID number.
+ * @brief Returns a checksum of the state of every mob. Two runs of the same
+ * gameplay session that end with different checksums did not play out
+ * the same way.
  *
- * @param id The ID.
- * @return The mob.
+ * @return The checksum.
  */
-Mob* GameplayState::getMobById(size_t id) const {
-    if(id == 0) return nullptr;
+uint64_t GameplayState::getLogicChecksum() const {
+    //FNV-1a hash of the bytes of each mob's relevant members.
+    uint64_t checksum = 0xcbf29ce484222325;
+    const auto mixIn = [&checksum] (const void* data, size_t size) {
+        const unsigned char* bytes = (const unsigned char*) data;
+        for(size_t b = 0; b < size; b++) {
+            checksum ^= bytes[b];
+            checksum *= 0x100000001b3;
+        }
+    };
     
     forIdx(m, mobs.all) {
-        if(mobs.all[m]->id == id) return mobs.all[m];
+        const Mob* mPtr = mobs.all[m];
+        mixIn(&mPtr->id, sizeof(mPtr->id));
+        mixIn(&mPtr->center.x, sizeof(mPtr->center.x));
+        mixIn(&mPtr->center.y, sizeof(mPtr->center.y));
+        mixIn(&mPtr->bottomZ, sizeof(mPtr->bottomZ));
+        mixIn(&mPtr->angle, sizeof(mPtr->angle));
+        mixIn(&mPtr->health, sizeof(mPtr->health));
     }
     
-    return nullptr;
+    return checksum;
+}
+
+
+/**
+ * @brief Returns the mob that has the given ID number.
+ *
+ * @param id The ID.
+ * @return The mob, or nullptr if there is none, or it was deleted.
+ */
+Mob* GameplayState::getMobById(size_t id) const {
+    if(id == 0 || id >= mobs.byId.size()) return nullptr;
+    return mobs.byId[id];
 }
 
 
@@ -1147,6 +1189,7 @@ void GameplayState::leave(const GAMEPLAY_LEAVE_TARGET target) {
     game.controls.setGameState(CONTROLS_GAME_STATE_MENUS);
     bossMusicState = BOSS_MUSIC_STATE_NEVER_PLAYED;
     saveStatistics();
+    game.finishInputRecording();
     
     switch(target) {
     case GAMEPLAY_LEAVE_TARGET_RETRY: {
@@ -1186,6 +1229,8 @@ void GameplayState::load() {
         game.perfMon->setPaused(false);
     }
     
+    game.startInputRecording(pathOfAreaToLoad);
+    
     loading = true;
     game.errors.prepareAreaLoad();
     wentToResults = false;
@@ -1461,12 +1506,22 @@ void GameplayState::load() {
     size_t nrAreaCellRows =
         ceil(areaHeight / GEOMETRY::AREA_CELL_SIZE) + 1;
         
-    areaActiveCells.clear();
-    areaActiveCells.assign(
-        nrAreaCellCols, vector<bool>(nrAreaCellRows, false)
+    areaActiveCells.setup(
+        game.curArea->bmap.topLeftCorner, nrAreaCellCols, nrAreaCellRows
     );
     
+    //Initialize the mob interaction grid.
+    mobInteractionGrid.setup(
+        game.curArea->bmap.topLeftCorner,
+        game.curArea->bmap.getBottomRightCorner()
+    );
+    
+    //Start the mob tick worker threads.
+    mobTickPool.setNrThreads(game.options.advanced.logicThreads);
+    
     //Initialize some other things.
+    logicTimeAccumulator = 0.0;
+    logicInterpolationRatio = 1.0f;
     areaRegions.clear();
     areaRegions.insert(
         areaRegions.begin(),
@@ -1485,7 +1540,7 @@ void GameplayState::load() {
     dayMinutes = game.curArea->dayTimeStart;
     
     ScriptVarManager sprayVars(game.curArea->sprayAmounts);
-    const map<string, string>& sprayVarMap = sprayVars.toMap();
+    map<string, string> sprayVarMap = sprayVars.toMap();
     
     for(const auto& s : sprayVarMap) {
         size_t sprayIdx = 0;
@@ -1578,22 +1633,31 @@ void GameplayState::load() {
         getWallShadowLength,
         getWallShadowColor
     );
+    updateZoomLevels();
+    game.liquidLimitEffectTiles.setup(
+    {&game.liquidLimitEffectCaches}, zoomLevels[0]
+    );
+    game.wallOffsetEffectTiles.setup(
+    {&game.wallSmoothingEffectCaches, &game.wallShadowEffectCaches},
+    zoomLevels[0]
+    );
     
-    //TODO Uncomment this when replays are implemented.
-    /*
-    replayTimer = timer(
-        GAMEPLAY::REPLAY_SAVE_FREQUENCY,
-    [this] () {
-        this->replayTimer.start();
-        vector<mob*> obstacles; //TODO
-        gameplayReplay.addNewState(
-            leaders, pikminList, enemies, treasures, onions, obstacles,
-            curLeaderIdx
+    //Record a replay of the session, streaming it to the disk. Benchmarks
+    //skip this, so that the disk writes don't affect their results.
+    if(game.options.advanced.recordReplays && !game.benchmark.enabled) {
+        gameplayReplay.startRecording(FILE_PATHS_FROM_ROOT::LAST_REPLAY);
+        replayTimer = Timer(
+            GAMEPLAY::REPLAY_SAVE_FREQUENCY,
+        [this] () {
+            this->replayTimer.start();
+            gameplayReplay.addNewState(
+                mobs.leaders, mobs.pikmin, mobs.enemies, mobs.treasures,
+                mobs.onions, vector<Mob*>(), players[0].leaderIdx
+            );
+        }
         );
+        replayTimer.start();
     }
-    );
-    replayTimer.start();
-    gameplayReplay.clear();*/
     
     //Report any errors with the loading process.
     game.errors.reportAreaLoadErrors();
@@ -1785,6 +1849,9 @@ void GameplayState::tryPause() {
  */
 void GameplayState::unload() {
     unloading = true;
+    game.finishInputRecording();
+    replayTimer.stop();
+    gameplayReplay.finishRecording();
     
     forIdx(p, players) {
         Player& player = players[p];
@@ -1814,16 +1881,25 @@ void GameplayState::unload() {
     scriptVM.clear();
     scriptDef.unload();
     
-    while(!mobs.all.empty()) {
-        deleteMob(*mobs.all.begin(), true);
-    }
+    deleteMobs(
+        ArenaVector<Mob*>(mobs.all.begin(), mobs.all.end(), frameArena), true
+    );
+    mobs.byId.clear();
+    frameArena.reset();
     
     if(lightmapBmp) {
         al_destroy_bitmap(lightmapBmp);
         lightmapBmp = nullptr;
     }
     
+    areaActiveCells.clear();
+    game.liquidLimitEffectTiles.clear();
+    game.wallOffsetEffectTiles.clear();
     missionMobGroups.clear();
+    mobInteractionGrid.clear();
+    mobTickAnimMobs.clear();
+    mobTickCommandQueues.clear();
+    mobTickPool.setNrThreads(1);
     pathMgr.clear();
     particles.clear();
     
@@ -1993,6 +2069,23 @@ void GameplayState::updateClosestGroupMembers(Player* player) {
 }
 
 
+/**
+ * @brief Updates the zoom levels the camera can switch between, based on
+ * the window's size.
+ */
+void GameplayState::updateZoomLevels() {
+    float zoomReaches[3] = {
+        game.config.rules.zoomClosestReach,
+        game.options.advanced.zoomMediumReach,
+        game.config.rules.zoomFarthestReach
+    };
+    float viewportReach = sqrt(game.winW * game.winH);
+    for(int z = 0; z < 3; z++) {
+        zoomLevels[z] = viewportReach / zoomReaches[z];
+    }
+}
+
+
 #pragma endregion
 #pragma region Interlude info
 
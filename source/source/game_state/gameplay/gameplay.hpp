@@ -22,6 +22,8 @@
 #include "../../core/player.hpp"
 #include "../../core/replay.hpp"
 #include "../../util/general_utils.hpp"
+#include "../../util/memory_utils.hpp"
+#include "../../util/thread_utils.hpp"
 #include "../game_state.hpp"
 #include "gameplay_utils.hpp"
 #include "hud.hpp"
@@ -62,8 +64,12 @@ extern const float LEADER_LAND_PART_MAX_SIZE;
 extern const float LEADER_LAND_PART_SIZE_MULT;
 extern const float LEADER_MOVEMENT_MAGNITUDE_THRESHOLD;
 extern const float LEADER_MOVEMENT_MIN_SPEED_MULT;
+extern const float MAX_INTERPOLATION_DIST;
+extern const size_t MAX_LOGIC_TICKS_PER_FRAME;
 extern const float MENU_ENTRY_HUD_MOVE_TIME;
 extern const float MENU_EXIT_HUD_MOVE_TIME;
+extern const float MOB_INACTIVE_GRACE_TIME;
+extern const float MOB_INTERACTION_GRID_CELL_SIZE;
 extern const float PREVIEW_ALPHA;
 extern const float PREVIEW_TEXTURE_SCALE;
 extern const float PREVIEW_TEXTURE_TIME_MULT;
@@ -249,7 +255,7 @@ public:
     
     //Divides the area into cells, and lists whether a given cell is
     //active for this frame or not.
-    vector<vector<bool> > areaActiveCells;
+    ActiveCellGrid areaActiveCells;
     
     //How many seconds since area load. Doesn't count when things are paused.
     float areaTimePassed = 0.0f;
@@ -299,6 +305,10 @@ public:
     //List of all mobs in the area.
     MobLists mobs;
     
+    //Broad phase grid for mob interactions. Code that moves a mob other than
+    //the one being ticked must tell it.
+    MobInteractionGrid mobInteractionGrid;
+    
     //Information about the currently active cutscene message box, if any.
     CutsceneMessageBox* cutsceneMsgBox = nullptr;
     
@@ -461,6 +471,14 @@ public:
     //Closest, middle, and farthest zoom levels. Cache for convenience.
     float zoomLevels[3] = { 0.0f, 0.0f, 0.0f };
     
+    //Memory for temporary containers in the gameplay logic. Everything in it
+    //is thrown away at the start of every logic tick.
+    Arena frameArena;
+    
+    //Indexes of the edges found by the latest blockmap edge query.
+    //Cache for performance.
+    vector<size_t> edgeQueryBuffer;
+    
     
     //--- Public function declarations ---
     
@@ -486,12 +504,14 @@ public:
     long getAmountOfTotalPikmin(
         const PikminType* filter = nullptr, bool aliveOnly = false
     );
+    uint64_t getLogicChecksum() const;
     Mob* getMobById(size_t id) const;
     void isNearEnemyAndBoss(bool* nearEnemy, bool* nearBoss);
     bool isPaused() const;
     void tryPause();
     void updateAvailableLeaders();
     void updateClosestGroupMembers(Player* player);
+    void updateZoomLevels();
     void sendScriptMessage(Mob* sender, Mob* receiver, string& msg) const;
     void sendScriptMessage(Mob* sender, ScriptVM* receiver, string& msg) const;
     void showInventoryUpdateDisplay(
@@ -518,6 +538,47 @@ private:
     //Bitmap that lights up the area when in blackout mode.
     ALLEGRO_BITMAP* lightmapBmp = nullptr;
     
+    //How far between the previous logic tick and the next one the current
+    //frame is, when using fixed-step logic [0 - 1].
+    float logicInterpolationRatio = 1.0f;
+    
+    //Real mob bottom Z coordinates, while they are swapped out for
+    //interpolated ones during drawing.
+    vector<float> logicRealMobBottomZs;
+    
+    //Real mob centers, while they are swapped out for
+    //interpolated ones during drawing.
+    vector<Point> logicRealMobCenters;
+    
+    //Real camera centers, while they are swapped out for
+    //interpolated ones during drawing.
+    vector<Point> logicRealCamCenters;
+    
+    //Time that still needs to be simulated by fixed-step logic ticks.
+    double logicTimeAccumulator = 0.0;
+    
+    //Indexes of the mobs that can interact with the current one.
+    //Cache for performance.
+    vector<size_t> mobInteractionNeighbors;
+    
+    //Mobs whose animations still need to be ticked this frame, in order.
+    vector<Mob*> mobTickAnimMobs;
+    
+    //Commands recorded by each thread during the parallel parts of
+    //the mob tick, to apply afterwards.
+    vector<vector<MobTickCommand> > mobTickCommandQueues;
+    
+    //Frame signals reached by the mob being animated, per thread.
+    //Kept here so their memory is reused every frame.
+    vector<vector<size_t> > mobTickFrameSignals;
+    
+    //Frame sounds reached by the mob being animated, per thread.
+    //Kept here so their memory is reused every frame.
+    vector<vector<size_t> > mobTickFrameSounds;
+    
+    //Worker threads for the parallel parts of the mob tick.
+    WorkerPool mobTickPool;
+    
     //Information about the current Onion menu, if any.
     OnionMenu* onionMenu = nullptr;
     
@@ -527,6 +588,14 @@ private:
     //Is the gameplay paused?
     bool paused = false;
     
+    //Indexes of the sectors that could be visible in the viewport being drawn.
+    //Cache for performance.
+    vector<size_t> visibleSectors;
+    
+    //World components to draw for the viewport being drawn.
+    //Cache for performance.
+    WorldComponentList worldComponents;
+    
     //The first frame shouldn't allow for input just yet, because
     //some things are still being set up within the first logic loop.
     //So forbid input until the second frame.
@@ -538,6 +607,7 @@ private:
     
     //--- Private function declarations ---
     
+    void applyLogicInterpolation();
     void doAestheticLeaderLogic(Player* player, float deltaT);
     void doAestheticLogic(float deltaT);
     void doGameDrawing(
@@ -546,6 +616,7 @@ private:
         bool treeShadows = true
     );
     void doGameplayLeaderLogic(Player* player, float deltaT);
+    void doFixedStepGameplayLogic(float deltaT);
     void doGameplayLogic(float deltaT);
     void doMenuLogic();
     void doScriptLogic();
@@ -590,26 +661,25 @@ private:
     Mob* getPointMobOnLeaderCursor(Player* player) const;
     void handlePlayerAction(const Inpution::Action& action);
     void loadGameContent();
-    void markAreaCellsActive(const RectCorners& corners);
-    void markAreaCellsActive(
-        int fromX, int toX, int fromY, int toY
-    );
     void processLeaderCursor(Player* player, float deltaT);
     void processMobInteractions(Mob* mPtr, size_t m);
     void processMobMiscInteractions(
         Mob* mPtr, Mob* m2Ptr, size_t m, size_t m2,
         const Distance& d, const Distance& dBetween,
-        vector<PendingInterMobEvent>& pendingInterMobEvents
+        ArenaVector<PendingInterMobEvent>& pendingInterMobEvents
     );
     void processMobReaches(
         Mob* mPtr, Mob* m2Ptr, size_t m, size_t m2, const Distance& dBetween,
-        vector<PendingInterMobEvent>& pendingInterMobEvents
+        ArenaVector<PendingInterMobEvent>& pendingInterMobEvents
     );
     void processMobTouches(
         Mob* mPtr, Mob* m2Ptr, size_t m, size_t m2, Distance& d
     );
+    void restoreLogicInterpolation();
+    void saveLogicTickState();
     bool shouldIgnorePlayerAction(const Inpution::Action& action);
     void tickAreaScript(float deltaT);
+    void tickMobAnimations(float deltaT);
     void unloadGameContent();
     void updateAreaActiveCells();
     void updateMobIsActiveFlag();
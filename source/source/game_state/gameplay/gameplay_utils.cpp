@@ -0,0 +1,597 @@
+/*
+ * Copyright (c) Andre 'Espyo' Silva 2013.
+ * The following source file belongs to the open-source project Pikifen.
+ * Please read the included README and LICENSE files for more information.
+ * Pikmin is copyright (c) Nintendo.
+ *
+ * === FILE DESCRIPTION ===
+ * Gameplay-class utility classes and functions.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "gameplay_utils.hpp"
+
+#include "../../content/mob/mob.hpp"
+#include "../../util/container_utils.hpp"
+#include "../../util/general_utils.hpp"
+#include "gameplay.hpp"
+
+
+#pragma region Active cell grid
+
+
+/**
+ * @brief Adds to the counts of the cells in a range. Cells that become
+ * active wake up the mobs sleeping in them.
+ *
+ * @param footprint Range of cells.
+ * @param amount Amount to add. Either 1 or -1.
+ */
+void ActiveCellGrid::addToCells(const Footprint& footprint, int amount) {
+    for(int r = footprint.fromRow; r <= footprint.toRow; r++) {
+        for(int c = footprint.fromCol; c <= footprint.toCol; c++) {
+            size_t cellIdx = r * nCols + c;
+            uint64_t bit = (uint64_t) 1 << (cellIdx % 64);
+            if(amount > 0) {
+                activeCounts[cellIdx]++;
+                if(activeCounts[cellIdx] > 1) continue;
+                
+                activeBits[cellIdx / 64] |= bit;
+                vector<Mob*>& cellMobs = sleepingMobs[cellIdx];
+                forIdx(m, cellMobs) {
+                    cellMobs[m]->isSleeping = false;
+                    cellMobs[m]->sleepCellIdx = INVALID;
+                    awakeMobs.push_back(cellMobs[m]);
+                }
+                if(!cellMobs.empty()) awakeMobsDirty = true;
+                cellMobs.clear();
+                
+            } else {
+                activeCounts[cellIdx]--;
+                if(activeCounts[cellIdx] > 0) continue;
+                
+                activeBits[cellIdx / 64] &= ~bit;
+                
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief Clears the grid.
+ */
+void ActiveCellGrid::clear() {
+    topLeftCorner = Point();
+    nCols = 0;
+    nRows = 0;
+    activeCounts.clear();
+    activeBits.clear();
+    sleepingMobs.clear();
+    awakeMobs.clear();
+    awakeMobsDirty = false;
+    nextUnsyncedMobId = 0;
+    mobFootprints.clear();
+    cameraFootprints.clear();
+}
+
+
+/**
+ * @brief Returns the list of mobs that are awake, sorted by ID.
+ * Mobs that got created since the last call to syncNewMobs() are not
+ * included.
+ *
+ * @return The list.
+ */
+const vector<Mob*>& ActiveCellGrid::getAwakeMobs() {
+    if(!awakeMobsDirty) return awakeMobs;
+    
+    auto isSleeping = [] (const Mob* m) { return m->isSleeping; };
+    awakeMobs.erase(
+        std::remove_if(awakeMobs.begin(), awakeMobs.end(), isSleeping),
+        awakeMobs.end()
+    );
+    
+    //Mobs that woke up were added to the end. A mob that fell asleep and
+    //woke up again since the last tidy-up can also be in there twice.
+    auto idCmp =
+    [] (const Mob* m1, const Mob* m2) { return m1->id < m2->id; };
+    if(!std::is_sorted(awakeMobs.begin(), awakeMobs.end(), idCmp)) {
+        std::sort(awakeMobs.begin(), awakeMobs.end(), idCmp);
+    }
+    awakeMobs.erase(
+        std::unique(awakeMobs.begin(), awakeMobs.end()), awakeMobs.end()
+    );
+    
+    awakeMobsDirty = false;
+    return awakeMobs;
+}
+
+
+/**
+ * @brief Returns the index of the cell a point is in.
+ *
+ * @param p The point.
+ * @return The index, or INVALID if it's outside of the grid.
+ */
+size_t ActiveCellGrid::getCellIdx(const Point& p) const {
+    int col = (p.x - topLeftCorner.x) / GEOMETRY::AREA_CELL_SIZE;
+    int row = (p.y - topLeftCorner.y) / GEOMETRY::AREA_CELL_SIZE;
+    if(col < 0 || col >= (int) nCols) return INVALID;
+    if(row < 0 || row >= (int) nRows) return INVALID;
+    return row * nCols + col;
+}
+
+
+/**
+ * @brief Returns the range of cells in a region. Cells outside of the grid
+ * are left out.
+ *
+ * @param corners Corners (in world coordinates) of the region.
+ * @return The footprint.
+ */
+ActiveCellGrid::Footprint ActiveCellGrid::getFootprint(
+    const RectCorners& corners
+) const {
+    Footprint result;
+    if(nCols == 0 || nRows == 0) return result;
+    
+    result.fromCol =
+        (corners.tl.x - topLeftCorner.x) / GEOMETRY::AREA_CELL_SIZE;
+    result.toCol =
+        (corners.br.x - topLeftCorner.x) / GEOMETRY::AREA_CELL_SIZE;
+    result.fromRow =
+        (corners.tl.y - topLeftCorner.y) / GEOMETRY::AREA_CELL_SIZE;
+    result.toRow =
+        (corners.br.y - topLeftCorner.y) / GEOMETRY::AREA_CELL_SIZE;
+        
+    result.fromCol = std::max(0, result.fromCol);
+    result.toCol = std::min(result.toCol, (int) nCols - 1);
+    result.fromRow = std::max(0, result.fromRow);
+    result.toRow = std::min(result.toRow, (int) nRows - 1);
+    
+    if(result.fromCol > result.toCol || result.fromRow > result.toRow) {
+        return Footprint();
+    }
+    return result;
+}
+
+
+/**
+ * @brief Returns whether a cell is active.
+ *
+ * @param col Column of the cell.
+ * @param row Row of the cell.
+ * @return Whether it's active.
+ */
+bool ActiveCellGrid::isCellActive(size_t col, size_t row) const {
+    return isCellIdxActive(row * nCols + col);
+}
+
+
+/**
+ * @brief Returns whether a cell is active.
+ *
+ * @param cellIdx Index of the cell, as returned by getCellIdx().
+ * @return Whether it's active.
+ */
+bool ActiveCellGrid::isCellIdxActive(size_t cellIdx) const {
+    return (activeBits[cellIdx / 64] >> (cellIdx % 64)) & 1;
+}
+
+
+/**
+ * @brief Puts a mob to sleep. It stays asleep until the cell it's in
+ * becomes active, or until it gets woken up by other means.
+ * If it's outside of the grid, only the latter can wake it up.
+ *
+ * @param mPtr The mob.
+ */
+void ActiveCellGrid::putMobToSleep(Mob* mPtr) {
+    if(mPtr->isSleeping) return;
+    
+    size_t cellIdx = getCellIdx(mPtr->center);
+    mPtr->isSleeping = true;
+    mPtr->sleepCellIdx = cellIdx;
+    awakeMobsDirty = true;
+    if(cellIdx != INVALID) {
+        sleepingMobs[cellIdx].push_back(mPtr);
+    }
+}
+
+
+/**
+ * @brief Forgets about a mob that is being deleted. The cells it kept
+ * active stop being kept active by it.
+ *
+ * @param mPtr The mob.
+ */
+void ActiveCellGrid::removeMob(Mob* mPtr) {
+    if(mPtr->id < mobFootprints.size()) {
+        setFootprint(mobFootprints[mPtr->id], Footprint());
+    }
+    wakeMob(mPtr);
+    awakeMobs.erase(
+        std::remove(awakeMobs.begin(), awakeMobs.end(), mPtr),
+        awakeMobs.end()
+    );
+}
+
+
+/**
+ * @brief Sets the region a player's camera keeps active.
+ *
+ * @param playerIdx Index of the player.
+ * @param corners Corners (in world coordinates) of the region.
+ */
+void ActiveCellGrid::setCameraRegion(
+    size_t playerIdx, const RectCorners& corners
+) {
+    if(playerIdx >= cameraFootprints.size()) {
+        cameraFootprints.resize(playerIdx + 1);
+    }
+    setFootprint(cameraFootprints[playerIdx], getFootprint(corners));
+}
+
+
+/**
+ * @brief Changes the range of cells something keeps active, updating only
+ * the cells that entered or left the range.
+ *
+ * @param curFootprint The current range. This gets updated.
+ * @param newFootprint The new range.
+ */
+void ActiveCellGrid::setFootprint(
+    Footprint& curFootprint, const Footprint& newFootprint
+) {
+    if(
+        curFootprint.fromCol == newFootprint.fromCol &&
+        curFootprint.toCol == newFootprint.toCol &&
+        curFootprint.fromRow == newFootprint.fromRow &&
+        curFootprint.toRow == newFootprint.toRow
+    ) {
+        return;
+    }
+    
+    //Add the new one first, so cells in both never go inactive for a bit.
+    addToCells(newFootprint, 1);
+    addToCells(curFootprint, -1);
+    curFootprint = newFootprint;
+}
+
+
+/**
+ * @brief Sets the region a mob keeps active.
+ *
+ * @param mPtr The mob.
+ * @param corners Corners (in world coordinates) of the region.
+ */
+void ActiveCellGrid::setMobRegion(const Mob* mPtr, const RectCorners& corners) {
+    if(mPtr->id >= mobFootprints.size()) {
+        mobFootprints.resize(mPtr->id + 1);
+    }
+    setFootprint(mobFootprints[mPtr->id], getFootprint(corners));
+}
+
+
+/**
+ * @brief Sets up the grid, with all cells inactive.
+ *
+ * @param topLeftCorner Top-left corner of the grid.
+ * @param nCols Number of columns.
+ * @param nRows Number of rows.
+ */
+void ActiveCellGrid::setup(
+    const Point& topLeftCorner, size_t nCols, size_t nRows
+) {
+    clear();
+    this->topLeftCorner = topLeftCorner;
+    this->nCols = nCols;
+    this->nRows = nRows;
+    activeCounts.assign(nCols * nRows, 0);
+    activeBits.assign((nCols * nRows + 63) / 64, 0);
+    sleepingMobs.assign(nCols * nRows, vector<Mob*>());
+}
+
+
+/**
+ * @brief Adds any mobs that were added to the end of the list of all mobs
+ * since the grid last saw it to the list of awake mobs. New mobs always
+ * start awake.
+ *
+ * @param mobs List of all mobs.
+ */
+void ActiveCellGrid::syncNewMobs(const vector<Mob*>& mobs) {
+    size_t firstNew = mobs.size();
+    while(firstNew > 0 && mobs[firstNew - 1]->id >= nextUnsyncedMobId) {
+        firstNew--;
+    }
+    if(firstNew == mobs.size()) return;
+    
+    awakeMobs.insert(awakeMobs.end(), mobs.begin() + firstNew, mobs.end());
+    nextUnsyncedMobId = mobs.back()->id + 1;
+    awakeMobsDirty = true;
+}
+
+
+/**
+ * @brief Wakes up a mob, if it's asleep.
+ *
+ * @param mPtr The mob.
+ */
+void ActiveCellGrid::wakeMob(Mob* mPtr) {
+    if(!mPtr->isSleeping) return;
+    
+    if(mPtr->sleepCellIdx < sleepingMobs.size()) {
+        vector<Mob*>& cellMobs = sleepingMobs[mPtr->sleepCellIdx];
+        auto it = std::find(cellMobs.begin(), cellMobs.end(), mPtr);
+        if(it != cellMobs.end()) {
+            *it = cellMobs.back();
+            cellMobs.pop_back();
+        }
+    }
+    mPtr->isSleeping = false;
+    mPtr->sleepCellIdx = INVALID;
+    awakeMobs.push_back(mPtr);
+    awakeMobsDirty = true;
+}
+
+
+#pragma endregion
+#pragma region Mob interaction grid
+
+
+/**
+ * @brief Clears the grid.
+ */
+void MobInteractionGrid::clear() {
+    topLeftCorner = Point();
+    nCols = 0;
+    nRows = 0;
+    cells.clear();
+    footprints.clear();
+    queryStamps.clear();
+    curQueryStamp = 0;
+    nrPossiblePairs = 0;
+    nrTestedPairs = 0;
+}
+
+
+/**
+ * @brief Returns the range of cells covered by a square around a point.
+ * Cells outside of the grid are clamped to its edges.
+ *
+ * @param center Center of the square.
+ * @param span Half of the square's width.
+ * @return The footprint.
+ */
+MobInteractionGrid::Footprint MobInteractionGrid::getFootprint(
+    const Point& center, float span
+) const {
+    Footprint result;
+    if(nCols == 0 || nRows == 0) return result;
+    
+    float cellSize = GAMEPLAY::MOB_INTERACTION_GRID_CELL_SIZE;
+    float fromX = floor((center.x - span - topLeftCorner.x) / cellSize);
+    float toX = floor((center.x + span - topLeftCorner.x) / cellSize);
+    float fromY = floor((center.y - span - topLeftCorner.y) / cellSize);
+    float toY = floor((center.y + span - topLeftCorner.y) / cellSize);
+    
+    result.fromCol = std::clamp(fromX, 0.0f, (float) (nCols - 1));
+    result.toCol = std::clamp(toX, 0.0f, (float) (nCols - 1));
+    result.fromRow = std::clamp(fromY, 0.0f, (float) (nRows - 1));
+    result.toRow = std::clamp(toY, 0.0f, (float) (nRows - 1));
+    result.registered = true;
+    return result;
+}
+
+
+/**
+ * @brief Returns the indexes of all mobs that could possibly interact
+ * with the given mob, sorted in ascending order. The mob itself is not
+ * included.
+ *
+ * Two mobs can only interact if the distance between them is within the
+ * first's interaction span plus the second's physical span. Since the
+ * distance between them discounts their radii, or the second's rectangle,
+ * this means that their centers are at most the first mob's interaction
+ * span plus its physical span plus twice the second's physical span apart.
+ * The query covers the first mob's part of that, and each mob's footprint
+ * the second's. This is exact as long as the footprints are up to date,
+ * which is why mobs moved by others must go through handleMobMoved().
+ *
+ * @param mobIdx Index of the mob to check.
+ * @param mPtr The mob to check.
+ * @param outIdxs The indexes are returned here.
+ */
+void MobInteractionGrid::getNeighbors(
+    size_t mobIdx, const Mob* mPtr, vector<size_t>& outIdxs
+) {
+    outIdxs.clear();
+    if(nCols == 0 || nRows == 0) return;
+    
+    curQueryStamp++;
+    Footprint query =
+        getFootprint(
+            mPtr->center, mPtr->interactionSpan + mPtr->physicalSpan
+        );
+        
+    for(size_t r = query.fromRow; r <= query.toRow; r++) {
+        for(size_t c = query.fromCol; c <= query.toCol; c++) {
+            const vector<size_t>& cell = cells[r * nCols + c];
+            forIdx(i, cell) {
+                size_t m2 = cell[i];
+                if(m2 == mobIdx) continue;
+                if(queryStamps[m2] == curQueryStamp) continue;
+                queryStamps[m2] = curQueryStamp;
+                outIdxs.push_back(m2);
+            }
+        }
+    }
+    
+    //Keep the same processing order as a check against every mob would.
+    std::sort(outIdxs.begin(), outIdxs.end());
+}
+
+
+/**
+ * @brief Updates the cells a mob is registered in, after it got moved by
+ * another mob's logic. A mob's cells are only updated after its own tick
+ * otherwise, so any code that moves a different mob must call this.
+ *
+ * @param mobs List of all mobs.
+ * @param mPtr The mob that got moved.
+ */
+void MobInteractionGrid::handleMobMoved(
+    const vector<Mob*>& mobs, const Mob* mPtr
+) {
+    //The list is sorted by ID.
+    auto idCmp = [] (const Mob* m1, const Mob* m2) {
+        return m1->id < m2->id;
+    };
+    auto it = std::lower_bound(mobs.begin(), mobs.end(), mPtr, idCmp);
+    if(it == mobs.end() || *it != mPtr) return;
+    updateMob(it - mobs.begin(), mPtr);
+}
+
+
+/**
+ * @brief Registers a mob in all cells of a footprint.
+ *
+ * @param mobIdx Index of the mob.
+ * @param footprint Footprint to register it in.
+ */
+void MobInteractionGrid::registerMob(
+    size_t mobIdx, const Footprint& footprint
+) {
+    footprints[mobIdx] = footprint;
+    if(!footprint.registered) return;
+    
+    for(size_t r = footprint.fromRow; r <= footprint.toRow; r++) {
+        for(size_t c = footprint.fromCol; c <= footprint.toCol; c++) {
+            cells[r * nCols + c].push_back(mobIdx);
+        }
+    }
+}
+
+
+/**
+ * @brief Clears the grid's contents and registers all mobs anew.
+ * This also resets the pair statistics for the frame.
+ *
+ * @param mobs List of all mobs.
+ */
+void MobInteractionGrid::rebuild(const vector<Mob*>& mobs) {
+    forIdx(c, cells) {
+        cells[c].clear();
+    }
+    footprints.clear();
+    queryStamps.clear();
+    curQueryStamp = 0;
+    nrPossiblePairs = 0;
+    nrTestedPairs = 0;
+    
+    syncNewMobs(mobs);
+}
+
+
+/**
+ * @brief Sets up the grid to cover the given region. Anything outside of it
+ * is treated as being in the closest edge cell.
+ *
+ * @param topLeftCorner Top-left corner of the region.
+ * @param bottomRightCorner Bottom-right corner of the region.
+ */
+void MobInteractionGrid::setup(
+    const Point& topLeftCorner, const Point& bottomRightCorner
+) {
+    clear();
+    this->topLeftCorner = topLeftCorner;
+    nCols =
+        ceil(
+            (bottomRightCorner.x - topLeftCorner.x) /
+            GAMEPLAY::MOB_INTERACTION_GRID_CELL_SIZE
+        ) + 1;
+    nRows =
+        ceil(
+            (bottomRightCorner.y - topLeftCorner.y) /
+            GAMEPLAY::MOB_INTERACTION_GRID_CELL_SIZE
+        ) + 1;
+    cells.assign(nCols * nRows, vector<size_t>());
+}
+
+
+/**
+ * @brief Registers any mobs that were added to the end of the list of
+ * all mobs since the grid last saw it.
+ *
+ * @param mobs List of all mobs.
+ */
+void MobInteractionGrid::syncNewMobs(const vector<Mob*>& mobs) {
+    size_t oldNrMobs = footprints.size();
+    if(mobs.size() <= oldNrMobs) return;
+    
+    footprints.resize(mobs.size());
+    queryStamps.resize(mobs.size(), 0);
+    for(size_t m = oldNrMobs; m < mobs.size(); m++) {
+        updateMob(m, mobs[m]);
+    }
+}
+
+
+/**
+ * @brief Removes a mob from all cells it is registered in.
+ *
+ * @param mobIdx Index of the mob.
+ */
+void MobInteractionGrid::unregisterMob(size_t mobIdx) {
+    Footprint& footprint = footprints[mobIdx];
+    if(!footprint.registered) return;
+    
+    for(size_t r = footprint.fromRow; r <= footprint.toRow; r++) {
+        for(size_t c = footprint.fromCol; c <= footprint.toCol; c++) {
+            vector<size_t>& cell = cells[r * nCols + c];
+            auto it = std::find(cell.begin(), cell.end(), mobIdx);
+            if(it == cell.end()) continue;
+            *it = cell.back();
+            cell.pop_back();
+        }
+    }
+    footprint.registered = false;
+}
+
+
+/**
+ * @brief Updates the cells a mob is registered in, based on its current
+ * position and size. Does nothing if they didn't change.
+ *
+ * @param mobIdx Index of the mob.
+ * @param mPtr The mob.
+ */
+void MobInteractionGrid::updateMob(size_t mobIdx, const Mob* mPtr) {
+    if(mobIdx >= footprints.size()) return;
+    
+    Footprint newFootprint =
+        getFootprint(
+            mPtr->center,
+            mPtr->physicalSpan * 2.0f
+        );
+    const Footprint& oldFootprint = footprints[mobIdx];
+    if(
+        oldFootprint.registered &&
+        oldFootprint.fromCol == newFootprint.fromCol &&
+        oldFootprint.toCol == newFootprint.toCol &&
+        oldFootprint.fromRow == newFootprint.fromRow &&
+        oldFootprint.toRow == newFootprint.toRow
+    ) {
+        return;
+    }
+    
+    unregisterMob(mobIdx);
+    registerMob(mobIdx, newFootprint);
+}
+
+
+#pragma endregion
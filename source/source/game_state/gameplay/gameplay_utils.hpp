@@ -10,15 +10,67 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include "../../content/mob/mob_utils.hpp"
 #include "../../content/other/gui.hpp"
 #include "../../content/script/script.hpp"
 #include "../../util/geometry_utils.hpp"
 
 class Leader;
+class Mob;
 class PikminType;
 
 
+//Types of mob tick commands.
+enum MOB_TICK_COMMAND {
+
+    //The mob's animation ended.
+    MOB_TICK_COMMAND_ANIMATION_END,
+    
+    //The mob's animation reached a frame signal.
+    MOB_TICK_COMMAND_FRAME_SIGNAL,
+    
+    //The mob's animation reached a frame sound.
+    MOB_TICK_COMMAND_FRAME_SOUND,
+    
+};
+
+
+/**
+ * @brief Something a mob needs to do that came from a part of its tick that
+ * ran in parallel with other mobs. Those parts can't run events or
+ * affect other mobs, so they record these commands instead, and the commands
+ * are applied afterwards, one thread at a time, in mob order.
+ */
+struct MobTickCommand {
+
+    //--- Public members ---
+    
+    //Mob the command belongs to.
+    Mob* mobPtr = nullptr;
+    
+    //Type of command.
+    MOB_TICK_COMMAND type = MOB_TICK_COMMAND_ANIMATION_END;
+    
+    //Frame signal or frame sound index, if applicable.
+    size_t value = 0;
+    
+    
+    //--- Public function definitions ---
+    
+    MobTickCommand(
+        Mob* mobPtr, const MOB_TICK_COMMAND type, size_t value = 0
+    ):
+        mobPtr(mobPtr),
+        type(type),
+        value(value) {
+        
+    }
+    
+};
+
+
 /**
  * @brief Info about an event involving two mobs.
  *
@@ -54,3 +106,201 @@ struct PendingInterMobEvent {
     }
     
 };
+
+
+/**
+ * @brief Grid that divides the area into cells, and keeps track of which
+ * ones are active. Mobs in inactive cells don't run most of their logic.
+ *
+ * Pikmin, leaders, and cameras each keep a range of cells active, and the
+ * grid counts how many of them keep each cell active. When one of these
+ * ranges changes, only the cells that entered or left it get updated,
+ * so the cost doesn't depend on the size of the area.
+ *
+ * Mobs that are asleep are listed in the cell they're in, so they can be
+ * woken up when that cell becomes active.
+ */
+struct ActiveCellGrid {
+
+    //--- Public members ---
+    
+    //Top-left corner of the grid.
+    Point topLeftCorner;
+    
+    //Number of columns.
+    size_t nCols = 0;
+    
+    //Number of rows.
+    size_t nRows = 0;
+    
+    
+    //--- Public function declarations ---
+    
+    void clear();
+    const vector<Mob*>& getAwakeMobs();
+    size_t getCellIdx(const Point& p) const;
+    bool isCellActive(size_t col, size_t row) const;
+    bool isCellIdxActive(size_t cellIdx) const;
+    void putMobToSleep(Mob* mPtr);
+    void removeMob(Mob* mPtr);
+    void setCameraRegion(size_t playerIdx, const RectCorners& corners);
+    void setMobRegion(const Mob* mPtr, const RectCorners& corners);
+    void setup(const Point& topLeftCorner, size_t nCols, size_t nRows);
+    void syncNewMobs(const vector<Mob*>& mobs);
+    void wakeMob(Mob* mPtr);
+    
+    
+    private:
+    
+    //--- Private misc. definitions ---
+    
+    /**
+     * @brief Range of cells something keeps active.
+     */
+    struct Footprint {
+    
+        //--- Public members ---
+        
+        //Starting column, inclusive.
+        int fromCol = 0;
+        
+        //Ending column, inclusive.
+        int toCol = -1;
+        
+        //Starting row, inclusive.
+        int fromRow = 0;
+        
+        //Ending row, inclusive.
+        int toRow = -1;
+        
+    };
+    
+    
+    //--- Private members ---
+    
+    //How many things keep each cell active. Stored row by row.
+    vector<unsigned int> activeCounts;
+    
+    //Whether each cell is active, one bit per cell. Stored row by row.
+    vector<uint64_t> activeBits;
+    
+    //Sleeping mobs in each cell. Stored row by row.
+    vector<vector<Mob*> > sleepingMobs;
+    
+    //Mobs that are awake, sorted by ID. Only trustworthy after
+    //getAwakeMobs() tidies it up.
+    vector<Mob*> awakeMobs;
+    
+    //Whether mobs fell asleep or woke up since awakeMobs was last tidied.
+    bool awakeMobsDirty = false;
+    
+    //Mobs with this ID or higher haven't been added to awakeMobs yet.
+    size_t nextUnsyncedMobId = 0;
+    
+    //Cell range each mob keeps active, per mob ID.
+    vector<Footprint> mobFootprints;
+    
+    //Cell range each player's camera keeps active, per player index.
+    vector<Footprint> cameraFootprints;
+    
+    
+    //--- Private function declarations ---
+    
+    void addToCells(const Footprint& footprint, int amount);
+    Footprint getFootprint(const RectCorners& corners) const;
+    void setFootprint(Footprint& curFootprint, const Footprint& newFootprint);
+    
+};
+
+
+/**
+ * @brief Uniform grid that serves as the broad phase for mob interactions.
+ *
+ * Every mob is registered in all of the cells that its interaction footprint
+ * touches, so that when processing a mob's interactions, only the mobs in
+ * nearby cells need to be checked, instead of every mob in the area.
+ * Mobs are referred to by their index in the list of all mobs, so the
+ * grid must be rebuilt whenever that list gets reordered.
+ */
+struct MobInteractionGrid {
+
+    //--- Public members ---
+    
+    //Top-left corner of the grid.
+    Point topLeftCorner;
+    
+    //Number of columns.
+    size_t nCols = 0;
+    
+    //Number of rows.
+    size_t nRows = 0;
+    
+    //Mob pairs that would've been tested without the grid, this frame.
+    size_t nrPossiblePairs = 0;
+    
+    //Mob pairs that were actually tested, this frame.
+    size_t nrTestedPairs = 0;
+    
+    
+    //--- Public function declarations ---
+    
+    void clear();
+    void getNeighbors(size_t mobIdx, const Mob* mPtr, vector<size_t>& outIdxs);
+    void handleMobMoved(const vector<Mob*>& mobs, const Mob* mPtr);
+    void rebuild(const vector<Mob*>& mobs);
+    void setup(const Point& topLeftCorner, const Point& bottomRightCorner);
+    void syncNewMobs(const vector<Mob*>& mobs);
+    void updateMob(size_t mobIdx, const Mob* mPtr);
+    
+    
+    private:
+    
+    //--- Private misc. definitions ---
+    
+    /**
+     * @brief Range of cells a mob is registered in.
+     */
+    struct Footprint {
+    
+        //--- Public members ---
+        
+        //Starting column, inclusive.
+        size_t fromCol = 0;
+        
+        //Ending column, inclusive.
+        size_t toCol = 0;
+        
+        //Starting row, inclusive.
+        size_t fromRow = 0;
+        
+        //Ending row, inclusive.
+        size_t toRow = 0;
+        
+        //Whether the mob is registered in the grid at all.
+        bool registered = false;
+        
+    };
+    
+    
+    //--- Private members ---
+    
+    //Indexes of the mobs registered in each cell. Stored row by row.
+    vector<vector<size_t> > cells;
+    
+    //Cell range each mob is registered in, per mob index.
+    vector<Footprint> footprints;
+    
+    //Stamp of the last query that found each mob, per mob index.
+    vector<size_t> queryStamps;
+    
+    //Stamp of the current query.
+    size_t curQueryStamp = 0;
+    
+    
+    //--- Private function declarations ---
+    
+    Footprint getFootprint(const Point& center, float span) const;
+    void registerMob(size_t mobIdx, const Footprint& footprint);
+    void unregisterMob(size_t mobIdx);
+    
+};
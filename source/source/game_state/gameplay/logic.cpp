@@ -22,6 +22,7 @@
 #include "../../core/drawing.hpp"
 #include "../../core/game.hpp"
 #include "../../core/misc_functions.hpp"
+#include "../../util/code_debug.hpp"
 #include "../../util/general_utils.hpp"
 #include "../../util/string_utils.hpp"
 
@@ -238,6 +239,37 @@ void GameplayState::doAestheticLogic(float deltaT) {
 }
 
 
+/**
+ * @brief Ticks the logic of gameplay-related things using a fixed-step
+ * clock. The time that passed is accumulated, and the gameplay logic is run
+ * once for every full logic step that fits in it. Whatever is left over is
+ * used to interpolate between the last two logic steps when drawing.
+ *
+ * @param deltaT How long the frame's tick is, in seconds.
+ */
+void GameplayState::doFixedStepGameplayLogic(float deltaT) {
+    float logicStep = 1.0f / game.options.advanced.logicFps;
+    logicTimeAccumulator += deltaT;
+    
+    size_t nrTicks = 0;
+    while(logicTimeAccumulator >= logicStep) {
+        if(nrTicks == GAMEPLAY::MAX_LOGIC_TICKS_PER_FRAME) {
+            //The logic can't keep up. Drop the time that's left, or else
+            //every frame will have even more catching up to do.
+            logicTimeAccumulator = fmod(logicTimeAccumulator, logicStep);
+            break;
+        }
+        saveLogicTickState();
+        doGameplayLogic(logicStep);
+        logicTimeAccumulator -= logicStep;
+        nrTicks++;
+    }
+    
+    logicInterpolationRatio =
+        std::clamp((float) (logicTimeAccumulator / logicStep), 0.0f, 1.0f);
+}
+
+
 /**
  * @brief Ticks the logic of leader gameplay-related things.
  *
@@ -759,6 +791,19 @@ void GameplayState::doGameplayLeaderLogic(Player* player, float deltaT) {
  * @param deltaT How long the frame's tick is, in seconds.
  */
 void GameplayState::doGameplayLogic(float deltaT) {
+#ifdef CODE_DEBUG_COUNT_NEW
+    size_t nrNewsAtStart = codeDebugNrNews;
+#endif //ifdef CODE_DEBUG_COUNT_NEW
+    
+    //Throw away last tick's temporary containers.
+    if(game.perfMon) {
+        game.perfMon->addToCounter(
+            "Frame arena heap allocations",
+            frameArena.getNrHeapAllocations()
+        );
+    }
+    frameArena.reset();
+    
     forIdx(p, players) {
         Player& player = players[p];
         
@@ -941,36 +986,67 @@ void GameplayState::doGameplayLogic(float deltaT) {
         
         updateAreaActiveCells();
         updateMobIsActiveFlag();
+        mobInteractionGrid.rebuild(mobs.all);
+        
+        //The animations are ticked separately, after everything else, so
+        //that they can be split between threads.
+        mobTickAnimMobs.clear();
+        
+        //Sleeping mobs can't tick, so only go through the awake ones.
+        //Ticking can wake up or create mobs, so go through a copy.
+        const vector<Mob*>& awakeMobsList = areaActiveCells.getAwakeMobs();
+        ArenaVector<Mob*> awakeMobs(
+            awakeMobsList.begin(), awakeMobsList.end(), frameArena
+        );
+        auto idCmp = [] (const Mob* m1, const Mob* m2) {
+            return m1->id < m2->id;
+        };
         
         size_t nMobs = mobs.all.size();
-        for(size_t m = 0; m < nMobs; m++) {
+        auto nextMobIt = mobs.all.begin();
+        forIdx(a, awakeMobs) {
             //Tick the mob.
-            Mob* mPtr = mobs.all[m];
+            Mob* mPtr = awakeMobs[a];
             if(
                 !hasFlag(
                     mPtr->type->inactiveLogic,
                     INACTIVE_LOGIC_FLAG_TICKS
                 ) && !mPtr->isActive &&
-                mPtr->timeAlive > 0.1f
+                mPtr->timeAlive > GAMEPLAY::MOB_INACTIVE_GRACE_TIME
             ) {
                 continue;
             }
             
+            //Both lists are sorted by ID, so the search can pick up
+            //from where the last one stopped.
+            nextMobIt =
+                std::lower_bound(nextMobIt, mobs.all.end(), mPtr, idCmp);
+            size_t m = nextMobIt - mobs.all.begin();
+            
             mPtr->tick(deltaT);
+            mobTickAnimMobs.push_back(mPtr);
+            mobInteractionGrid.syncNewMobs(mobs.all);
+            mobInteractionGrid.updateMob(m, mPtr);
             if(mPtr->isGenerallyAvailable()) {
                 processMobInteractions(mPtr, m);
             }
         }
         
-        for(size_t m = 0; m < nMobs;) {
-            //Mob deletion.
-            Mob* mPtr = mobs.all[m];
-            if(mPtr->toDelete) {
-                deleteMob(mPtr);
-                nMobs--;
-                continue;
+        tickMobAnimations(deltaT);
+        
+        //Mob deletion. Deleting a mob can mark others for deletion too,
+        //so keep going until there are none left.
+        ArenaVector<Mob*> mobsToDelete(frameArena);
+        while(true) {
+            mobsToDelete.clear();
+            for(size_t m = 0; m < nMobs; m++) {
+                if(mobs.all[m]->toDelete) {
+                    mobsToDelete.push_back(mobs.all[m]);
+                }
             }
-            m++;
+            if(mobsToDelete.empty()) break;
+            deleteMobs(mobsToDelete);
+            nMobs -= mobsToDelete.size();
         }
         
         forIdx(p, players) {
@@ -1193,6 +1269,15 @@ void GameplayState::doGameplayLogic(float deltaT) {
         isInputAllowed = true;
     }
     
+#ifdef CODE_DEBUG_COUNT_NEW
+    if(game.perfMon) {
+        game.perfMon->addToCounter(
+            "Gameplay logic heap allocations",
+            codeDebugNrNews - nrNewsAtStart
+        );
+    }
+#endif //ifdef CODE_DEBUG_COUNT_NEW
+    
 }
 
 
@@ -1256,9 +1341,14 @@ void GameplayState::doMenuLogic() {
             &stateStr, &prevStatesStr, &timerStr
         );
         
+        string pairsStr =
+            i2s(mobInteractionGrid.nrTestedPairs) + " tested / " +
+            i2s(mobInteractionGrid.nrPossiblePairs) + " candidates";
+            
         game.makerDisplay.write(
             "Timer: " + timerStr + "\n"
-            "State: " + stateStr + " | Prev. states: " + prevStatesStr + "\n" +
+            "State: " + stateStr + " | Prev. states: " + prevStatesStr + "\n"
+            "Mob pairs this frame: " + pairsStr + "\n" +
             game.states.gameplay->scriptVM.getMakerToolVarsStr(),
             8.0f
         );
@@ -1687,54 +1777,6 @@ bool GameplayState::isPaused() const {
 }
 
 
-/**
- * @brief Marks all area cells in a given region as active.
- *
- * @param corners Corners (in world coordinates) of the region.
- */
-void GameplayState::markAreaCellsActive(const RectCorners& corners) {
-    int fromX =
-        (corners.tl.x - game.curArea->bmap.topLeftCorner.x) /
-        GEOMETRY::AREA_CELL_SIZE;
-    int toX =
-        (corners.br.x - game.curArea->bmap.topLeftCorner.x) /
-        GEOMETRY::AREA_CELL_SIZE;
-    int fromY =
-        (corners.tl.y - game.curArea->bmap.topLeftCorner.y) /
-        GEOMETRY::AREA_CELL_SIZE;
-    int toY =
-        (corners.br.y - game.curArea->bmap.topLeftCorner.y) /
-        GEOMETRY::AREA_CELL_SIZE;
-        
-    markAreaCellsActive(fromX, toX, fromY, toY);
-}
-
-
-/**
- * @brief Marks all area cells in a given region as active.
- * All coordinates provided are automatically adjusted if out-of-bounds.
- *
- * @param fromX Starting column index of the cells, inclusive.
- * @param toX Ending column index of the cells, inclusive.
- * @param fromY Starting row index of the cells, inclusive.
- * @param toY Ending row index of the cells, inclusive.
- */
-void GameplayState::markAreaCellsActive(
-    int fromX, int toX, int fromY, int toY
-) {
-    fromX = std::max(0, fromX);
-    toX = std::min(toX, (int) areaActiveCells.size() - 1);
-    fromY = std::max(0, fromY);
-    toY = std::min(toY, (int) areaActiveCells[0].size() - 1);
-    
-    for(int x = fromX; x <= toX; x++) {
-        for(int y = fromY; y <= toY; y++) {
-            areaActiveCells[x][y] = true;
-        }
-    }
-}
-
-
 /**
  * @brief Processes the leader's cursor for this frame.
  *
@@ -1793,20 +1835,23 @@ void GameplayState::processLeaderCursor(Player* player, float deltaT) {
  * @param m Index of the mob.
  */
 void GameplayState::processMobInteractions(Mob* mPtr, size_t m) {
-    vector<PendingInterMobEvent> pendingInterMobEvents;
+    ArenaVector<PendingInterMobEvent> pendingInterMobEvents(frameArena);
     FsmStateDef* stateBefore = mPtr->scriptVM.fsm.curState;
     
-    size_t nMobs = mobs.all.size();
-    for(size_t m2 = 0; m2 < nMobs; m2++) {
-        if(m == m2) continue;
-        
+    //Only check the mobs that are close enough to possibly interact.
+    mobInteractionGrid.getNeighbors(m, mPtr, mobInteractionNeighbors);
+    mobInteractionGrid.nrPossiblePairs += mobs.all.size() - 1;
+    mobInteractionGrid.nrTestedPairs += mobInteractionNeighbors.size();
+    
+    forIdx(n, mobInteractionNeighbors) {
+        size_t m2 = mobInteractionNeighbors[n];
         Mob* m2Ptr = mobs.all[m2];
         if(
             !hasFlag(
                 m2Ptr->type->inactiveLogic,
                 INACTIVE_LOGIC_FLAG_INTERACTIONS
             ) && !m2Ptr->isActive &&
-            mPtr->timeAlive > 0.1f
+            mPtr->timeAlive > GAMEPLAY::MOB_INACTIVE_GRACE_TIME
         ) {
             continue;
         }
@@ -1906,7 +1951,7 @@ void GameplayState::processMobInteractions(Mob* mPtr, size_t m) {
 void GameplayState::processMobMiscInteractions(
     Mob* mPtr, Mob* m2Ptr, size_t m, size_t m2,
     const Distance& d, const Distance& dBetween,
-    vector<PendingInterMobEvent>& pendingInterMobEvents
+    ArenaVector<PendingInterMobEvent>& pendingInterMobEvents
 ) {
     //Find a carriable mob to grab.
     FsmEventDef* ncoEvent =
@@ -2008,7 +2053,7 @@ void GameplayState::processMobMiscInteractions(
  */
 void GameplayState::processMobReaches(
     Mob* mPtr, Mob* m2Ptr, size_t m, size_t m2, const Distance& dBetween,
-    vector<PendingInterMobEvent>& pendingInterMobEvents
+    ArenaVector<PendingInterMobEvent>& pendingInterMobEvents
 ) {
     //Check reaches.
     FsmEventDef* obirEv =
@@ -2563,6 +2608,22 @@ void GameplayState::processMobTouches(
 }
 
 
+/**
+ * @brief Saves the positions of mobs and cameras as they are before a
+ * fixed-step logic tick, so drawing can interpolate from them.
+ */
+void GameplayState::saveLogicTickState() {
+    forIdx(m, mobs.all) {
+        Mob* mPtr = mobs.all[m];
+        mPtr->prevTickCenter = mPtr->center;
+        mPtr->prevTickBottomZ = mPtr->bottomZ;
+    }
+    forIdx(p, players) {
+        players[p].prevTickCamCenter = players[p].view.cam.center;
+    }
+}
+
+
 /**
  * @brief Checks general events in the area's script for this frame.
  *
@@ -2576,20 +2637,112 @@ void GameplayState::tickAreaScript(float deltaT) {
 
 
 /**
- * @brief Updates the grid that represents which area cells are active
- * for this frame.
+ * @brief Ticks the animations of all mobs that were ticked this frame,
+ * split between the worker threads. Since the animations of different mobs
+ * don't depend on each other, each thread handles its own range of mobs,
+ * and records the events that come from them in its own command queue.
+ * Afterwards, the queues are applied in order, which is the same as
+ * mob order. This happens with a single thread too, so the results are the
+ * same regardless of the number of threads.
+ * Since this runs after all mobs got their logic and interactions, anything
+ * an animation end or frame signal event changes (state, radius,
+ * tangibility, held mobs, etc.) is only seen by the other mobs starting
+ * next frame, whereas before it was already seen by the mobs that
+ * ticked later in the same frame. Scripts don't rely on that same-frame
+ * visibility, so this one frame of difference doesn't change how they play.
+ *
+ * @param deltaT How long the frame's tick is, in seconds.
  */
-void GameplayState::updateAreaActiveCells() {
-    //Initialize the grid to false.
-    forIdx(x, areaActiveCells) {
-        forIdx(y, areaActiveCells[x]) {
-            areaActiveCells[x][y] = false;
+void GameplayState::tickMobAnimations(float deltaT) {
+    if(game.perfMon) {
+        game.perfMon->startMeasurement("Object -- Animation");
+    }
+    
+    mobTickCommandQueues.resize(mobTickPool.getNrThreads());
+    mobTickFrameSignals.resize(mobTickPool.getNrThreads());
+    mobTickFrameSounds.resize(mobTickPool.getNrThreads());
+    forIdx(q, mobTickCommandQueues) {
+        mobTickCommandQueues[q].clear();
+    }
+    
+    //Tick the animations.
+    mobTickPool.parallelFor(
+        mobTickAnimMobs.size(),
+    [this, deltaT] (size_t threadIdx, size_t start, size_t end) {
+        vector<MobTickCommand>& queue = mobTickCommandQueues[threadIdx];
+        vector<size_t>& frameSignals = mobTickFrameSignals[threadIdx];
+        vector<size_t>& frameSounds = mobTickFrameSounds[threadIdx];
+        for(size_t m = start; m < end; m++) {
+            Mob* mPtr = mobTickAnimMobs[m];
+            if(mPtr->toDelete) continue;
+            
+            frameSignals.clear();
+            frameSounds.clear();
+            bool finishedAnim =
+                mPtr->tickAnimationState(deltaT, &frameSignals, &frameSounds);
+                
+            if(finishedAnim) {
+                queue.push_back(
+                    MobTickCommand(mPtr, MOB_TICK_COMMAND_ANIMATION_END)
+                );
+            }
+            forIdx(s, frameSignals) {
+                queue.push_back(
+                    MobTickCommand(
+                        mPtr, MOB_TICK_COMMAND_FRAME_SIGNAL, frameSignals[s]
+                    )
+                );
+            }
+            forIdx(s, frameSounds) {
+                queue.push_back(
+                    MobTickCommand(
+                        mPtr, MOB_TICK_COMMAND_FRAME_SOUND, frameSounds[s]
+                    )
+                );
+            }
+        }
+    }
+    );
+    
+    //Apply the commands.
+    forIdx(q, mobTickCommandQueues) {
+        const vector<MobTickCommand>& queue = mobTickCommandQueues[q];
+        forIdx(c, queue) {
+            const MobTickCommand& command = queue[c];
+            Mob* mPtr = command.mobPtr;
+            if(mPtr->toDelete) continue;
+            
+            switch(command.type) {
+            case MOB_TICK_COMMAND_ANIMATION_END: {
+                mPtr->scriptVM.fsm.runEvent(FSM_EV_ANIMATION_END);
+                break;
+            } case MOB_TICK_COMMAND_FRAME_SIGNAL: {
+                size_t signal = command.value;
+                mPtr->scriptVM.fsm.runEvent(FSM_EV_FRAME_SIGNAL, &signal);
+                break;
+            } case MOB_TICK_COMMAND_FRAME_SOUND: {
+                mPtr->playSound(command.value);
+                break;
+            }
+            }
         }
     }
     
-    //Mark the 3x3 region around Pikmin and leaders as active.
+    if(game.perfMon) {
+        game.perfMon->finishMeasurement();
+    }
+}
+
+
+/**
+ * @brief Updates the grid that represents which area cells are active
+ * for this frame.
+ */
+void GameplayState::updateAreaActiveCells() {
+    //Pikmin and leaders keep the 3x3 region around them active.
     forIdx(p, mobs.pikmin) {
-        markAreaCellsActive(
+        areaActiveCells.setMobRegion(
+            mobs.pikmin[p],
             RectCorners(
                 mobs.pikmin[p]->center - GEOMETRY::AREA_CELL_SIZE,
                 mobs.pikmin[p]->center + GEOMETRY::AREA_CELL_SIZE
@@ -2598,7 +2751,8 @@ void GameplayState::updateAreaActiveCells() {
     }
     
     forIdx(l, mobs.leaders) {
-        markAreaCellsActive(
+        areaActiveCells.setMobRegion(
+            mobs.leaders[l],
             RectCorners(
                 mobs.leaders[l]->center - GEOMETRY::AREA_CELL_SIZE,
                 mobs.leaders[l]->center + GEOMETRY::AREA_CELL_SIZE
@@ -2606,10 +2760,10 @@ void GameplayState::updateAreaActiveCells() {
         );
     }
     
-    //Mark the region in-camera (plus padding) as active.
+    //The region in-camera (plus padding) is active too.
     forIdx(p, players) {
         Player& player = players[p];
-        markAreaCellsActive(player.view.worldCorners);
+        areaActiveCells.setCameraRegion(p, player.view.worldCorners);
     }
 }
 
@@ -2618,38 +2772,41 @@ void GameplayState::updateAreaActiveCells() {
  * @brief Updates the "isActive" member variable of all mobs for this frame.
  */
 void GameplayState::updateMobIsActiveFlag() {
-    unordered_set<Mob*> childMobs;
+    ArenaVector<Mob*> childMobs(frameArena);
+    
+    //Sleeping mobs stay inactive until something wakes them up, so only
+    //the awake ones need checking.
+    areaActiveCells.syncNewMobs(mobs.all);
+    const vector<Mob*>& awakeMobs = areaActiveCells.getAwakeMobs();
+    forIdx(m, awakeMobs) {
+        Mob* mPtr = awakeMobs[m];
+        
+        size_t cellIdx = areaActiveCells.getCellIdx(mPtr->center);
+        mPtr->isActive =
+            cellIdx != INVALID && areaActiveCells.isCellIdxActive(cellIdx);
+            
+        if(mPtr->parent && mPtr->parent->m) childMobs.push_back(mPtr);
+    }
     
-    forIdx(m, mobs.all) {
-        Mob* mPtr = mobs.all[m];
-        
-        int cellX =
-            (mPtr->center.x - game.curArea->bmap.topLeftCorner.x) /
-            GEOMETRY::AREA_CELL_SIZE;
-        int cellY =
-            (mPtr->center.y - game.curArea->bmap.topLeftCorner.y) /
-            GEOMETRY::AREA_CELL_SIZE;
-        if(
-            !isIdxValid(cellX, game.states.gameplay->areaActiveCells)
-        ) {
-            mPtr->isActive = false;
-        } else if(
-            !isIdxValid(cellY, game.states.gameplay->areaActiveCells[0])
-        ) {
-            mPtr->isActive = false;
-        } else {
-            mPtr->isActive =
-                game.states.gameplay->areaActiveCells[cellX][cellY];
+    forIdx(c, childMobs) {
+        Mob* parentPtr = childMobs[c]->parent->m;
+        if(childMobs[c]->isActive) {
+            areaActiveCells.wakeMob(parentPtr);
+            parentPtr->isActive = true;
         }
-        
-        if(mPtr->parent && mPtr->parent->m) childMobs.insert(mPtr);
     }
     
-    for(const auto& m : childMobs) {
-        if(m->isActive) m->parent->m->isActive = true;
+    forIdx(c, childMobs) {
+        if(childMobs[c]->parent->m->isActive) childMobs[c]->isActive = true;
     }
     
-    for(auto& m : childMobs) {
-        if(m->parent->m->isActive) m->isActive = true;
+    //Mobs with nothing to do can go to sleep. This also tidies up the
+    //list, since some parents could've woken up above.
+    areaActiveCells.getAwakeMobs();
+    forIdx(m, awakeMobs) {
+        Mob* mPtr = awakeMobs[m];
+        if(mPtr->canSleep()) {
+            areaActiveCells.putMobToSleep(mPtr);
+        }
     }
 }
@@ -1334,8 +1334,9 @@ void PauseMenu::drawRadar(
     
     //Debugging feature -- show area active cells.
     if(game.debug.showAreaActiveCells) {
-        forIdx(cellX, game.states.gameplay->areaActiveCells) {
-            forIdx(cellY, game.states.gameplay->areaActiveCells[cellX]) {
+        const ActiveCellGrid& cells = game.states.gameplay->areaActiveCells;
+        for(size_t cellX = 0; cellX < cells.nCols; cellX++) {
+            for(size_t cellY = 0; cellY < cells.nRows; cellY++) {
                 float startX =
                     game.curArea->bmap.topLeftCorner.x +
                     cellX * GEOMETRY::AREA_CELL_SIZE;
@@ -1349,7 +1350,7 @@ void PauseMenu::drawRadar(
                     (1.0f / radarView.cam.zoom),
                     startY + GEOMETRY::AREA_CELL_SIZE -
                     (1.0f / radarView.cam.zoom),
-                    game.states.gameplay->areaActiveCells[cellX][cellY] ?
+                    cells.isCellActive(cellX, cellY) ?
                     ACTIVE_CELL_COLOR :
                     INACTIVE_CELL_COLOR,
                     1.0f / radarView.cam.zoom
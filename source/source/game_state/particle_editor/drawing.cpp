@@ -91,23 +91,11 @@ void ParticleEditor::drawCanvas() {
     al_use_transform(&game.editorsView.worldToWindowTransform);
     
     //Particles.
-    vector<WorldComponent> components;
-    components.reserve(partMgr.getCount());
+    partComponents.clear();
+    vector<WorldComponent>& components = partComponents.components;
     partMgr.fillComponentList(components, game.editorsView.worldCorners);
     
-    forIdx(c, components) {
-        components[c].idx = c;
-    }
-    
-    sort(
-        components.begin(), components.end(),
-    [](const WorldComponent & c1, const WorldComponent & c2) -> bool {
-        if(c1.z == c2.z) {
-            return c1.idx < c2.idx;
-        }
-        return c1.z < c2.z;
-    }
-    );
+    partComponents.sort();
     forIdx(c, components) {
         WorldComponent* cPtr = &components[c];
         if(cPtr->particlePtr) {
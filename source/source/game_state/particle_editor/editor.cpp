@@ -136,6 +136,7 @@ void ParticleEditor::createPartGen(
         partGenPath, &manifest
     );
     loadedGen.manifest = &manifest;
+    loadedGen.budgetIdx = 0;
     loadedGen.baseParticle.duration = 1.0f;
     loadedGen.baseParticle.setBitmap("");
     loadedGen.baseParticle.size =
@@ -535,6 +536,7 @@ void ParticleEditor::loadPartGenFile(
     
     loadedGen.manifest = &manifest;
     loadedGen.loadFromDataNode(&file, CONTENT_LOAD_LEVEL_FULL);
+    loadedGen.budgetIdx = 0;
     
     //Finish up.
     setupForNewPartGenPost();
@@ -56,6 +56,9 @@ private:
     //Particle manager.
     ParticleManager partMgr;
     
+    //Particles to draw, as world components. Cache for performance.
+    WorldComponentList partComponents;
+    
     //Whether to use a background texture, if any.
     ALLEGRO_BITMAP* bg = nullptr;
     
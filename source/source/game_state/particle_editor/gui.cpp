@@ -922,6 +922,25 @@ void ParticleEditor::processGuiPanelGenerator() {
             );
             loadedGen.emission.numberDeviation = numberDevInt;
             
+            //Max particles value.
+            int maxParticlesInt = (int) loadedGen.maxParticles;
+            if(
+                ImGui::DragInt(
+                    "Max particles", &maxParticlesInt, 1, 0,
+                    (int) game.options.advanced.maxParticles
+                )
+            ) {
+                changesMgr.markAsChanged();
+            }
+            setTooltip(
+                "Maximum number of particles from this generator that can\n"
+                "exist at once, counting all places it's used in.\n"
+                "Once reached, no more are created until some disappear.\n"
+                "0 means no limit.",
+                "", WIDGET_EXPLANATION_DRAG
+            );
+            loadedGen.maxParticles = maxParticlesInt;
+            
             ImGui::Unindent();
             
             ImGui::TreePop();
@@ -8,7 +8,11 @@
  */
 
 #undef _CMATH_
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 #include <fstream>
+#include <utility>
 
 #include <allegro5/allegro.h>
 
@@ -22,6 +26,22 @@ using std::vector;
 
 namespace DATA_FILE {
 
+//Files modified less than this many seconds ago don't get compiled into
+//the cache. Modification times only have a precision of one second,
+//so if a file changed again within that second, it would look the same.
+const int64_t CACHE_MIN_FILE_AGE = 2;
+
+//Magic number at the start of a compiled cache file. These are the
+//characters "PKDC".
+const uint32_t CACHE_MAGIC = 0x504B4443;
+
+//Version of the compiled cache file format.
+const uint32_t CACHE_VERSION = 1;
+
+//A node needs at least this many children for lookups by name
+//to use an index, instead of checking every child.
+const size_t CHILD_INDEX_MIN_CHILDREN = 8;
+
 //When encrypting, this is the lowest ASCII value that can be affected.
 const unsigned char ENCRYPTION_MIN_VALUE = 32; //Space character.
 
@@ -34,6 +54,10 @@ const string UTF8_MAGIC_NUMBER = "\xEF\xBB\xBF";
 }
 
 
+string DataNode::cacheFolderPath;
+string DataNode::cachedFolderPath;
+
+
 /**
  * @brief Constructs a new empty data node object.
  */
@@ -63,6 +87,30 @@ DataNode::DataNode(const DataNode& dn2) :
 }
 
 
+/**
+ * @brief Constructs a new data node object, taking the data and the children
+ * from another node, which is left empty.
+ *
+ * @param dn2 The node to take data from.
+ */
+DataNode::DataNode(DataNode&& dn2) noexcept :
+    name(std::move(dn2.name)),
+    value(std::move(dn2.value)),
+    filePath(std::move(dn2.filePath)),
+    lineNr(dn2.lineNr),
+    children(std::move(dn2.children)),
+    dummyChildren(std::move(dn2.dummyChildren)),
+    childIndex(std::move(dn2.childIndex)),
+    childIndexValid(dn2.childIndexValid) {
+    
+    dn2.lineNr = 0;
+    dn2.children.clear();
+    dn2.dummyChildren.clear();
+    dn2.childIndex.clear();
+    dn2.childIndexValid = false;
+}
+
+
 /**
  * @brief Constructs a new data node object from a file, given the file name.
  *
@@ -107,6 +155,7 @@ DataNode::~DataNode() {
  */
 size_t DataNode::add(DataNode* newNode) {
     children.push_back(newNode);
+    childIndexValid = false;
     return children.size() - 1;
 }
 
@@ -145,6 +194,8 @@ void DataNode::clearChildren() {
         delete children[c];
     }
     children.clear();
+    childIndex.clear();
+    childIndexValid = false;
     
     for(size_t dc = 0; dc < dummyChildren.size(); dc++) {
         delete dummyChildren[dc];
@@ -153,6 +204,43 @@ void DataNode::clearChildren() {
 }
 
 
+/**
+ * @brief Compiles the children of this node, and their descendants, into
+ * the format of a compiled cache file. Equal strings are only
+ * stored once in the string table.
+ *
+ * @param nodes List of compiled nodes to add to.
+ * @param strings String table to add to.
+ * @param stringOffsets Offset of each string already in the string table.
+ */
+void DataNode::compileChildren(
+    vector<CompiledNode>& nodes, string& strings,
+    unordered_map<string, uint32_t>& stringOffsets
+) const {
+    const auto addString = [&strings, &stringOffsets] (const string& s) {
+        auto it = stringOffsets.find(s);
+        if(it != stringOffsets.end()) return it->second;
+        uint32_t offset = (uint32_t) strings.size();
+        strings += s;
+        stringOffsets[s] = offset;
+        return offset;
+    };
+    
+    for(size_t c = 0; c < children.size(); c++) {
+        const DataNode* child = children[c];
+        CompiledNode node;
+        node.nameOffset = addString(child->name);
+        node.nameSize = (uint32_t) child->name.size();
+        node.valueOffset = addString(child->value);
+        node.valueSize = (uint32_t) child->value.size();
+        node.lineNr = (uint32_t) child->lineNr;
+        node.nrChildren = (uint32_t) child->children.size();
+        nodes.push_back(node);
+        child->compileChildren(nodes, strings, stringOffsets);
+    }
+}
+
+
 /**
  * @brief Creates a dummy node. If the programmer requests an invalid node,
  * a dummy is returned.
@@ -202,6 +290,7 @@ bool DataNode::deleteChild(DataNode* nodeToDelete) {
         if(children[c] == nodeToDelete) {
             delete nodeToDelete;
             children.erase(children.begin() + c);
+            childIndexValid = false;
             return true;
         }
     }
@@ -247,6 +336,26 @@ void DataNode::encryptString(string& s) {
 }
 
 
+/**
+ * @brief Returns the path of the compiled cache file for a given text file.
+ *
+ * @param filePath Path to the text file.
+ * @return The path.
+ */
+string DataNode::getCacheFilePath(const string& filePath) {
+    //FNV-1a hash of the path.
+    uint64_t hash = 0xcbf29ce484222325;
+    for(size_t c = 0; c < filePath.size(); c++) {
+        hash ^= (unsigned char) filePath[c];
+        hash *= 0x100000001b3;
+    }
+    
+    char hashStr[17];
+    snprintf(hashStr, sizeof(hashStr), "%016llx", (unsigned long long) hash);
+    return cacheFolderPath + "/" + hashStr + ".bin";
+}
+
+
 /**
  * @brief Returns a child node given its number on the list
  * (direct children only).
@@ -272,6 +381,14 @@ DataNode* DataNode::getChild(size_t number) {
 DataNode* DataNode::getChildByName(
     const string& name, size_t occurrenceNr
 ) {
+    if(updateChildIndex()) {
+        auto it = childIndex.find(name);
+        if(it == childIndex.end() || occurrenceNr >= it->second.size()) {
+            return createDummy();
+        }
+        return children[it->second[occurrenceNr]];
+    }
+    
     size_t curOccurrenceNr = 0;
     
     for(size_t c = 0; c < children.size(); c++) {
@@ -387,6 +504,11 @@ size_t DataNode::getNrOfChildren() const {
  * @return The number.
  */
 size_t DataNode::getNrOfChildrenByName(const string& name) const {
+    if(updateChildIndex()) {
+        auto it = childIndex.find(name);
+        return it == childIndex.end() ? 0 : it->second.size();
+    }
+    
     size_t number = 0;
     
     for(size_t c = 0; c < children.size(); c++) {
@@ -409,7 +531,64 @@ string DataNode::getValueOrDefault(const string& def) const {
 
 
 /**
- * @brief Loads data from a file.
+ * @brief Returns whether a file can use the compiled cache, based on
+ * where it is.
+ *
+ * @param filePath Path to the file.
+ * @return Whether it can.
+ */
+bool DataNode::isFileCacheable(const string& filePath) {
+    if(cacheFolderPath.empty()) return false;
+    if(cachedFolderPath.empty()) return false;
+    return
+        filePath.size() > cachedFolderPath.size() &&
+        filePath.compare(
+            0, cachedFolderPath.size(), cachedFolderPath
+        ) == 0 &&
+        filePath[cachedFolderPath.size()] == '/';
+}
+
+
+/**
+ * @brief Creates the children of this node, and their descendants,
+ * from the nodes of a compiled cache file.
+ *
+ * @param nodes All compiled nodes.
+ * @param nodeIdx Index of this node's compiled node.
+ * @param strings The string table.
+ * @return Index of the compiled node after this node's last descendant.
+ */
+size_t DataNode::loadCompiledChildren(
+    const CompiledNode* nodes, size_t nodeIdx, const char* strings
+) {
+    size_t nextIdx = nodeIdx + 1;
+    children.reserve(nodes[nodeIdx].nrChildren);
+    
+    for(uint32_t c = 0; c < nodes[nodeIdx].nrChildren; c++) {
+        const CompiledNode& childNode = nodes[nextIdx];
+        DataNode* newChild = new DataNode();
+        newChild->name.assign(
+            strings + childNode.nameOffset, childNode.nameSize
+        );
+        newChild->value.assign(
+            strings + childNode.valueOffset, childNode.valueSize
+        );
+        newChild->filePath = filePath;
+        newChild->lineNr = childNode.lineNr;
+        children.push_back(newChild);
+        nextIdx = newChild->loadCompiledChildren(nodes, nextIdx, strings);
+    }
+    
+    return nextIdx;
+}
+
+
+/**
+ * @brief Loads data from a file. If there's an up-to-date compiled version
+ * of it in the cache, that is used instead. Otherwise, the text is parsed,
+ * and the result is compiled into the cache for next time.
+ * Only files inside the cached folder use the cache, and encrypted files
+ * never do.
  *
  * @param filePath Path to the file to load.
  * @param outSuccess If not nullptr, whether the file was successfully
@@ -426,35 +605,191 @@ void DataNode::loadFile(
     const string& filePath, bool* outSuccess, bool trimValues,
     bool namesOnlyAfterRoot, bool encrypted
 ) {
-    vector<string> lines;
-    
     if(outSuccess) *outSuccess = false;
     this->filePath = filePath;
     
-    ALLEGRO_FILE* file = al_fopen(filePath.c_str(), "r");
+    //Check the cache. Encrypted files are left out, or else their contents
+    //would be sitting in the cache in plain sight.
+    bool canUseCache = false;
+    CacheHeader cacheHeader;
+    string cacheFilePath;
+    if(isFileCacheable(filePath) && !encrypted) {
+        ALLEGRO_FS_ENTRY* entry = al_create_fs_entry(filePath.c_str());
+        if(entry) {
+            if(
+                al_update_fs_entry(entry) &&
+                !(al_get_fs_entry_mode(entry) & ALLEGRO_FILEMODE_ISDIR)
+            ) {
+                canUseCache = true;
+                cacheHeader.magic = DATA_FILE::CACHE_MAGIC;
+                cacheHeader.version = DATA_FILE::CACHE_VERSION;
+                cacheHeader.loadFlags =
+                    (trimValues ? 1 : 0) |
+                    (namesOnlyAfterRoot ? 2 : 0);
+                cacheHeader.pathSize = (uint32_t) filePath.size();
+                cacheHeader.fileSize = al_get_fs_entry_size(entry);
+                cacheHeader.fileMTime = al_get_fs_entry_mtime(entry);
+            }
+            al_destroy_fs_entry(entry);
+        }
+    }
+    if(canUseCache) {
+        cacheFilePath = getCacheFilePath(filePath);
+        if(loadFromCache(cacheFilePath, cacheHeader)) {
+            if(outSuccess) *outSuccess = true;
+            return;
+        }
+    }
+    
+    //Read the whole file at once.
+    bool opened = false;
+    string contents;
+    ALLEGRO_FILE* file = al_fopen(filePath.c_str(), "rb");
     if(file) {
-        bool isFirstLine = true;
+        opened = true;
         if(outSuccess) *outSuccess = true;
-        string line;
-        while(!al_feof(file)) {
-            getline(file, line, encrypted);
-            
-            if(isFirstLine && !encrypted) {
-                //Let's just check if it starts with the UTF-8 Magic Number.
-                if(
-                    line.size() >= 3 &&
-                    line.substr(0, 3) == DATA_FILE::UTF8_MAGIC_NUMBER
-                ) {
-                    line = line.erase(0, 3);
-                }
+        int64_t fileSize = al_fsize(file);
+        if(fileSize >= 0) {
+            contents.resize(fileSize);
+            contents.resize(al_fread(file, contents.data(), fileSize));
+        } else {
+            //The size is unknown, so read it bit by bit.
+            char chunk[4096];
+            size_t bytesRead = al_fread(file, chunk, sizeof(chunk));
+            while(bytesRead > 0) {
+                contents.append(chunk, bytesRead);
+                bytesRead = al_fread(file, chunk, sizeof(chunk));
             }
-            lines.push_back(line);
-            isFirstLine = false;
         }
         al_fclose(file);
+        
+        if(encrypted) {
+            for(size_t c = 0; c < contents.size(); c++) {
+                contents[c] = decryptChar(contents[c]);
+            }
+        } else if(
+            contents.compare(
+                0, DATA_FILE::UTF8_MAGIC_NUMBER.size(),
+                DATA_FILE::UTF8_MAGIC_NUMBER
+            ) == 0
+        ) {
+            contents.erase(0, DATA_FILE::UTF8_MAGIC_NUMBER.size());
+        }
+    }
+    
+    //Split it into lines, without copying them. Lines can end with
+    //"\n", "\r\n", or "\r".
+    vector<string_view> lines;
+    if(opened) {
+        string_view contentsView = contents;
+        size_t lineStart = 0;
+        for(size_t c = 0; c < contentsView.size(); c++) {
+            if(contentsView[c] != '\n' && contentsView[c] != '\r') continue;
+            lines.push_back(contentsView.substr(lineStart, c - lineStart));
+            if(
+                contentsView[c] == '\r' && c + 1 < contentsView.size() &&
+                contentsView[c + 1] == '\n'
+            ) {
+                c++;
+            }
+            lineStart = c + 1;
+        }
+        lines.push_back(contentsView.substr(lineStart));
     }
     
     loadNode(lines, trimValues, 0, 0, namesOnlyAfterRoot);
+    
+    //Compile it into the cache.
+    if(
+        canUseCache && opened &&
+        (int64_t) time(nullptr) - cacheHeader.fileMTime >=
+        DATA_FILE::CACHE_MIN_FILE_AGE
+    ) {
+        saveToCache(cacheFilePath, cacheHeader);
+    }
+}
+
+
+/**
+ * @brief Loads this node's children from a compiled cache file, if the
+ * cache file exists and was compiled from the same version of the same
+ * text file, with the same loading settings.
+ * The whole cache file is read in one go.
+ *
+ * @param cacheFilePath Path to the cache file.
+ * @param expectedHeader What the cache file's header must match.
+ * The node and string table information are ignored.
+ * @return Whether it succeeded.
+ */
+bool DataNode::loadFromCache(
+    const string& cacheFilePath, const CacheHeader& expectedHeader
+) {
+    ALLEGRO_FILE* file = al_fopen(cacheFilePath.c_str(), "rb");
+    if(!file) return false;
+    
+    int64_t cacheFileSize = al_fsize(file);
+    bool readOk = cacheFileSize >= (int64_t) sizeof(CacheHeader);
+    vector<char> buffer(readOk ? cacheFileSize : 0);
+    if(readOk) {
+        readOk = al_fread(file, buffer.data(), buffer.size()) == buffer.size();
+    }
+    al_fclose(file);
+    if(!readOk) return false;
+    
+    //Check if it's a compilation of this exact file.
+    CacheHeader header;
+    memcpy(&header, buffer.data(), sizeof(CacheHeader));
+    if(
+        header.magic != expectedHeader.magic ||
+        header.version != expectedHeader.version ||
+        header.loadFlags != expectedHeader.loadFlags ||
+        header.pathSize != expectedHeader.pathSize ||
+        header.fileSize != expectedHeader.fileSize ||
+        header.fileMTime != expectedHeader.fileMTime ||
+        header.nrNodes == 0
+    ) {
+        return false;
+    }
+    
+    size_t paddedPathSize = (header.pathSize + 3) / 4 * 4;
+    size_t nodesStart = sizeof(CacheHeader) + paddedPathSize;
+    size_t stringsStart =
+        nodesStart + (size_t) header.nrNodes * sizeof(CompiledNode);
+    if(
+        stringsStart + header.stringsSize != buffer.size() ||
+        memcmp(
+            buffer.data() + sizeof(CacheHeader),
+            filePath.data(), header.pathSize
+        ) != 0
+    ) {
+        return false;
+    }
+    
+    //Check if the nodes make for a valid tree, and their strings are
+    //in the string table, so that a corrupted file can't make us
+    //read out of bounds.
+    const CompiledNode* nodes =
+        (const CompiledNode*) (buffer.data() + nodesStart);
+    size_t nrPendingNodes = 1;
+    for(size_t n = 0; n < header.nrNodes; n++) {
+        const CompiledNode& node = nodes[n];
+        if(
+            nrPendingNodes == 0 ||
+            (uint64_t) node.nameOffset + node.nameSize > header.stringsSize ||
+            (uint64_t) node.valueOffset + node.valueSize > header.stringsSize
+        ) {
+            return false;
+        }
+        nrPendingNodes += node.nrChildren;
+        nrPendingNodes--;
+    }
+    if(nrPendingNodes != 0) return false;
+    
+    //Build the tree.
+    children.clear();
+    childIndexValid = false;
+    loadCompiledChildren(nodes, 0, buffer.data() + stringsStart);
+    return true;
 }
 
 
@@ -477,17 +812,45 @@ size_t DataNode::loadNode(
     const vector<string>& lines, bool trimValues,
     size_t startLine, size_t depth,
     bool namesOnlyAfterRoot
+) {
+    vector<string_view> lineViews(lines.begin(), lines.end());
+    return
+        loadNode(
+            lineViews, trimValues, startLine, depth, namesOnlyAfterRoot
+        );
+}
+
+
+/**
+ * @brief Loads data from a list of views of text lines. The text is only
+ * copied into the nodes' names and values.
+ *
+ * @param lines Views of the text lines that make up the node.
+ * @param trimValues If true, spaces before and after the value will
+ * be trimmed off.
+ * @param startLine This node starts at this line of the document.
+ * @param depth Depth of this node. 0 means root.
+ * @param namesOnlyAfterRoot If true, any nodes that are not in the
+ * root node (i.e. they are children of some node inside the file)
+ * will only have a name and no value; the entire contents of their
+ * line will be their name.
+ * @return Returns the number of the line this node ended on,
+ * judging by startLine. This is used for the recursion.
+ */
+size_t DataNode::loadNode(
+    const vector<string_view>& lines, bool trimValues,
+    size_t startLine, size_t depth,
+    bool namesOnlyAfterRoot
 ) {
     children.clear();
+    childIndexValid = false;
     
     if(startLine >= lines.size()) return startLine;
     
     bool returningFromSubNode = false;
     
     for(size_t l = startLine; l < lines.size(); l++) {
-        string line = lines[l];
-        
-        line = trimSpaces(line, true); //Removes the leftmost spaces.
+        string_view line = trimSpaces(lines[l], true);
         
         if(line.empty()) continue;
         
@@ -500,14 +863,13 @@ size_t DataNode::loadNode(
         
         //Sub-node end.
         size_t pos = line.find('}');
-        if(pos != string::npos) {
+        if(pos != string_view::npos) {
             if(returningFromSubNode) {
                 //The sub-node just ended.
                 //Let's leave what's after the bracket, and let the rest
                 //of the code make use of it.
                 returningFromSubNode = false;
-                line = line.substr(pos + 1, line.size() - (pos + 1));
-                line = trimSpaces(line, true);
+                line = trimSpaces(line.substr(pos + 1), true);
                 if(line.empty()) continue;
             } else {
                 return l;
@@ -516,10 +878,9 @@ size_t DataNode::loadNode(
         
         //Sub-node start.
         pos = line.find('{');
-        if(pos != string::npos) {
+        if(pos != string_view::npos) {
             DataNode* newChild = new DataNode();
             newChild->name = trimSpaces(line.substr(0, pos));
-            newChild->value.clear();
             newChild->filePath = filePath;
             newChild->lineNr = l + 1;
             l =
@@ -535,13 +896,13 @@ size_t DataNode::loadNode(
         
         //Option=value.
         pos = line.find('=');
-        string n, v;
+        string_view n, v;
         if(
             (!namesOnlyAfterRoot || depth == 0) &&
-            pos != string::npos && pos > 0 && line.size() > 2
+            pos != string_view::npos && pos > 0 && line.size() > 2
         ) {
             n = line.substr(0, pos);
-            v = line.substr(pos + 1, line.size() - (pos + 1));
+            v = line.substr(pos + 1);
         } else {
             n = line;
         }
@@ -587,6 +948,33 @@ DataNode& DataNode::operator=(const DataNode& dn2) {
 }
 
 
+/**
+ * @brief Takes the data and the children from another data node,
+ * which is left empty.
+ *
+ * @param dn2 Node to take from.
+ * @return The current node.
+ */
+DataNode& DataNode::operator=(DataNode&& dn2) noexcept {
+    if(this != &dn2) {
+        clear();
+        
+        name = std::move(dn2.name);
+        value = std::move(dn2.value);
+        filePath = std::move(dn2.filePath);
+        lineNr = dn2.lineNr;
+        children.swap(dn2.children);
+        dummyChildren.swap(dn2.dummyChildren);
+        childIndex.swap(dn2.childIndex);
+        childIndexValid = dn2.childIndexValid;
+        
+        dn2.clear();
+    }
+    
+    return *this;
+}
+
+
 /**
  * @brief Saves a node into a new text file. Line numbers are ignored.
  * If you don't provide a file name, it'll use the node's file name.
@@ -615,6 +1003,12 @@ bool DataNode::saveFile(
         nextSlashPos = destinationFilePath.find('/', nextSlashPos + 1);
     }
     
+    //The compiled cache file, if any, is outdated now. Modification times
+    //only have a precision of one second, so don't rely on them.
+    if(isFileCacheable(destinationFilePath)) {
+        std::remove(getCacheFilePath(destinationFilePath).c_str());
+    }
+    
     //Save the file.
     ALLEGRO_FILE* file = al_fopen(destinationFilePath.c_str(), "w");
     if(file) {
@@ -683,6 +1077,76 @@ void DataNode::saveNode(
 }
 
 
+/**
+ * @brief Compiles this node's children into a compiled cache file.
+ * The data is written to a temporary file first, so that a cache file
+ * is never read while it's only partially written.
+ *
+ * @param cacheFilePath Path to the cache file.
+ * @param header Header to write. The node and string table information
+ * are filled in here.
+ */
+void DataNode::saveToCache(
+    const string& cacheFilePath, const CacheHeader& header
+) const {
+    vector<CompiledNode> nodes;
+    string strings;
+    unordered_map<string, uint32_t> stringOffsets;
+    CompiledNode rootNode;
+    rootNode.nrChildren = (uint32_t) children.size();
+    nodes.push_back(rootNode);
+    compileChildren(nodes, strings, stringOffsets);
+    
+    CacheHeader finalHeader = header;
+    finalHeader.nrNodes = (uint32_t) nodes.size();
+    finalHeader.stringsSize = (uint32_t) strings.size();
+    string paddedPath = filePath;
+    paddedPath.resize((paddedPath.size() + 3) / 4 * 4, '\0');
+    
+    string tempFilePath = cacheFilePath + ".tmp";
+    ALLEGRO_FILE* file = al_fopen(tempFilePath.c_str(), "wb");
+    if(!file) return;
+    
+    al_fwrite(file, &finalHeader, sizeof(CacheHeader));
+    al_fwrite(file, paddedPath.data(), paddedPath.size());
+    al_fwrite(file, nodes.data(), nodes.size() * sizeof(CompiledNode));
+    al_fwrite(file, strings.data(), strings.size());
+    bool success = !al_ferror(file);
+    success = al_fclose(file) && success;
+    
+    std::remove(cacheFilePath.c_str());
+    if(
+        !success ||
+        std::rename(tempFilePath.c_str(), cacheFilePath.c_str()) != 0
+    ) {
+        std::remove(tempFilePath.c_str());
+    }
+}
+
+
+/**
+ * @brief Sets the folder where compiled cache files are kept, creating it
+ * if needed. Files loaded from then on use the cache, if they're inside
+ * the cached folder. Files elsewhere, like user data that gets rewritten
+ * often, would only fill the cache with files that go stale.
+ *
+ * @param folderPath Path to the folder. Empty disables the cache.
+ * @param cachedFolderPath Path to the folder whose files use the cache.
+ */
+void DataNode::setCacheFolder(
+    const string& folderPath, const string& cachedFolderPath
+) {
+    cacheFolderPath = folderPath;
+    DataNode::cachedFolderPath = cachedFolderPath;
+    if(
+        !cacheFolderPath.empty() &&
+        !al_make_directory(cacheFolderPath.c_str())
+    ) {
+        cacheFolderPath.clear();
+    }
+}
+
+
 /**
  * @brief Removes all trailing and preceding spaces.
  * This means space and tab characters before and after the 'middle' characters.
@@ -692,27 +1156,54 @@ void DataNode::saveNode(
  * @return The trimmed string.
  */
 string DataNode::trimSpaces(const string& s, bool leftOnly) {
-    string orig = s;
+    return string(trimSpaces(string_view(s), leftOnly));
+}
+
+
+/**
+ * @brief Removes all trailing and preceding spaces, without copying.
+ * This means space and tab characters before and after the 'middle' characters.
+ *
+ * @param s View of the original string.
+ * @param leftOnly If true, only trim the spaces at the left.
+ * @return View of the trimmed string.
+ */
+string_view DataNode::trimSpaces(string_view s, bool leftOnly) {
     //Spaces before.
-    if(orig.size()) {
-        while(orig[0] == ' ' || orig[0] == '\t') {
-            orig.erase(0, 1);
-            if(orig.empty()) break;
-        }
+    size_t start = 0;
+    while(start < s.size() && (s[start] == ' ' || s[start] == '\t')) {
+        start++;
     }
+    s.remove_prefix(start);
     
     if(!leftOnly) {
         //Spaces after.
-        if(orig.size()) {
-            while(
-                orig[orig.size() - 1] == ' ' ||
-                orig[orig.size() - 1] == '\t'
-            ) {
-                orig.erase(orig.size() - 1, 1);
-                if(orig.empty()) break;
-            }
+        size_t end = s.size();
+        while(end > 0 && (s[end - 1] == ' ' || s[end - 1] == '\t')) {
+            end--;
         }
+        s.remove_suffix(s.size() - end);
     }
     
-    return orig;
+    return s;
+}
+
+
+/**
+ * @brief Builds the index of children by name, if it's out of date.
+ * Nodes with few children don't use the index, since checking
+ * every child is fast enough.
+ *
+ * @return Whether the index can be used.
+ */
+bool DataNode::updateChildIndex() const {
+    if(children.size() < DATA_FILE::CHILD_INDEX_MIN_CHILDREN) return false;
+    if(childIndexValid) return true;
+    
+    childIndex.clear();
+    for(size_t c = 0; c < children.size(); c++) {
+        childIndex[children[c]->name].push_back(c);
+    }
+    childIndexValid = true;
+    return true;
 }
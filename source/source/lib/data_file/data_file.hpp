@@ -37,21 +37,35 @@
  *              levelObjects->getChild(o)->getChildByName("size")->value;
  *       }
  *   }
+ *
+ * If a cache folder is set, each file that gets loaded is also compiled into
+ * a binary file in that folder. The next time the same file is loaded, if it
+ * wasn't changed, the tree is built from the binary file instead, which
+ * skips all of the text parsing.
  */
 
 #pragma once
 
 #include <allegro5/allegro.h>
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 
 using std::string;
+using std::string_view;
+using std::unordered_map;
 using std::vector;
 
 
 namespace DATA_FILE {
+extern const int64_t CACHE_MIN_FILE_AGE;
+extern const uint32_t CACHE_MAGIC;
+extern const uint32_t CACHE_VERSION;
+extern const size_t CHILD_INDEX_MIN_CHILDREN;
 extern const unsigned char ENCRYPTION_MIN_VALUE;
 extern const unsigned char ENCRYPTION_ROT_AMOUNT;
 extern const string UTF8_MAGIC_NUMBER;
@@ -87,7 +101,9 @@ public:
     explicit DataNode(const string& filePath, bool* outSuccess = nullptr);
     DataNode(const string& name, const string& value);
     DataNode(const DataNode& dn2);
+    DataNode(DataNode&& dn2) noexcept;
     DataNode& operator=(const DataNode& dn2);
+    DataNode& operator=(DataNode&& dn2) noexcept;
     ~DataNode();
     void clear();
     void clearChildren();
@@ -112,6 +128,11 @@ public:
         size_t startLine = 0, size_t depth = 0,
         bool namesOnlyAfterRoot = false
     );
+    size_t loadNode(
+        const vector<string_view>& lines, bool trimValues,
+        size_t startLine = 0, size_t depth = 0,
+        bool namesOnlyAfterRoot = false
+    );
     bool saveFile(
         string destinationFilePath = "", bool childrenOnly = true,
         bool includeEmptyValues = false,
@@ -122,8 +143,79 @@ public:
         bool includeEmptyValues = false,
         bool encrypted = false
     ) const;
+    static void setCacheFolder(
+        const string& folderPath, const string& cachedFolderPath
+    );
     
 protected:
+    
+    //--- Protected misc. definitions ---
+    
+    /**
+     * @brief Header of a compiled cache file. It's followed by the text
+     * file's path, padded to a multiple of 4 bytes, then the nodes, then
+     * the string table. Everything is in the machine's byte order, since
+     * the cache is never shared between machines.
+     */
+    struct CacheHeader {
+        
+        //--- Public members ---
+        
+        //Magic number. Must be DATA_FILE::CACHE_MAGIC.
+        uint32_t magic = 0;
+        
+        //Version of the format. Must be DATA_FILE::CACHE_VERSION.
+        uint32_t version = 0;
+        
+        //Flags with the loading settings, since they change the result.
+        uint32_t loadFlags = 0;
+        
+        //Size of the text file's path, without padding.
+        uint32_t pathSize = 0;
+        
+        //Size of the text file when it was compiled.
+        uint64_t fileSize = 0;
+        
+        //Modification time of the text file when it was compiled.
+        int64_t fileMTime = 0;
+        
+        //Number of nodes, including the root.
+        uint32_t nrNodes = 0;
+        
+        //Size of the string table.
+        uint32_t stringsSize = 0;
+        
+    };
+    
+    /**
+     * @brief A node in a compiled cache file. The nodes are stored in
+     * pre-order, so a node's children come right after it, each followed
+     * by its own descendants.
+     */
+    struct CompiledNode {
+        
+        //--- Public members ---
+        
+        //Offset of the name in the string table.
+        uint32_t nameOffset = 0;
+        
+        //Size of the name.
+        uint32_t nameSize = 0;
+        
+        //Offset of the value in the string table.
+        uint32_t valueOffset = 0;
+        
+        //Size of the value.
+        uint32_t valueSize = 0;
+        
+        //Line on the text file the node's in.
+        uint32_t lineNr = 0;
+        
+        //Number of direct children.
+        uint32_t nrChildren = 0;
+        
+    };
+    
 
     //--- Protected members ---
     
@@ -133,16 +225,47 @@ protected:
     //Dummy children, returned upon error.
     vector<DataNode*> dummyChildren;
     
+    //Index of each child name's children, for quick lookups. Only used
+    //with many children. If a child's name gets changed directly, the
+    //index isn't updated, so lookups by name may fail.
+    mutable unordered_map<string, vector<size_t> > childIndex;
+    
+    //Whether childIndex is up-to-date with the list of children.
+    mutable bool childIndexValid = false;
+    
+    //Folder where compiled cache files are kept. Empty if there's no cache.
+    static string cacheFolderPath;
+    
+    //Only files inside this folder use the cache.
+    static string cachedFolderPath;
+    
     
     //--- Protected function declarations ---
     
+    void compileChildren(
+        vector<CompiledNode>& nodes, string& strings,
+        unordered_map<string, uint32_t>& stringOffsets
+    ) const;
     DataNode* createDummy();
     static unsigned char decryptChar(unsigned char c);
     static unsigned char encryptChar(unsigned char c);
     static void encryptString(string& s);
+    static string getCacheFilePath(const string& filePath);
+    static bool isFileCacheable(const string& filePath);
     static void getline(
         ALLEGRO_FILE* file, string& line, bool encrypted = false
     );
+    size_t loadCompiledChildren(
+        const CompiledNode* nodes, size_t nodeIdx, const char* strings
+    );
+    bool loadFromCache(
+        const string& cacheFilePath, const CacheHeader& expectedHeader
+    );
+    void saveToCache(
+        const string& cacheFilePath, const CacheHeader& header
+    ) const;
     static string trimSpaces(const string& s, bool leftOnly = false);
+    static string_view trimSpaces(string_view s, bool leftOnly = false);
+    bool updateChildIndex() const;
     
 };
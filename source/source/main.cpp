@@ -15,19 +15,26 @@
  * @brief Main function. It calls the game class's functions to initialize
  * and run the game.
  *
- * @param argc Command line argument count. Unused.
- * @param argv Command line argument values. Unused.
+ * @param argc Command line argument count.
+ * @param argv Command line argument values.
  * @return 0 if everything went well, or an error number otherwise.
  */
 int main(int argc, char** argv) {
+    game.parseCommandLine(argc, argv);
+    
     int gameStartResult = game.start();
     if(gameStartResult != 0) {
         return gameStartResult;
     }
     
-    game.mainLoop();
+    int runResult = 0;
+    if(game.benchmark.enabled) {
+        runResult = game.runBenchmark();
+    } else {
+        game.mainLoop();
+    }
     
     game.shutdown();
     
-    return 0;
+    return runResult;
 }
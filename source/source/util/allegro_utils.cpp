@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <clocale>
+#include <cstring>
 #include <vector>
 
 #include <allegro5/allegro_native_dialog.h>
@@ -308,6 +309,95 @@ vector<string> folderToVectorRecursively(
 }
 
 
+/**
+ * @brief Reads a float from a file, as written by fwriteFloat32be().
+ *
+ * @param file File to read from.
+ * @return The number.
+ */
+float freadFloat32be(ALLEGRO_FILE* file) {
+    uint32_t bits = (uint32_t) al_fread32be(file);
+    float value;
+    memcpy(&value, &bits, sizeof(float));
+    return value;
+}
+
+
+/**
+ * @brief Reads a signed variable-length integer from a file, as written by
+ * fwriteSignedVarint().
+ *
+ * @param file File to read from.
+ * @return The number.
+ */
+int64_t freadSignedVarint(ALLEGRO_FILE* file) {
+    uint64_t zigzag = freadVarint(file);
+    return (int64_t) (zigzag >> 1) ^ -(int64_t) (zigzag & 1);
+}
+
+
+/**
+ * @brief Reads an unsigned variable-length integer from a file, as written by
+ * fwriteVarint(). If the file ends midway, what was read so far is returned.
+ *
+ * @param file File to read from.
+ * @return The number.
+ */
+uint64_t freadVarint(ALLEGRO_FILE* file) {
+    uint64_t result = 0;
+    for(unsigned char shift = 0; shift < 64; shift += 7) {
+        int byte = al_fgetc(file);
+        if(byte == EOF) break;
+        result |= (uint64_t) (byte & 0x7F) << shift;
+        if(!(byte & 0x80)) break;
+    }
+    return result;
+}
+
+
+/**
+ * @brief Writes a float to a file, as its exact 32 bits, in big-endian order.
+ *
+ * @param file File to write to.
+ * @param value Number to write.
+ */
+void fwriteFloat32be(ALLEGRO_FILE* file, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(float));
+    al_fwrite32be(file, (int32_t) bits);
+}
+
+
+/**
+ * @brief Writes a signed variable-length integer to a file. Numbers are
+ * zigzag-encoded first, so that ones close to 0, negative or positive,
+ * take up the fewest bytes.
+ *
+ * @param file File to write to.
+ * @param value Number to write.
+ */
+void fwriteSignedVarint(ALLEGRO_FILE* file, int64_t value) {
+    fwriteVarint(file, ((uint64_t) value << 1) ^ (uint64_t) (value >> 63));
+}
+
+
+/**
+ * @brief Writes an unsigned variable-length integer to a file. Each byte
+ * holds 7 bits of the number, and its highest bit says whether
+ * more bytes follow.
+ *
+ * @param file File to write to.
+ * @param value Number to write.
+ */
+void fwriteVarint(ALLEGRO_FILE* file, uint64_t value) {
+    while(value >= 0x80) {
+        al_fputc(file, (int) ((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    al_fputc(file, (int) value);
+}
+
+
 /**
  * @brief Returns the width and height of an Allegro bitmap in a
  * point structure.
@@ -126,6 +126,12 @@ vector<string> folderToVector(
 vector<string> folderToVectorRecursively(
     string folderName, bool folders, bool* outFolderFound = nullptr
 );
+float freadFloat32be(ALLEGRO_FILE* file);
+int64_t freadSignedVarint(ALLEGRO_FILE* file);
+uint64_t freadVarint(ALLEGRO_FILE* file);
+void fwriteFloat32be(ALLEGRO_FILE* file, float value);
+void fwriteSignedVarint(ALLEGRO_FILE* file, int64_t value);
+void fwriteVarint(ALLEGRO_FILE* file, uint64_t value);
 ALLEGRO_COLOR interpolateColor(
     float input, float inputStart, float inputEnd,
     const ALLEGRO_COLOR& outputStart, const ALLEGRO_COLOR& outputEnd
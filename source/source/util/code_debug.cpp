@@ -8,6 +8,9 @@
  * Code debugging tools. See the header file for more information.
  */
 
+#include <cstdlib>
+#include <new>
+
 #include <allegro5/allegro.h>
 
 #include "code_debug.hpp"
@@ -92,6 +95,84 @@ void* operator new[](size_t size, char* file, int line) {
 #endif //ifndef CODE_DEBUG_NEW
 
 
+#ifdef CODE_DEBUG_COUNT_NEW
+
+std::atomic<std::size_t> codeDebugNrNews(0);
+
+
+/**
+ * @brief Overrides operator delete.
+ *
+ * @param ptr Pointer to memory to deallocate.
+ */
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+
+/**
+ * @brief Overrides the sized operator delete.
+ *
+ * @param ptr Pointer to memory to deallocate.
+ * @param size Size of the memory.
+ */
+void operator delete(void* ptr, std::size_t size) noexcept {
+    free(ptr);
+}
+
+
+/**
+ * @brief Overrides operator delete[].
+ *
+ * @param ptr Pointer to memory to deallocate.
+ */
+void operator delete[](void* ptr) noexcept {
+    free(ptr);
+}
+
+
+/**
+ * @brief Overrides the sized operator delete[].
+ *
+ * @param ptr Pointer to memory to deallocate.
+ * @param size Size of the memory.
+ */
+void operator delete[](void* ptr, std::size_t size) noexcept {
+    free(ptr);
+}
+
+
+/**
+ * @brief Overrides operator new, counting the allocation.
+ *
+ * @param size Size of memory to allocate.
+ * @return The memory.
+ */
+void* operator new(std::size_t size) {
+    codeDebugNrNews.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = malloc(size > 0 ? size : 1);
+    if(!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+
+/**
+ * @brief Overrides operator new[], counting the allocation.
+ *
+ * @param size Size of memory to allocate.
+ * @return The memory.
+ */
+void* operator new[](std::size_t size) {
+    codeDebugNrNews.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = malloc(size > 0 ? size : 1);
+    if(!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+
+#endif //ifdef CODE_DEBUG_COUNT_NEW
+
+
 
 /**
  * @brief Starts a time measurement for benchmarking.
@@ -67,6 +67,28 @@ void operator delete[](void* ptr, size_t size) noexcept;
 #endif //ifdef CODE_DEBUG_NEW
 
 
+/**
+ * @brief Heap allocation counting.
+ *
+ * To activate, define CODE_DEBUG_COUNT_NEW, like the makefile's "perf" rule
+ * does. This replaces the global operator new and operator delete, so that
+ * every heap allocation in the program, by the project's code or by the
+ * standard library, increases codeDebugNrNews. The difference between two
+ * readings is how many allocations happened in between, which the
+ * performance monitor uses to count them during gameplay logic.
+ * This can't be used together with CODE_DEBUG_NEW.
+ */
+#ifdef CODE_DEBUG_COUNT_NEW
+
+#include <atomic>
+#include <cstddef>
+
+//Total number of heap allocations done with operator new so far.
+extern std::atomic<std::size_t> codeDebugNrNews;
+
+#endif //ifdef CODE_DEBUG_COUNT_NEW
+
+
 //Timestamp for the start of the current benchmark measurement.
 extern double codeDebugBenchmarkMeasureStart;
 //Sum of the durations of all code benchmarking iterations.
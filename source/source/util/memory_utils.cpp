@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Andre 'Espyo' Silva 2013.
+ * The following source file belongs to the open-source project Pikifen.
+ * Please read the included README and LICENSE files for more information.
+ * Pikmin is copyright (c) Nintendo.
+ *
+ * === FILE DESCRIPTION ===
+ * Memory utility classes and functions.
+ * These don't contain logic specific to the Pikifen project.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "memory_utils.hpp"
+
+
+#pragma region Arena
+
+
+/**
+ * @brief Constructs a new arena object. The memory is only requested
+ * on the first allocation.
+ *
+ * @param initialCapacity Size of the main memory block, in bytes.
+ */
+Arena::Arena(size_t initialCapacity) :
+    capacity(initialCapacity) {
+    
+}
+
+
+/**
+ * @brief Destroys the arena object, freeing all of its memory.
+ */
+Arena::~Arena() {
+    reset();
+    free(block);
+}
+
+
+/**
+ * @brief Allocates some memory. If there's no space left in the main block,
+ * an extra block is requested from the heap.
+ *
+ * @param size Size of the memory, in bytes.
+ * @param alignment Alignment the memory needs. Must not be larger than
+ * that of std::max_align_t.
+ * @return The memory.
+ */
+void* Arena::allocate(size_t size, size_t alignment) {
+    if(!block) {
+        block = (char*) malloc(capacity);
+        if(!block) throw std::bad_alloc();
+        nrHeapAllocations++;
+    }
+    
+    uintptr_t start = (uintptr_t) (block + used);
+    size_t padding = (alignment - start % alignment) % alignment;
+    if(used + padding + size <= capacity) {
+        void* result = block + used + padding;
+        used += padding + size;
+        return result;
+    }
+    
+    //No space left. Malloc'd memory is suitably aligned for anything.
+    char* extraBlock = (char*) malloc(size > 0 ? size : 1);
+    if(!extraBlock) throw std::bad_alloc();
+    overflowBlocks.push_back(extraBlock);
+    overflowSize += size;
+    nrHeapAllocations++;
+    return extraBlock;
+}
+
+
+/**
+ * @brief Returns the size of the main memory block.
+ *
+ * @return The size, in bytes.
+ */
+size_t Arena::getCapacity() const {
+    return capacity;
+}
+
+
+/**
+ * @brief Returns how many times the arena had to use the heap since
+ * the last reset.
+ *
+ * @return The number.
+ */
+size_t Arena::getNrHeapAllocations() const {
+    return nrHeapAllocations;
+}
+
+
+/**
+ * @brief Throws away everything that was allocated. If the main block
+ * ran out of space since the last reset, it's replaced with one that
+ * could've held everything.
+ */
+void Arena::reset() {
+    for(size_t b = 0; b < overflowBlocks.size(); b++) {
+        free(overflowBlocks[b]);
+    }
+    overflowBlocks.clear();
+    
+    if(overflowSize > 0) {
+        free(block);
+        block = nullptr;
+        capacity = (used + overflowSize) * 2;
+        overflowSize = 0;
+    }
+    
+    used = 0;
+    nrHeapAllocations = 0;
+}
+
+
+#pragma endregion
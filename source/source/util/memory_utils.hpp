@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Andre 'Espyo' Silva 2013.
+ * The following source file belongs to the open-source project Pikifen.
+ * Please read the included README and LICENSE files for more information.
+ * Pikmin is copyright (c) Nintendo.
+ *
+ * === FILE DESCRIPTION ===
+ * Header for the memory utility classes and functions.
+ * These don't contain logic specific to the Pikifen project.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+
+using std::size_t;
+using std::vector;
+
+
+/**
+ * @brief A bump allocator for short-lived data. Allocations are just a
+ * pointer increment in a memory block, nothing is freed individually,
+ * and everything is thrown away at once when it gets reset.
+ *
+ * If the block runs out of space, extra blocks are requested from the heap.
+ * On the next reset, those are merged into one bigger block, so after a few
+ * resets, the arena stops needing the heap at all.
+ *
+ * This is not safe to use from more than one thread at a time.
+ */
+struct Arena {
+    
+    //--- Public function declarations ---
+    
+    explicit Arena(size_t initialCapacity = 64 * 1024);
+    ~Arena();
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    void* allocate(size_t size, size_t alignment);
+    size_t getCapacity() const;
+    size_t getNrHeapAllocations() const;
+    void reset();
+    
+    
+    private:
+    
+    //--- Private members ---
+    
+    //Main memory block.
+    char* block = nullptr;
+    
+    //Size of the main memory block.
+    size_t capacity = 0;
+    
+    //How much of the main memory block is in use.
+    size_t used = 0;
+    
+    //Extra memory blocks requested since the last reset, when the
+    //main one ran out of space.
+    vector<char*> overflowBlocks;
+    
+    //Total size of the extra memory blocks.
+    size_t overflowSize = 0;
+    
+    //How many times the heap was used since the last reset.
+    size_t nrHeapAllocations = 0;
+    
+};
+
+
+/**
+ * @brief Standard library allocator that takes its memory from an arena.
+ * Deallocating does nothing, since the arena frees everything on reset.
+ * Containers using it must not outlive the arena's next reset.
+ *
+ * @tparam T Type of the items to allocate.
+ */
+template<typename T>
+struct ArenaAllocator {
+    
+    //--- Public misc. definitions ---
+    
+    typedef T value_type;
+    
+    
+    //--- Public members ---
+    
+    //Arena to allocate from.
+    Arena* arena = nullptr;
+    
+    
+    //--- Public function definitions ---
+    
+    /**
+     * @brief Constructs a new arena allocator object.
+     *
+     * @param arena Arena to allocate from.
+     */
+    ArenaAllocator(Arena& arena) :
+        arena(&arena) {
+        
+    }
+    
+    
+    /**
+     * @brief Constructs a new arena allocator object from one of
+     * another type, using the same arena.
+     *
+     * @tparam U Type of the other allocator's items.
+     * @param other The other allocator.
+     */
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) :
+        arena(other.arena) {
+        
+    }
+    
+    
+    /**
+     * @brief Allocates memory for some items.
+     *
+     * @param n Number of items.
+     * @return The memory.
+     */
+    T* allocate(size_t n) {
+        return (T*) arena->allocate(n * sizeof(T), alignof(T));
+    }
+    
+    
+    /**
+     * @brief Does nothing, since the arena frees everything on reset.
+     */
+    void deallocate(T*, size_t) {
+    }
+    
+    
+    /**
+     * @brief Returns whether two allocators use the same arena.
+     *
+     * @tparam U Type of the other allocator's items.
+     * @param other The other allocator.
+     * @return Whether they're the same.
+     */
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const {
+        return arena == other.arena;
+    }
+    
+};
+
+
+//Vector whose memory comes from an arena.
+template<typename T>
+using ArenaVector = vector<T, ArenaAllocator<T> >;
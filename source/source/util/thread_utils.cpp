@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) Andre 'Espyo' Silva 2013.
+ * The following source file belongs to the open-source project Pikifen.
+ * Please read the included README and LICENSE files for more information.
+ * Pikmin is copyright (c) Nintendo.
+ *
+ * === FILE DESCRIPTION ===
+ * Threading utility classes and functions.
+ * These don't contain logic specific to the Pikifen project.
+ */
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "thread_utils.hpp"
+
+
+#pragma region Worker pool
+
+
+/**
+ * @brief Threads and synchronization objects of a worker pool.
+ */
+struct WorkerPool::Internals {
+
+    //--- Public members ---
+    
+    //Worker threads. The calling thread is not included.
+    std::vector<std::thread> workers;
+    
+    //Protects everything the workers share with the calling thread.
+    std::mutex mutex;
+    
+    //Signals the workers that there is a new job, or that they must stop.
+    std::condition_variable jobCondition;
+    
+    //Signals the calling thread that all workers finished the job.
+    std::condition_variable doneCondition;
+    
+    //Function of the current job.
+    const RangeFunc* jobFunc = nullptr;
+    
+    //Number of items in the current job.
+    size_t jobNrItems = 0;
+    
+    //Identifier of the current job. Increases with every job.
+    size_t jobId = 0;
+    
+    //Number of workers that haven't finished the current job yet.
+    size_t nrBusyWorkers = 0;
+    
+    //Whether the workers must stop.
+    bool stopping = false;
+    
+};
+
+
+/**
+ * @brief Constructs a new worker pool object, with no workers.
+ */
+WorkerPool::WorkerPool() :
+    internals(new Internals()) {
+    
+}
+
+
+/**
+ * @brief Destroys the worker pool object, stopping all workers.
+ */
+WorkerPool::~WorkerPool() {
+    stop();
+    delete internals;
+}
+
+
+/**
+ * @brief Returns how many threads the system's hardware can run at once.
+ *
+ * @return The number, or 1 if it can't be known.
+ */
+size_t WorkerPool::getNrHardwareThreads() {
+    size_t nr = std::thread::hardware_concurrency();
+    return nr > 0 ? nr : 1;
+}
+
+
+/**
+ * @brief Returns how many threads handle a job, including the calling one.
+ *
+ * @return The number.
+ */
+size_t WorkerPool::getNrThreads() const {
+    return internals->workers.size() + 1;
+}
+
+
+/**
+ * @brief Splits a list of items into contiguous ranges, one per thread,
+ * and runs the given function on each range in parallel. Returns once
+ * all ranges are handled.
+ *
+ * @param nrItems Total number of items.
+ * @param func Function to run for each range.
+ */
+void WorkerPool::parallelFor(size_t nrItems, const RangeFunc& func) {
+    if(nrItems == 0) return;
+    if(internals->workers.empty() || nrItems == 1) {
+        func(0, 0, nrItems);
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(internals->mutex);
+        internals->jobFunc = &func;
+        internals->jobNrItems = nrItems;
+        internals->nrBusyWorkers = internals->workers.size();
+        internals->jobId++;
+    }
+    internals->jobCondition.notify_all();
+    
+    runRange(0);
+    
+    std::unique_lock<std::mutex> lock(internals->mutex);
+    internals->doneCondition.wait(
+        lock, [this] { return internals->nrBusyWorkers == 0; }
+    );
+    internals->jobFunc = nullptr;
+}
+
+
+/**
+ * @brief Runs the current job's function on the range that belongs
+ * to the given thread, if it's not empty.
+ *
+ * @param threadIdx Index of the thread.
+ */
+void WorkerPool::runRange(size_t threadIdx) {
+    size_t nrThreads = getNrThreads();
+    size_t start = internals->jobNrItems * threadIdx / nrThreads;
+    size_t end = internals->jobNrItems * (threadIdx + 1) / nrThreads;
+    if(start == end) return;
+    (*internals->jobFunc)(threadIdx, start, end);
+}
+
+
+/**
+ * @brief Changes how many threads handle a job, including the calling one.
+ * The existing workers are stopped and new ones are started.
+ *
+ * @param nrThreads Number of threads. 0 is treated as 1.
+ */
+void WorkerPool::setNrThreads(size_t nrThreads) {
+    if(nrThreads == 0) nrThreads = 1;
+    if(nrThreads == getNrThreads()) return;
+    
+    stop();
+    
+    internals->stopping = false;
+    for(size_t t = 1; t < nrThreads; t++) {
+        internals->workers.push_back(
+            std::thread(&WorkerPool::workerMain, this, t, internals->jobId)
+        );
+    }
+}
+
+
+/**
+ * @brief Stops and joins all workers.
+ */
+void WorkerPool::stop() {
+    if(internals->workers.empty()) return;
+    
+    {
+        std::lock_guard<std::mutex> lock(internals->mutex);
+        internals->stopping = true;
+    }
+    internals->jobCondition.notify_all();
+    
+    for(size_t w = 0; w < internals->workers.size(); w++) {
+        internals->workers[w].join();
+    }
+    internals->workers.clear();
+}
+
+
+/**
+ * @brief Main loop of a worker thread. Waits for jobs and handles its range
+ * of each one, until it's told to stop.
+ *
+ * @param threadIdx Index of the thread.
+ * @param lastJobId Identifier of the last job before the worker started.
+ */
+void WorkerPool::workerMain(size_t threadIdx, size_t lastJobId) {
+    while(true) {
+        {
+            std::unique_lock<std::mutex> lock(internals->mutex);
+            internals->jobCondition.wait(
+                lock,
+            [this, lastJobId] {
+                return internals->stopping || internals->jobId != lastJobId;
+            }
+            );
+            if(internals->stopping) return;
+            lastJobId = internals->jobId;
+        }
+        
+        runRange(threadIdx);
+        
+        bool allDone = false;
+        {
+            std::lock_guard<std::mutex> lock(internals->mutex);
+            internals->nrBusyWorkers--;
+            allDone = internals->nrBusyWorkers == 0;
+        }
+        if(allDone) internals->doneCondition.notify_one();
+    }
+}
+
+
+#pragma endregion
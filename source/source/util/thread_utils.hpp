@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Andre 'Espyo' Silva 2013.
+ * The following source file belongs to the open-source project Pikifen.
+ * Please read the included README and LICENSE files for more information.
+ * Pikmin is copyright (c) Nintendo.
+ *
+ * === FILE DESCRIPTION ===
+ * Header for the threading utility classes and functions.
+ * These don't contain logic specific to the Pikifen project.
+ */
+
+#pragma once
+
+#include <functional>
+
+
+using std::size_t;
+
+
+/**
+ * @brief A pool of persistent worker threads that can split the handling of
+ * a list of items between them.
+ *
+ * Each thread always gets the same contiguous range of items for a given
+ * number of items, and the calling thread handles the first range itself.
+ * This means that the work each thread does, and the order in which a
+ * thread does it, is deterministic.
+ */
+struct WorkerPool {
+
+    //--- Public misc. definitions ---
+    
+    //Function that handles a range of items.
+    //The first parameter is the index of the thread running it, the second is
+    //the index of the first item, and the third is the index after the last.
+    typedef std::function<void(size_t, size_t, size_t)> RangeFunc;
+    
+    
+    //--- Public function declarations ---
+    
+    WorkerPool();
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    static size_t getNrHardwareThreads();
+    size_t getNrThreads() const;
+    void parallelFor(size_t nrItems, const RangeFunc& func);
+    void setNrThreads(size_t nrThreads);
+    
+    
+    private:
+    
+    //--- Private misc. definitions ---
+    
+    struct Internals;
+    
+    
+    //--- Private members ---
+    
+    //Threads and synchronization objects. These are kept out of the header
+    //since the standard threading headers clash with some of our macros.
+    Internals* internals = nullptr;
+    
+    
+    //--- Private function declarations ---
+    
+    void runRange(size_t threadIdx);
+    void stop();
+    void workerMain(size_t threadIdx, size_t lastJobId);
+    
+};